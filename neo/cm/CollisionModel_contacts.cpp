@@ -58,20 +58,15 @@ int idCollisionModelManagerLocal::Contacts( contactInfo_t* contacts, const int m
 {
 	trace_t results;
 	idVec3 end;
+	int numContacts;
 
 	// same as Translation but instead of storing the first collision we store all collisions as contacts
-	idCollisionModelManagerLocal::getContacts = true;
-	idCollisionModelManagerLocal::contacts = contacts;
-	idCollisionModelManagerLocal::maxContacts = maxContacts;
-	idCollisionModelManagerLocal::numContacts = 0;
 	end = start + dir.SubVec3( 0 ) * depth;
-	idCollisionModelManagerLocal::Translation( &results, start, end, trm, trmAxis, contentMask, model, origin, modelAxis );
+	idCollisionModelManagerLocal::Translation( &results, start, end, trm, trmAxis, contentMask, model, origin, modelAxis, contacts, maxContacts, numContacts );
 	if( dir.SubVec3( 1 ).LengthSqr() != 0.0f )
 	{
 		// FIXME: rotational contacts
 	}
-	idCollisionModelManagerLocal::getContacts = false;
-	idCollisionModelManagerLocal::maxContacts = 0;
 
-	return idCollisionModelManagerLocal::numContacts;
+	return numContacts;
 }
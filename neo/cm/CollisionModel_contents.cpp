@@ -60,11 +60,10 @@ bool idCollisionModelManagerLocal::TestTrmVertsInBrush( cm_traceWork_t* tw, cm_b
 	float d, bestd;
 	idVec3* p;
 
-	if( b->checkcount == idCollisionModelManagerLocal::checkCount )
+	if( CM_CheckVisited( tw->thread, b ) )
 	{
 		return false;
 	}
-	b->checkcount = idCollisionModelManagerLocal::checkCount;
 
 	if( !( b->contents & tw->contents ) )
 	{
@@ -142,10 +141,10 @@ CM_SetTrmEdgeSidedness
 CM_SetTrmPolygonSidedness
 ================
 */
-#define CM_SetTrmPolygonSidedness( v, plane, bitNum ) {						\
+#define CM_SetTrmPolygonSidedness( v, point, plane, bitNum ) {				\
 	const int mask = 1 << bitNum;											\
 	if ( ( (v)->sideSet & mask ) == 0 ) {									\
-		const float fl = plane.Distance( (v)->p );							\
+		const float fl = plane.Distance( point );							\
 		(v)->side = ( (v)->side & ~mask ) | ( ( fl < 0.0f ) ? mask : 0 );		\
 		(v)->sideSet |= mask;												\
 	}																		\
@@ -166,13 +165,13 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t* tw, cm_poly
 	cm_trmEdge_t* trmEdge;
 	cm_edge_t* edge;
 	cm_vertex_t* v, *v1, *v2;
+	cm_primitiveMark_t* edgeMark, *vMark, *v1Mark, *v2Mark;
 
 	// if already checked this polygon
-	if( p->checkcount == idCollisionModelManagerLocal::checkCount )
+	if( CM_CheckVisited( tw->thread, p ) )
 	{
 		return false;
 	}
-	p->checkcount = idCollisionModelManagerLocal::checkCount;
 
 	// if this polygon does not have the right contents behind it
 	if( !( p->contents & tw->contents ) )
@@ -210,7 +209,7 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t* tw, cm_poly
 			edgeNum = p->edges[i];
 			edge = tw->model->edges + abs( edgeNum );
 			// if this edge is already tested
-			if( edge->checkcount == idCollisionModelManagerLocal::checkCount )
+			if( CM_EdgeMark( tw, edge )->checkcount == tw->thread->checkCount )
 			{
 				continue;
 			}
@@ -219,7 +218,7 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t* tw, cm_poly
 			{
 				v = &tw->model->vertices[edge->vertexNum[j]];
 				// if this vertex is already tested
-				if( v->checkcount == idCollisionModelManagerLocal::checkCount )
+				if( CM_VertexMark( tw, v )->checkcount == tw->thread->checkCount )
 				{
 					continue;
 				}
@@ -260,21 +259,22 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t* tw, cm_poly
 	{
 		edgeNum = p->edges[i];
 		edge = tw->model->edges + abs( edgeNum );
+		edgeMark = CM_EdgeMark( tw, edge );
 		// reset sidedness cache if this is the first time we encounter this edge
-		if( edge->checkcount != idCollisionModelManagerLocal::checkCount )
+		if( edgeMark->checkcount != tw->thread->checkCount )
 		{
-			edge->sideSet = 0;
+			edgeMark->sideSet = 0;
 		}
 		// pluecker coordinate for edge
 		tw->polygonEdgePlueckerCache[i].FromLine( tw->model->vertices[edge->vertexNum[0]].p,
 				tw->model->vertices[edge->vertexNum[1]].p );
-		v = &tw->model->vertices[edge->vertexNum[INT32_SIGNBITSET( edgeNum )]];
+		vMark = CM_VertexMark( tw, &tw->model->vertices[edge->vertexNum[INT32_SIGNBITSET( edgeNum )]] );
 		// reset sidedness cache if this is the first time we encounter this vertex
-		if( v->checkcount != idCollisionModelManagerLocal::checkCount )
+		if( vMark->checkcount != tw->thread->checkCount )
 		{
-			v->sideSet = 0;
+			vMark->sideSet = 0;
 		}
-		v->checkcount = idCollisionModelManagerLocal::checkCount;
+		vMark->checkcount = tw->thread->checkCount;
 	}
 
 	// get side of polygon for each trm vertex
@@ -298,10 +298,10 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t* tw, cm_poly
 		for( j = 0; j < p->numEdges; j++ )
 		{
 			edgeNum = p->edges[j];
-			edge = tw->model->edges + abs( edgeNum );
+			edgeMark = CM_EdgeMark( tw, tw->model->edges + abs( edgeNum ) );
 #if 1
-			CM_SetTrmEdgeSidedness( edge, tw->edges[i].pl, tw->polygonEdgePlueckerCache[j], i );
-			if( INT32_SIGNBITSET( edgeNum ) ^ ( ( edge->side >> i ) & 1 ) ^ flip )
+			CM_SetTrmEdgeSidedness( edgeMark, tw->edges[i].pl, tw->polygonEdgePlueckerCache[j], i );
+			if( INT32_SIGNBITSET( edgeNum ) ^ ( ( edgeMark->side >> i ) & 1 ) ^ flip )
 			{
 				break;
 			}
@@ -347,25 +347,28 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t* tw, cm_poly
 	{
 		edgeNum = p->edges[i];
 		edge = tw->model->edges + abs( edgeNum );
-		if( edge->checkcount == idCollisionModelManagerLocal::checkCount )
+		edgeMark = CM_EdgeMark( tw, edge );
+		if( edgeMark->checkcount == tw->thread->checkCount )
 		{
 			continue;
 		}
-		edge->checkcount = idCollisionModelManagerLocal::checkCount;
+		edgeMark->checkcount = tw->thread->checkCount;
 
 		for( j = 0; j < tw->numPolys; j++ )
 		{
 #if 1
 			v1 = tw->model->vertices + edge->vertexNum[0];
-			CM_SetTrmPolygonSidedness( v1, tw->polys[j].plane, j );
+			v1Mark = CM_VertexMark( tw, v1 );
+			CM_SetTrmPolygonSidedness( v1Mark, v1->p, tw->polys[j].plane, j );
 			v2 = tw->model->vertices + edge->vertexNum[1];
-			CM_SetTrmPolygonSidedness( v2, tw->polys[j].plane, j );
+			v2Mark = CM_VertexMark( tw, v2 );
+			CM_SetTrmPolygonSidedness( v2Mark, v2->p, tw->polys[j].plane, j );
 			// if the polygon edge does not cross the trm polygon plane
-			if( !( ( ( v1->side ^ v2->side ) >> j ) & 1 ) )
+			if( !( ( ( v1Mark->side ^ v2Mark->side ) >> j ) & 1 ) )
 			{
 				continue;
 			}
-			flip = ( v1->side >> j ) & 1;
+			flip = ( v1Mark->side >> j ) & 1;
 #else
 			float d1, d2;
 
@@ -391,8 +394,8 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t* tw, cm_poly
 				trmEdge = tw->edges + abs( trmEdgeNum );
 #if 1
 				bitNum = abs( trmEdgeNum );
-				CM_SetTrmEdgeSidedness( edge, trmEdge->pl, tw->polygonEdgePlueckerCache[i], bitNum );
-				if( INT32_SIGNBITSET( trmEdgeNum ) ^ ( ( edge->side >> bitNum ) & 1 ) ^ flip )
+				CM_SetTrmEdgeSidedness( edgeMark, trmEdge->pl, tw->polygonEdgePlueckerCache[i], bitNum );
+				if( INT32_SIGNBITSET( trmEdgeNum ) ^ ( ( edgeMark->side >> bitNum ) & 1 ) ^ flip )
 				{
 					break;
 				}
@@ -476,7 +479,7 @@ int idCollisionModelManagerLocal::PointContents( const idVec3 p, cmHandle_t mode
 	cm_brush_t* b;
 	idPlane* plane;
 
-	node = idCollisionModelManagerLocal::PointNode( p, idCollisionModelManagerLocal::models[model] );
+	node = idCollisionModelManagerLocal::PointNode( p, idCollisionModelManagerLocal::ModelForHandle( model ) );
 	for( bref = node->brushes; bref; bref = bref->next )
 	{
 		b = bref->b;
@@ -562,7 +565,7 @@ int idCollisionModelManagerLocal::ContentsTrm( trace_t* results, const idVec3& s
 		return results->c.contents;
 	}
 
-	idCollisionModelManagerLocal::checkCount++;
+	idCollisionModelManagerLocal::StartTrace( &tw, idCollisionModelManagerLocal::ModelForHandle( model ) );
 
 	tw.trace.fraction = 1.0f;
 	tw.trace.c.contents = 0;
@@ -575,8 +578,8 @@ int idCollisionModelManagerLocal::ContentsTrm( trace_t* results, const idVec3& s
 	tw.positionTest = true;
 	tw.pointTrace = false;
 	tw.quickExit = false;
+	tw.getContacts = false;
 	tw.numContacts = 0;
-	tw.model = idCollisionModelManagerLocal::models[model];
 	tw.start = start - modelOrigin;
 	tw.end = tw.start;
 
@@ -729,7 +732,7 @@ int idCollisionModelManagerLocal::Contents( const idVec3& start,
 		common->Printf( "idCollisionModelManagerLocal::Contents: invalid model handle\n" );
 		return 0;
 	}
-	if( !idCollisionModelManagerLocal::models || !idCollisionModelManagerLocal::models[model] )
+	if( !idCollisionModelManagerLocal::models || !idCollisionModelManagerLocal::ModelForHandle( model ) )
 	{
 		common->Printf( "idCollisionModelManagerLocal::Contents: invalid model\n" );
 		return 0;
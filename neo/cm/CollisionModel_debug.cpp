@@ -379,7 +379,7 @@ void idCollisionModelManagerLocal::DrawModel( cmHandle_t handle, const idVec3& m
 		cm_drawColor.ClearModified();
 	}
 
-	model = models[ handle ];
+	model = ModelForHandle( handle );
 	viewPos = ( viewOrigin - modelOrigin ) * modelAxis.Transpose();
 	checkCount++;
 	DrawNodePolygons( model, model->node, modelOrigin, modelAxis, viewPos, radius );
@@ -583,3 +583,143 @@ void idCollisionModelManagerLocal::DebugOutput( const idVec3& origin )
 	Mem_Free( testend );
 	testend = NULL;
 }
+
+/*
+===============================================================================
+
+Multi-threaded trace throughput
+
+===============================================================================
+*/
+
+struct cmTraceBenchmark_t
+{
+	const idVec3* 		starts;
+	const idVec3* 		ends;
+	const idTraceModel* trm;
+	int					firstTrace;
+	int					numTraces;
+	double				fractionSum;
+};
+
+/*
+================
+CM_TraceBenchmarkJob
+
+  every other trace is a point trace, the others trace the box trace model
+================
+*/
+static void CM_TraceBenchmarkJob( cmTraceBenchmark_t* parms )
+{
+	trace_t trace;
+
+	parms->fractionSum = 0.0;
+	for( int i = parms->firstTrace; i < parms->firstTrace + parms->numTraces; i++ )
+	{
+		collisionModelManager->Translation( &trace, parms->starts[i], parms->ends[i], ( i & 1 ) ? parms->trm : NULL, mat3_identity,
+											CONTENTS_SOLID | CONTENTS_PLAYERCLIP, 0, vec3_origin, mat3_identity );
+		parms->fractionSum += trace.fraction;
+	}
+}
+
+REGISTER_PARALLEL_JOB( CM_TraceBenchmarkJob, "CM_TraceBenchmarkJob" );
+
+CONSOLE_COMMAND( cm_benchmarkTraces, "reports traces/sec through the world collision model for an increasing number of job threads, usage: cm_benchmarkTraces [numTraces]", 0 )
+{
+	const int numTraces = ( args.Argc() > 1 ) ? idMath::ClampInt( 64, 1 << 22, atoi( args.Argv( 1 ) ) ) : 65536;
+	const int tracesPerJob = 64;
+	const int numJobs = ( numTraces + tracesPerJob - 1 ) / tracesPerJob;
+	const int numRuns = 3;
+	const int maxThreads = Max( 1, parallelJobManager->GetNumProcessingUnits() );
+	idBounds worldBounds, boxBounds;
+
+	if( !collisionModelManager->GetModelBounds( 0, worldBounds ) )
+	{
+		common->Printf( "no collision map loaded\n" );
+		return;
+	}
+
+	sscanf( cm_testBox.GetString(), "%f %f %f %f %f %f", &boxBounds[0][0], &boxBounds[0][1], &boxBounds[0][2],
+			&boxBounds[1][0], &boxBounds[1][1], &boxBounds[1][2] );
+	idTraceModel trm( boxBounds );
+
+	// random traces starting inside the world bounds
+	idVec3* starts = ( idVec3* ) Mem_Alloc( numTraces * sizeof( idVec3 ), TAG_COLLISION );
+	idVec3* ends = ( idVec3* ) Mem_Alloc( numTraces * sizeof( idVec3 ), TAG_COLLISION );
+	idRandom random( 0 );
+	for( int i = 0; i < numTraces; i++ )
+	{
+		for( int j = 0; j < 3; j++ )
+		{
+			starts[i][j] = worldBounds[0][j] + random.RandomFloat() * ( worldBounds[1][j] - worldBounds[0][j] );
+			ends[i][j] = starts[i][j] + random.CRandomFloat() * cm_testLength.GetFloat();
+		}
+	}
+
+	cmTraceBenchmark_t* jobs = ( cmTraceBenchmark_t* ) Mem_ClearedAlloc( numJobs * sizeof( cmTraceBenchmark_t ), TAG_COLLISION );
+	for( int i = 0; i < numJobs; i++ )
+	{
+		jobs[i].starts = starts;
+		jobs[i].ends = ends;
+		jobs[i].trm = &trm;
+		jobs[i].firstTrace = i * tracesPerJob;
+		jobs[i].numTraces = Min( tracesPerJob, numTraces - jobs[i].firstTrace );
+	}
+
+	idParallelJobList* jobList = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_MEDIUM, numJobs, 0, NULL );
+
+	common->Printf( "%d traces, half of them with a box trace model, best of %d runs\n", numTraces, numRuns );
+	common->Printf( "threads   traces/sec   speedup\n" );
+
+	double referenceSum = 0.0;
+	float singleThreaded = 0.0f;
+	for( int numThreads = 1; ; numThreads = Min( numThreads * 2, maxThreads ) )
+	{
+		uint64 bestTime = 0;
+		for( int run = 0; run < numRuns; run++ )
+		{
+			for( int i = 0; i < numJobs; i++ )
+			{
+				jobList->AddJob( ( jobRun_t )CM_TraceBenchmarkJob, &jobs[i] );
+			}
+
+			const uint64 startTime = Sys_Microseconds();
+			jobList->Submit( NULL, numThreads );
+			jobList->Wait();
+			const uint64 time = Sys_Microseconds() - startTime;
+
+			if( run == 0 || time < bestTime )
+			{
+				bestTime = time;
+			}
+		}
+
+		// the traces must give the same results no matter how many threads run them
+		double fractionSum = 0.0;
+		for( int i = 0; i < numJobs; i++ )
+		{
+			fractionSum += jobs[i].fractionSum;
+		}
+		if( numThreads == 1 )
+		{
+			referenceSum = fractionSum;
+		}
+
+		const float tracesPerSec = numTraces * 1000000.0f / Max( bestTime, ( uint64 )1 );
+		if( numThreads == 1 )
+		{
+			singleThreaded = tracesPerSec;
+		}
+		common->Printf( "%7d %12.0f %8.2fx%s\n", numThreads, tracesPerSec, tracesPerSec / singleThreaded, ( fractionSum != referenceSum ) ? "  RESULTS DIFFER" : "" );
+
+		if( numThreads >= maxThreads )
+		{
+			break;
+		}
+	}
+
+	parallelJobManager->FreeJobList( jobList );
+	Mem_Free( jobs );
+	Mem_Free( ends );
+	Mem_Free( starts );
+}
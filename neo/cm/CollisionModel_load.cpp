@@ -200,15 +200,9 @@ void idCollisionModelManagerLocal::Clear()
 	maxModels = 0;
 	numModels = 0;
 	models = NULL;
-	memset( trmPolygons, 0, sizeof( trmPolygons ) );
-	trmBrushes[0] = NULL;
 	trmMaterial = NULL;
 	numProcNodes = 0;
 	procNodes = NULL;
-	getContacts = false;
-	contacts = NULL;
-	maxContacts = 0;
-	numContacts = 0;
 }
 
 /*
@@ -474,7 +468,7 @@ void idCollisionModelManagerLocal::FreeMap()
 		FreeModel( models[i] );
 	}
 
-	FreeTrmModelStructure();
+	FreeTraceThreads();
 
 	Mem_Free( models );
 
@@ -488,25 +482,25 @@ void idCollisionModelManagerLocal::FreeMap()
 idCollisionModelManagerLocal::FreeTrmModelStructure
 ================
 */
-void idCollisionModelManagerLocal::FreeTrmModelStructure()
+void idCollisionModelManagerLocal::FreeTrmModelStructure( cm_traceThread_t* thread )
 {
 	int i;
 
-	assert( models );
-	if( !models[MAX_SUBMODELS] )
+	if( !thread->trmModel )
 	{
 		return;
 	}
 
 	for( i = 0; i < MAX_TRACEMODEL_POLYS; i++ )
 	{
-		FreePolygon( models[MAX_SUBMODELS], trmPolygons[i]->p );
+		FreePolygon( thread->trmModel, thread->trmPolygons[i]->p );
 	}
-	FreeBrush( models[MAX_SUBMODELS], trmBrushes[0]->b );
+	FreeBrush( thread->trmModel, thread->trmBrushes[0]->b );
 
-	models[MAX_SUBMODELS]->node->polygons = NULL;
-	models[MAX_SUBMODELS]->node->brushes = NULL;
-	FreeModel( models[MAX_SUBMODELS] );
+	thread->trmModel->node->polygons = NULL;
+	thread->trmModel->node->brushes = NULL;
+	FreeModel( thread->trmModel );
+	thread->trmModel = NULL;
 }
 
 
@@ -821,9 +815,11 @@ void idCollisionModelManagerLocal::AddBrushToNode( cm_model_t* model, cm_node_t*
 /*
 ================
 idCollisionModelManagerLocal::SetupTrmModelStructure
+
+  every thread gets its own trm model so trace models can be set up and traced on any thread
 ================
 */
-void idCollisionModelManagerLocal::SetupTrmModelStructure()
+void idCollisionModelManagerLocal::SetupTrmModelStructure( cm_traceThread_t* thread )
 {
 	int i;
 	cm_node_t* node;
@@ -832,8 +828,8 @@ void idCollisionModelManagerLocal::SetupTrmModelStructure()
 	// setup model
 	model = AllocModel();
 
-	assert( models );
-	models[MAX_SUBMODELS] = model;
+	assert( trmMaterial );
+	thread->trmModel = model;
 	// create node to hold the collision data
 	node = ( cm_node_t* ) AllocNode( model, 1 );
 	node->planeType = -1;
@@ -845,42 +841,36 @@ void idCollisionModelManagerLocal::SetupTrmModelStructure()
 	model->numEdges = 0;
 	model->maxEdges = MAX_TRACEMODEL_EDGES + 1;
 	model->edges = ( cm_edge_t* ) Mem_ClearedAlloc( model->maxEdges * sizeof( cm_edge_t ), TAG_COLLISION );
-	// create a material for the trace model polygons
-	trmMaterial = declManager->FindMaterial( "_tracemodel", false );
-	if( !trmMaterial )
-	{
-		common->FatalError( "_tracemodel material not found" );
-	}
 
 	// allocate polygons
 	for( i = 0; i < MAX_TRACEMODEL_POLYS; i++ )
 	{
-		trmPolygons[i] = AllocPolygonReference( model, MAX_TRACEMODEL_POLYS );
-		trmPolygons[i]->p = AllocPolygon( model, MAX_TRACEMODEL_POLYEDGES );
-		trmPolygons[i]->p->bounds.Clear();
-		trmPolygons[i]->p->plane.Zero();
-		trmPolygons[i]->p->checkcount = 0;
-		trmPolygons[i]->p->contents = -1;		// all contents
-		trmPolygons[i]->p->material = trmMaterial;
-		trmPolygons[i]->p->numEdges = 0;
+		thread->trmPolygons[i] = AllocPolygonReference( model, MAX_TRACEMODEL_POLYS );
+		thread->trmPolygons[i]->p = AllocPolygon( model, MAX_TRACEMODEL_POLYEDGES );
+		thread->trmPolygons[i]->p->bounds.Clear();
+		thread->trmPolygons[i]->p->plane.Zero();
+		thread->trmPolygons[i]->p->checkcount = 0;
+		thread->trmPolygons[i]->p->contents = -1;		// all contents
+		thread->trmPolygons[i]->p->material = trmMaterial;
+		thread->trmPolygons[i]->p->numEdges = 0;
 	}
 	// allocate brush for position test
-	trmBrushes[0] = AllocBrushReference( model, 1 );
-	trmBrushes[0]->b = AllocBrush( model, MAX_TRACEMODEL_POLYS );
-	trmBrushes[0]->b->primitiveNum = 0;
-	trmBrushes[0]->b->bounds.Clear();
-	trmBrushes[0]->b->checkcount = 0;
-	trmBrushes[0]->b->contents = -1;		// all contents
-	trmBrushes[ 0 ]->b->material = trmMaterial;
-	trmBrushes[0]->b->numPlanes = 0;
+	thread->trmBrushes[0] = AllocBrushReference( model, 1 );
+	thread->trmBrushes[0]->b = AllocBrush( model, MAX_TRACEMODEL_POLYS );
+	thread->trmBrushes[0]->b->primitiveNum = 0;
+	thread->trmBrushes[0]->b->bounds.Clear();
+	thread->trmBrushes[0]->b->checkcount = 0;
+	thread->trmBrushes[0]->b->contents = -1;		// all contents
+	thread->trmBrushes[0]->b->material = trmMaterial;
+	thread->trmBrushes[0]->b->numPlanes = 0;
 }
 
 /*
 ================
 idCollisionModelManagerLocal::SetupTrmModel
 
-Trace models (item boxes, etc) are converted to collision models on the fly, using the last model slot
-as a reusable temporary buffer
+Trace models (item boxes, etc) are converted to collision models on the fly, using the trm model
+of the calling thread as a reusable temporary buffer
 ================
 */
 cmHandle_t idCollisionModelManagerLocal::SetupTrmModel( const idTraceModel& trm, const idMaterial* material )
@@ -893,6 +883,7 @@ cmHandle_t idCollisionModelManagerLocal::SetupTrmModel( const idTraceModel& trm,
 	const traceModelVert_t* trmVert;
 	const traceModelEdge_t* trmEdge;
 	const traceModelPoly_t* trmPoly;
+	cm_traceThread_t* thread;
 
 	assert( models );
 
@@ -901,7 +892,8 @@ cmHandle_t idCollisionModelManagerLocal::SetupTrmModel( const idTraceModel& trm,
 		material = trmMaterial;
 	}
 
-	model = models[MAX_SUBMODELS];
+	thread = GetTraceThread();
+	model = thread->trmModel;
 	model->node->brushes = NULL;
 	model->node->polygons = NULL;
 	// if not a valid trace model
@@ -935,7 +927,7 @@ cmHandle_t idCollisionModelManagerLocal::SetupTrmModel( const idTraceModel& trm,
 	trmPoly = trm.polys;
 	for( i = 0; i < trm.numPolys; i++, trmPoly++ )
 	{
-		poly = trmPolygons[i]->p;
+		poly = thread->trmPolygons[i]->p;
 		poly->numEdges = trmPoly->numEdges;
 		for( j = 0; j < trmPoly->numEdges; j++ )
 		{
@@ -946,23 +938,23 @@ cmHandle_t idCollisionModelManagerLocal::SetupTrmModel( const idTraceModel& trm,
 		poly->bounds = trmPoly->bounds;
 		poly->material = material;
 		// link polygon at node
-		trmPolygons[i]->next = model->node->polygons;
-		model->node->polygons = trmPolygons[i];
+		thread->trmPolygons[i]->next = model->node->polygons;
+		model->node->polygons = thread->trmPolygons[i];
 	}
 	// if the trace model is convex
 	if( trm.isConvex )
 	{
 		// setup brush for position test
-		trmBrushes[0]->b->numPlanes = trm.numPolys;
+		thread->trmBrushes[0]->b->numPlanes = trm.numPolys;
 		for( i = 0; i < trm.numPolys; i++ )
 		{
-			trmBrushes[0]->b->planes[i] = trmPolygons[i]->p->plane;
+			thread->trmBrushes[0]->b->planes[i] = thread->trmPolygons[i]->p->plane;
 		}
-		trmBrushes[0]->b->bounds = trm.bounds;
+		thread->trmBrushes[0]->b->bounds = trm.bounds;
 		// link brush at node
-		trmBrushes[0]->next = model->node->brushes;
-		trmBrushes[ 0 ]->b->material = material;
-		model->node->brushes = trmBrushes[0];
+		thread->trmBrushes[0]->next = model->node->brushes;
+		thread->trmBrushes[0]->b->material = material;
+		model->node->brushes = thread->trmBrushes[0];
 	}
 	// model bounds
 	model->bounds = trm.bounds;
@@ -4229,13 +4221,13 @@ void idCollisionModelManagerLocal::ModelInfo( cmHandle_t model )
 		common->Printf( "idCollisionModelManagerLocal::ModelInfo: invalid model handle\n" );
 		return;
 	}
-	if( !models[model] )
+	if( !ModelForHandle( model ) )
 	{
 		common->Printf( "idCollisionModelManagerLocal::ModelInfo: invalid model\n" );
 		return;
 	}
 
-	PrintModelInfo( models[model] );
+	PrintModelInfo( ModelForHandle( model ) );
 }
 
 /*
@@ -4396,8 +4388,12 @@ void idCollisionModelManagerLocal::LoadMap( const idMapFile* mapFile, bool ignor
 
 	common->UpdateLevelLoadPacifier();
 
-	// setup trace model structure
-	SetupTrmModelStructure();
+	// material for the trace model polygons, the trace model structures are set up per thread
+	trmMaterial = declManager->FindMaterial( "_tracemodel", false );
+	if( !trmMaterial )
+	{
+		common->FatalError( "_tracemodel material not found" );
+	}
 
 	common->UpdateLevelLoadPacifier();
 
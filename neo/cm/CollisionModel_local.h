@@ -44,6 +44,8 @@ If you have questions concerning this license or the applicable additional terms
 
 #define	MAX_SUBMODELS						2048
 #define	TRACE_MODEL_HANDLE					MAX_SUBMODELS
+#define CM_MAX_TRACE_THREADS				64
+#define CM_MIN_VISIT_HASH_SIZE				1024		// must be power of 2
 
 #define VERTEX_HASH_BOXSIZE					(1<<6)	// must be power of 2
 #define VERTEX_HASH_SIZE					(VERTEX_HASH_BOXSIZE*VERTEX_HASH_BOXSIZE)
@@ -261,8 +263,51 @@ typedef struct cm_trmPolygon_s
 	idBounds rotationBounds;						// rotation bounds for this polygon
 } cm_trmPolygon_t;
 
+/*
+===============================================================================
+
+Per thread trace state
+
+A trace never writes to the collision model geometry. Everything it remembers
+about the primitives it already visited is stored with the calling thread so
+several threads can trace through the same collision models at once.
+
+===============================================================================
+*/
+
+typedef struct cm_primitiveMark_s
+{
+	int						checkcount;			// for multi-check avoidance
+	unsigned int			side;				// same as cm_vertex_t::side or cm_edge_t::side
+	unsigned int			sideSet;			// same as cm_vertex_t::sideSet or cm_edge_t::sideSet
+} cm_primitiveMark_t;
+
+typedef struct cm_visitMark_s
+{
+	const void* 			primitive;			// polygon or brush
+	int						checkcount;			// trace that visited the primitive
+} cm_visitMark_t;
+
+typedef struct cm_traceThread_s
+{
+	interlockedInt_t		inUse;				// set while a running thread owns the state
+	int						checkCount;			// incremented for every trace run by this thread
+	int						maxVertexMarks;		// size of vertex mark array
+	cm_primitiveMark_t* 	vertexMarks;		// indexed with the model vertex number
+	int						maxEdgeMarks;		// size of edge mark array
+	cm_primitiveMark_t* 	edgeMarks;			// indexed with the model edge number
+	int						numVisited;			// number of polygons and brushes visited by the current trace
+	int						visitHashSize;		// size of the visit hash, always a power of 2
+	cm_visitMark_t* 		visitHash;			// open addressing hash with the visited polygons and brushes
+	// trace model converted to a collision model by SetupTrmModel
+	cm_model_t* 			trmModel;
+	cm_polygonRef_t* 		trmPolygons[MAX_TRACEMODEL_POLYS];
+	cm_brushRef_t* 			trmBrushes[1];
+} cm_traceThread_t;
+
 typedef struct cm_traceWork_s
 {
+	cm_traceThread_t* thread;						// state of the thread running the trace
 	int numVerts;
 	cm_trmVertex_t vertices[MAX_TRACEMODEL_VERTS];	// trm vertices
 	int numEdges;
@@ -308,6 +353,71 @@ typedef struct cm_traceWork_s
 	idVec3 polygonRotationOriginCache[CM_MAX_POLYGON_EDGES];
 } cm_traceWork_t;
 
+/*
+================
+CM_VertexMark
+
+  trace marks of a vertex of the model being traced
+================
+*/
+ID_INLINE cm_primitiveMark_t* CM_VertexMark( const cm_traceWork_t* tw, const cm_vertex_t* v )
+{
+	return &tw->thread->vertexMarks[v - tw->model->vertices];
+}
+
+/*
+================
+CM_EdgeMark
+
+  trace marks of an edge of the model being traced
+================
+*/
+ID_INLINE cm_primitiveMark_t* CM_EdgeMark( const cm_traceWork_t* tw, const cm_edge_t* edge )
+{
+	return &tw->thread->edgeMarks[edge - tw->model->edges];
+}
+
+void CM_GrowVisitHash( cm_traceThread_t* thread );
+
+/*
+================
+CM_CheckVisited
+
+  returns true if the polygon or brush was already visited by the current trace,
+  otherwise the primitive is marked as visited
+================
+*/
+ID_INLINE bool CM_CheckVisited( cm_traceThread_t* thread, const void* primitive )
+{
+	unsigned int hash;
+	cm_visitMark_t* mark;
+
+	if( thread->numVisited * 2 >= thread->visitHashSize )
+	{
+		CM_GrowVisitHash( thread );
+	}
+	hash = ( unsigned int )( ( uintptr_t )primitive >> 4 ) * 2654435761U;
+	hash ^= hash >> 16;
+	while( 1 )
+	{
+		hash &= thread->visitHashSize - 1;
+		mark = &thread->visitHash[hash];
+		// marks left behind by previous traces count as empty slots
+		if( mark->checkcount != thread->checkCount )
+		{
+			mark->primitive = primitive;
+			mark->checkcount = thread->checkCount;
+			thread->numVisited++;
+			return false;
+		}
+		if( mark->primitive == primitive )
+		{
+			return true;
+		}
+		hash++;
+	}
+}
+
 /*
 ===============================================================================
 
@@ -390,6 +500,10 @@ private:			// CollisionMap_translate.cpp
 	bool			TranslateTrmThroughPolygon( cm_traceWork_t* tw, cm_polygon_t* p );
 	void			SetupTranslationHeartPlanes( cm_traceWork_t* tw );
 	void			SetupTrm( cm_traceWork_t* tw, const idTraceModel* trm );
+	void			Translation( trace_t* results, const idVec3& start, const idVec3& end,
+								 const idTraceModel* trm, const idMat3& trmAxis, int contentMask,
+								 cmHandle_t model, const idVec3& modelOrigin, const idMat3& modelAxis,
+								 contactInfo_t* contacts, const int maxContacts, int& numContacts );
 
 private:			// CollisionMap_rotate.cpp
 	int				CollisionBetweenEdgeBounds( cm_traceWork_t* tw, const idVec3& va, const idVec3& vb,
@@ -429,6 +543,10 @@ private:			// CollisionMap_contents.cpp
 								 cmHandle_t model, const idVec3& modelOrigin, const idMat3& modelAxis );
 
 private:			// CollisionMap_trace.cpp
+	cm_traceThread_t* GetTraceThread();
+	void			FreeTraceThreads();
+	cm_model_t* 	ModelForHandle( cmHandle_t model );
+	void			StartTrace( cm_traceWork_t* tw, cm_model_t* model );
 	void			TraceTrmThroughNode( cm_traceWork_t* tw, cm_node_t* node );
 	void			TraceThroughAxialBSPTree_r( cm_traceWork_t* tw, cm_node_t* node, float p1f, float p2f, idVec3& p1, idVec3& p2 );
 	void			TraceThroughModel( cm_traceWork_t* tw );
@@ -436,7 +554,7 @@ private:			// CollisionMap_trace.cpp
 
 private:			// CollisionMap_load.cpp
 	void			Clear();
-	void			FreeTrmModelStructure();
+	void			FreeTrmModelStructure( cm_traceThread_t* thread );
 	// model deallocation
 	void			RemovePolygonReferences_r( cm_node_t* node, cm_polygon_t* p );
 	void			RemoveBrushReferences_r( cm_node_t* node, cm_brush_t* b );
@@ -476,7 +594,7 @@ private:			// CollisionMap_load.cpp
 	cm_brush_t* 	AllocBrush( cm_model_t* model, int numPlanes );
 	void			AddPolygonToNode( cm_model_t* model, cm_node_t* node, cm_polygon_t* p );
 	void			AddBrushToNode( cm_model_t* model, cm_node_t* node, cm_brush_t* b );
-	void			SetupTrmModelStructure();
+	void			SetupTrmModelStructure( cm_traceThread_t* thread );
 	void			R_FilterPolygonIntoTree( cm_model_t* model, cm_node_t* node, cm_polygonRef_t* pref, cm_polygon_t* p );
 	void			R_FilterBrushIntoTree( cm_model_t* model, cm_node_t* node, cm_brushRef_t* pref, cm_brush_t* b );
 	cm_node_t* 		R_CreateAxialBSPTree( cm_model_t* model, cm_node_t* node, const idBounds& bounds );
@@ -545,24 +663,19 @@ private:			// collision map data
 	idStr			mapName;
 	ID_TIME_T			mapFileTime;
 	int				loaded;
-	// for multi-check avoidance
+	// for multi-check avoidance while loading, writing and drawing models
 	int				checkCount;
 	// models
 	int				maxModels;
 	int				numModels;
 	cm_model_t** 	models;
-	// polygons and brush for trm model
-	cm_polygonRef_t* trmPolygons[MAX_TRACEMODEL_POLYS];
-	cm_brushRef_t* 	trmBrushes[1];
+	// material for trm model polygons
 	const idMaterial* trmMaterial;
 	// for data pruning
 	int				numProcNodes;
 	cm_procNode_t* 	procNodes;
-	// for retrieving contact points
-	bool			getContacts;
-	contactInfo_t* 	contacts;
-	int				maxContacts;
-	int				numContacts;
+	// state of the threads running traces, not reset with the map, reused once a thread exits
+	cm_traceThread_t traceThreads[CM_MAX_TRACE_THREADS];
 };
 
 // for debugging
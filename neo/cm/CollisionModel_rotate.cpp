@@ -554,7 +554,7 @@ void idCollisionModelManagerLocal::RotateTrmEdgeThroughPolygon( cm_traceWork_t*
 		edge = tw->model->edges + abs( edgeNum );
 
 		// if this edge is already checked
-		if( edge->checkcount == idCollisionModelManagerLocal::checkCount )
+		if( CM_EdgeMark( tw, edge )->checkcount == tw->thread->checkCount )
 		{
 			continue;
 		}
@@ -1190,14 +1190,14 @@ bool idCollisionModelManagerLocal::RotateTrmThroughPolygon( cm_traceWork_t* tw,
 	cm_trmPolygon_t* bp;
 	cm_vertex_t* v;
 	cm_edge_t* e;
+	cm_primitiveMark_t* vMark, *eMark;
 	idVec3* rotationOrigin;
 
 	// if already checked this polygon
-	if( p->checkcount == idCollisionModelManagerLocal::checkCount )
+	if( CM_CheckVisited( tw->thread, p ) )
 	{
 		return false;
 	}
-	p->checkcount = idCollisionModelManagerLocal::checkCount;
 
 	// if this polygon does not have the right contents behind it
 	if( !( p->contents & tw->contents ) )
@@ -1310,13 +1310,14 @@ bool idCollisionModelManagerLocal::RotateTrmThroughPolygon( cm_traceWork_t* tw,
 		{
 			edgeNum = p->edges[i];
 			e = tw->model->edges + abs( edgeNum );
+			eMark = CM_EdgeMark( tw, e );
 
-			if( e->checkcount == idCollisionModelManagerLocal::checkCount )
+			if( eMark->checkcount == tw->thread->checkCount )
 			{
 				continue;
 			}
 			// set edge check count
-			e->checkcount = idCollisionModelManagerLocal::checkCount;
+			eMark->checkcount = tw->thread->checkCount;
 			// can never collide with internal edges
 			if( e->internal )
 			{
@@ -1327,14 +1328,15 @@ bool idCollisionModelManagerLocal::RotateTrmThroughPolygon( cm_traceWork_t* tw,
 			{
 
 				v = tw->model->vertices + e->vertexNum[k ^ INT32_SIGNBITSET( edgeNum )];
+				vMark = CM_VertexMark( tw, v );
 
 				// if this vertex is already checked
-				if( v->checkcount == idCollisionModelManagerLocal::checkCount )
+				if( vMark->checkcount == tw->thread->checkCount )
 				{
 					continue;
 				}
 				// set vertex check count
-				v->checkcount = idCollisionModelManagerLocal::checkCount;
+				vMark->checkcount = tw->thread->checkCount;
 
 				// if the vertex is outside the trm rotation bounds
 				if( !tw->bounds.ContainsPoint( v->p ) )
@@ -1428,24 +1430,26 @@ void idCollisionModelManagerLocal::Rotation180( trace_t* results, const idVec3&
 	cm_trmPolygon_t* poly;
 	cm_trmEdge_t* edge;
 	cm_trmVertex_t* vert;
-	ALIGN16( static cm_traceWork_t tw );
+	ALIGN16( cm_traceWork_t tw );
 
 	if( model < 0 || model > MAX_SUBMODELS || model > idCollisionModelManagerLocal::maxModels )
 	{
 		common->Printf( "idCollisionModelManagerLocal::Rotation180: invalid model handle\n" );
 		return;
 	}
-	if( !idCollisionModelManagerLocal::models[model] )
+	if( !idCollisionModelManagerLocal::ModelForHandle( model ) )
 	{
 		common->Printf( "idCollisionModelManagerLocal::Rotation180: invalid model\n" );
 		return;
 	}
 
-	idCollisionModelManagerLocal::checkCount++;
+	idCollisionModelManagerLocal::StartTrace( &tw, idCollisionModelManagerLocal::ModelForHandle( model ) );
 
 	tw.trace.fraction = 1.0f;
 	tw.trace.c.contents = 0;
 	tw.trace.c.type = CONTACT_NONE;
+	tw.trace.c.material = NULL;
+	tw.trace.c.id = 0;
 	tw.contents = contentMask;
 	tw.isConvex = true;
 	tw.rotation = true;
@@ -1455,7 +1459,6 @@ void idCollisionModelManagerLocal::Rotation180( trace_t* results, const idVec3&
 	tw.angle = endAngle - startAngle;
 	assert( tw.angle > -180.0f && tw.angle < 180.0f );
 	tw.maxTan = initialTan = idMath::Fabs( tan( ( idMath::PI / 360.0f ) * tw.angle ) );
-	tw.model = idCollisionModelManagerLocal::models[model];
 	tw.start = start - modelOrigin;
 	// rotation axis, axis is assumed to be normalized
 	tw.axis = axis;
@@ -42,6 +42,176 @@ If you have questions concerning this license or the applicable additional terms
 /*
 ===============================================================================
 
+Per thread trace state
+
+===============================================================================
+*/
+
+// gives the trace state back when the thread exits, ID_TLS has no destructor per thread
+class idTraceThreadOwner
+{
+public:
+	idTraceThreadOwner() : thread( NULL ) {}
+	~idTraceThreadOwner()
+	{
+		if( thread != NULL )
+		{
+			Sys_InterlockedExchange( thread->inUse, 0 );
+		}
+	}
+
+	cm_traceThread_t* 		thread;		// NULL until the thread runs its first trace
+};
+
+static thread_local idTraceThreadOwner cm_traceThreadOwner;
+
+/*
+================
+CM_GrowVisitHash
+================
+*/
+void CM_GrowVisitHash( cm_traceThread_t* thread )
+{
+	int i, oldSize;
+	cm_visitMark_t* oldHash;
+
+	oldSize = thread->visitHashSize;
+	oldHash = thread->visitHash;
+
+	thread->visitHashSize = ( oldSize > 0 ) ? oldSize * 2 : CM_MIN_VISIT_HASH_SIZE;
+	thread->visitHash = ( cm_visitMark_t* ) Mem_ClearedAlloc( thread->visitHashSize * sizeof( thread->visitHash[0] ), TAG_COLLISION );
+	thread->numVisited = 0;
+
+	// re-insert the primitives visited by the current trace
+	for( i = 0; i < oldSize; i++ )
+	{
+		if( oldHash[i].checkcount == thread->checkCount )
+		{
+			CM_CheckVisited( thread, oldHash[i].primitive );
+		}
+	}
+	Mem_Free( oldHash );
+}
+
+/*
+================
+idCollisionModelManagerLocal::GetTraceThread
+
+  returns the trace state of the calling thread
+================
+*/
+cm_traceThread_t* idCollisionModelManagerLocal::GetTraceThread()
+{
+	cm_traceThread_t* thread;
+	int index;
+
+	thread = cm_traceThreadOwner.thread;
+	if( thread == NULL )
+	{
+		for( index = 0; index < CM_MAX_TRACE_THREADS; index++ )
+		{
+			if( Sys_InterlockedCompareExchange( traceThreads[index].inUse, 0, 1 ) == 0 )
+			{
+				break;
+			}
+		}
+		if( index >= CM_MAX_TRACE_THREADS )
+		{
+			common->FatalError( "idCollisionModelManagerLocal::GetTraceThread: more than %d threads running collision queries at once", CM_MAX_TRACE_THREADS );
+		}
+		thread = &traceThreads[index];
+		cm_traceThreadOwner.thread = thread;
+	}
+	if( !thread->trmModel )
+	{
+		SetupTrmModelStructure( thread );
+	}
+	return thread;
+}
+
+/*
+================
+idCollisionModelManagerLocal::FreeTraceThreads
+
+  the threads keep their state, only the memory is freed
+================
+*/
+void idCollisionModelManagerLocal::FreeTraceThreads()
+{
+	int i;
+	cm_traceThread_t* thread;
+
+	for( i = 0; i < CM_MAX_TRACE_THREADS; i++ )
+	{
+		thread = &traceThreads[i];
+		FreeTrmModelStructure( thread );
+		Mem_Free( thread->vertexMarks );
+		thread->vertexMarks = NULL;
+		thread->maxVertexMarks = 0;
+		Mem_Free( thread->edgeMarks );
+		thread->edgeMarks = NULL;
+		thread->maxEdgeMarks = 0;
+		Mem_Free( thread->visitHash );
+		thread->visitHash = NULL;
+		thread->visitHashSize = 0;
+		thread->numVisited = 0;
+	}
+}
+
+/*
+================
+idCollisionModelManagerLocal::ModelForHandle
+
+  the trace model handle refers to the trm model of the calling thread
+================
+*/
+cm_model_t* idCollisionModelManagerLocal::ModelForHandle( cmHandle_t model )
+{
+	if( model == TRACE_MODEL_HANDLE )
+	{
+		return GetTraceThread()->trmModel;
+	}
+	return models[model];
+}
+
+/*
+================
+idCollisionModelManagerLocal::StartTrace
+
+  sets up the trace work for a new trace through the given model on the calling thread
+================
+*/
+void idCollisionModelManagerLocal::StartTrace( cm_traceWork_t* tw, cm_model_t* model )
+{
+	cm_traceThread_t* thread;
+
+	thread = GetTraceThread();
+
+	// make sure there are marks for all vertices and edges of the model
+	if( thread->maxVertexMarks < model->maxVertices )
+	{
+		Mem_Free( thread->vertexMarks );
+		thread->maxVertexMarks = model->maxVertices;
+		thread->vertexMarks = ( cm_primitiveMark_t* ) Mem_ClearedAlloc( thread->maxVertexMarks * sizeof( thread->vertexMarks[0] ), TAG_COLLISION );
+	}
+	if( thread->maxEdgeMarks < model->maxEdges )
+	{
+		Mem_Free( thread->edgeMarks );
+		thread->maxEdgeMarks = model->maxEdges;
+		thread->edgeMarks = ( cm_primitiveMark_t* ) Mem_ClearedAlloc( thread->maxEdgeMarks * sizeof( thread->edgeMarks[0] ), TAG_COLLISION );
+	}
+
+	// all marks set by previous traces are invalidated
+	thread->checkCount++;
+	thread->numVisited = 0;
+
+	tw->thread = thread;
+	tw->model = model;
+}
+
+/*
+===============================================================================
+
 Trace through the spatial subdivision
 
 ===============================================================================
@@ -202,10 +202,10 @@ ID_INLINE void CM_AddContact( cm_traceWork_t* tw )
 ================
 CM_SetVertexSidedness
 
-  stores for the given model vertex at which side of one of the trm edges it passes
+  stores in the vertex trace mark at which side of one of the trm edges the model vertex passes
 ================
 */
-ID_INLINE void CM_SetVertexSidedness( cm_vertex_t* v, const idPluecker& vpl, const idPluecker& epl, const int bitNum )
+ID_INLINE void CM_SetVertexSidedness( cm_primitiveMark_t* v, const idPluecker& vpl, const idPluecker& epl, const int bitNum )
 {
 	const int mask = 1 << bitNum;
 	if( ( v->sideSet & mask ) == 0 )
@@ -220,10 +220,10 @@ ID_INLINE void CM_SetVertexSidedness( cm_vertex_t* v, const idPluecker& vpl, con
 ================
 CM_SetEdgeSidedness
 
-  stores for the given model edge at which side one of the trm vertices
+  stores in the edge trace mark at which side of the model edge one of the trm vertices passes
 ================
 */
-ID_INLINE void CM_SetEdgeSidedness( cm_edge_t* edge, const idPluecker& vpl, const idPluecker& epl, const int bitNum )
+ID_INLINE void CM_SetEdgeSidedness( cm_primitiveMark_t* edge, const idPluecker& vpl, const idPluecker& epl, const int bitNum )
 {
 	const int mask = 1 << bitNum;
 	if( ( edge->sideSet & mask ) == 0 )
@@ -246,6 +246,7 @@ void idCollisionModelManagerLocal::TranslateTrmEdgeThroughPolygon( cm_traceWork_
 	idVec3 start, end, normal;
 	cm_edge_t* edge;
 	cm_vertex_t* v1, *v2;
+	cm_primitiveMark_t* edgeMark, *v1Mark, *v2Mark;
 	idPluecker* pl, epsPl;
 
 	// check edges for a collision
@@ -253,8 +254,9 @@ void idCollisionModelManagerLocal::TranslateTrmEdgeThroughPolygon( cm_traceWork_
 	{
 		edgeNum = poly->edges[i];
 		edge = tw->model->edges + abs( edgeNum );
+		edgeMark = CM_EdgeMark( tw, edge );
 		// if this edge is already checked
-		if( edge->checkcount == idCollisionModelManagerLocal::checkCount )
+		if( edgeMark->checkcount == tw->thread->checkCount )
 		{
 			continue;
 		}
@@ -265,20 +267,22 @@ void idCollisionModelManagerLocal::TranslateTrmEdgeThroughPolygon( cm_traceWork_
 		}
 		pl = &tw->polygonEdgePlueckerCache[i];
 		// get the sides at which the trm edge vertices pass the polygon edge
-		CM_SetEdgeSidedness( edge, *pl, tw->vertices[trmEdge->vertexNum[0]].pl, trmEdge->vertexNum[0] );
-		CM_SetEdgeSidedness( edge, *pl, tw->vertices[trmEdge->vertexNum[1]].pl, trmEdge->vertexNum[1] );
+		CM_SetEdgeSidedness( edgeMark, *pl, tw->vertices[trmEdge->vertexNum[0]].pl, trmEdge->vertexNum[0] );
+		CM_SetEdgeSidedness( edgeMark, *pl, tw->vertices[trmEdge->vertexNum[1]].pl, trmEdge->vertexNum[1] );
 		// if the trm edge start and end vertex do not pass the polygon edge at different sides
-		if( !( ( ( edge->side >> trmEdge->vertexNum[0] ) ^ ( edge->side >> trmEdge->vertexNum[1] ) ) & 1 ) )
+		if( !( ( ( edgeMark->side >> trmEdge->vertexNum[0] ) ^ ( edgeMark->side >> trmEdge->vertexNum[1] ) ) & 1 ) )
 		{
 			continue;
 		}
 		// get the sides at which the polygon edge vertices pass the trm edge
 		v1 = tw->model->vertices + edge->vertexNum[INT32_SIGNBITSET( edgeNum )];
-		CM_SetVertexSidedness( v1, tw->polygonVertexPlueckerCache[i], trmEdge->pl, trmEdge->bitNum );
+		v1Mark = CM_VertexMark( tw, v1 );
+		CM_SetVertexSidedness( v1Mark, tw->polygonVertexPlueckerCache[i], trmEdge->pl, trmEdge->bitNum );
 		v2 = tw->model->vertices + edge->vertexNum[INT32_SIGNBITNOTSET( edgeNum )];
-		CM_SetVertexSidedness( v2, tw->polygonVertexPlueckerCache[i + 1], trmEdge->pl, trmEdge->bitNum );
+		v2Mark = CM_VertexMark( tw, v2 );
+		CM_SetVertexSidedness( v2Mark, tw->polygonVertexPlueckerCache[i + 1], trmEdge->pl, trmEdge->bitNum );
 		// if the polygon edge start and end vertex do not pass the trm edge at different sides
-		if( !( ( v1->side ^ v2->side ) & ( 1 << trmEdge->bitNum ) ) )
+		if( !( ( v1Mark->side ^ v2Mark->side ) & ( 1 << trmEdge->bitNum ) ) )
 		{
 			continue;
 		}
@@ -389,7 +393,7 @@ void idCollisionModelManagerLocal::TranslateTrmVertexThroughPolygon( cm_traceWor
 {
 	int i, edgeNum;
 	float f;
-	cm_edge_t* edge;
+	cm_primitiveMark_t* edgeMark;
 
 	f = CM_TranslationPlaneFraction( poly->plane, v->p, v->endp );
 	if( f < tw->trace.fraction )
@@ -398,9 +402,9 @@ void idCollisionModelManagerLocal::TranslateTrmVertexThroughPolygon( cm_traceWor
 		for( i = 0; i < poly->numEdges; i++ )
 		{
 			edgeNum = poly->edges[i];
-			edge = tw->model->edges + abs( edgeNum );
-			CM_SetEdgeSidedness( edge, tw->polygonEdgePlueckerCache[i], v->pl, bitNum );
-			if( INT32_SIGNBITSET( edgeNum ) ^ ( ( edge->side >> bitNum ) & 1 ) )
+			edgeMark = CM_EdgeMark( tw, tw->model->edges + abs( edgeNum ) );
+			CM_SetEdgeSidedness( edgeMark, tw->polygonEdgePlueckerCache[i], v->pl, bitNum );
+			if( INT32_SIGNBITSET( edgeNum ) ^ ( ( edgeMark->side >> bitNum ) & 1 ) )
 			{
 				return;
 			}
@@ -439,6 +443,7 @@ void idCollisionModelManagerLocal::TranslatePointThroughPolygon( cm_traceWork_t*
 	int i, edgeNum;
 	float f;
 	cm_edge_t* edge;
+	cm_primitiveMark_t* edgeMark;
 	idPluecker pl;
 
 	f = CM_TranslationPlaneFraction( poly->plane, v->p, v->endp );
@@ -449,18 +454,19 @@ void idCollisionModelManagerLocal::TranslatePointThroughPolygon( cm_traceWork_t*
 		{
 			edgeNum = poly->edges[i];
 			edge = tw->model->edges + abs( edgeNum );
+			edgeMark = CM_EdgeMark( tw, edge );
 			// if we didn't yet calculate the sidedness for this edge
-			if( edge->checkcount != idCollisionModelManagerLocal::checkCount )
+			if( edgeMark->checkcount != tw->thread->checkCount )
 			{
 				float fl;
-				edge->checkcount = idCollisionModelManagerLocal::checkCount;
+				edgeMark->checkcount = tw->thread->checkCount;
 				pl.FromLine( tw->model->vertices[edge->vertexNum[0]].p, tw->model->vertices[edge->vertexNum[1]].p );
 				fl = v->pl.PermutedInnerProduct( pl );
-				edge->side = ( fl < 0.0f );
+				edgeMark->side = ( fl < 0.0f );
 			}
 			// if the point passes the edge at the wrong side
 			//if ( (edgeNum > 0) == edge->side ) {
-			if( INT32_SIGNBITSET( edgeNum ) ^ edge->side )
+			if( INT32_SIGNBITSET( edgeNum ) ^ edgeMark->side )
 			{
 				return;
 			}
@@ -499,18 +505,20 @@ void idCollisionModelManagerLocal::TranslateVertexThroughTrmPolygon( cm_traceWor
 	int i, edgeNum;
 	float f;
 	cm_trmEdge_t* edge;
+	cm_primitiveMark_t* vertexMark;
 
 	f = CM_TranslationPlaneFraction( trmpoly->plane, v->p, endp );
 	if( f < tw->trace.fraction )
 	{
 
+		vertexMark = CM_VertexMark( tw, v );
 		for( i = 0; i < trmpoly->numEdges; i++ )
 		{
 			edgeNum = trmpoly->edges[i];
 			edge = tw->edges + abs( edgeNum );
 
-			CM_SetVertexSidedness( v, pl, edge->pl, edge->bitNum );
-			if( INT32_SIGNBITSET( edgeNum ) ^ ( ( v->side >> edge->bitNum ) & 1 ) )
+			CM_SetVertexSidedness( vertexMark, pl, edge->pl, edge->bitNum );
+			if( INT32_SIGNBITSET( edgeNum ) ^ ( ( vertexMark->side >> edge->bitNum ) & 1 ) )
 			{
 				return;
 			}
@@ -555,13 +563,13 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon( cm_traceWork_t* t
 	cm_trmPolygon_t* bp;
 	cm_vertex_t* v;
 	cm_edge_t* e;
+	cm_primitiveMark_t* vMark, *eMark;
 
 	// if already checked this polygon
-	if( p->checkcount == idCollisionModelManagerLocal::checkCount )
+	if( CM_CheckVisited( tw->thread, p ) )
 	{
 		return false;
 	}
-	p->checkcount = idCollisionModelManagerLocal::checkCount;
 
 	// if this polygon does not have the right contents behind it
 	if( !( p->contents & tw->contents ) )
@@ -624,20 +632,22 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon( cm_traceWork_t* t
 		{
 			edgeNum = p->edges[i];
 			e = tw->model->edges + abs( edgeNum );
+			eMark = CM_EdgeMark( tw, e );
 			// reset sidedness cache if this is the first time we encounter this edge during this trace
-			if( e->checkcount != idCollisionModelManagerLocal::checkCount )
+			if( eMark->checkcount != tw->thread->checkCount )
 			{
-				e->sideSet = 0;
+				eMark->sideSet = 0;
 			}
 			// pluecker coordinate for edge
 			tw->polygonEdgePlueckerCache[i].FromLine( tw->model->vertices[e->vertexNum[0]].p,
 					tw->model->vertices[e->vertexNum[1]].p );
 
 			v = &tw->model->vertices[e->vertexNum[INT32_SIGNBITSET( edgeNum )]];
+			vMark = CM_VertexMark( tw, v );
 			// reset sidedness cache if this is the first time we encounter this vertex during this trace
-			if( v->checkcount != idCollisionModelManagerLocal::checkCount )
+			if( vMark->checkcount != tw->thread->checkCount )
 			{
-				v->sideSet = 0;
+				vMark->sideSet = 0;
 			}
 			// pluecker coordinate for vertex movement vector
 			tw->polygonVertexPlueckerCache[i].FromRay( v->p, -tw->dir );
@@ -670,13 +680,14 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon( cm_traceWork_t* t
 		{
 			edgeNum = p->edges[i];
 			e = tw->model->edges + abs( edgeNum );
+			eMark = CM_EdgeMark( tw, e );
 
-			if( e->checkcount == idCollisionModelManagerLocal::checkCount )
+			if( eMark->checkcount == tw->thread->checkCount )
 			{
 				continue;
 			}
 			// set edge check count
-			e->checkcount = idCollisionModelManagerLocal::checkCount;
+			eMark->checkcount = tw->thread->checkCount;
 			// can never collide with internal edges
 			if( e->internal )
 			{
@@ -687,13 +698,14 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon( cm_traceWork_t* t
 			{
 
 				v = tw->model->vertices + e->vertexNum[k ^ INT32_SIGNBITSET( edgeNum )];
+				vMark = CM_VertexMark( tw, v );
 				// if this vertex is already checked
-				if( v->checkcount == idCollisionModelManagerLocal::checkCount )
+				if( vMark->checkcount == tw->thread->checkCount )
 				{
 					continue;
 				}
 				// set vertex check count
-				v->checkcount = idCollisionModelManagerLocal::checkCount;
+				vMark->checkcount = tw->thread->checkCount;
 
 				// if the vertex is outside the trace bounds
 				if( !tw->bounds.ContainsPoint( v->p ) )
@@ -814,6 +826,23 @@ void idCollisionModelManagerLocal::Translation( trace_t* results, const idVec3&
 		const idTraceModel* trm, const idMat3& trmAxis, int contentMask,
 		cmHandle_t model, const idVec3& modelOrigin, const idMat3& modelAxis )
 {
+	int numContacts;
+
+	idCollisionModelManagerLocal::Translation( results, start, end, trm, trmAxis, contentMask, model, modelOrigin, modelAxis, NULL, 0, numContacts );
+}
+
+/*
+================
+idCollisionModelManagerLocal::Translation
+
+  stores all collisions in the contacts array instead of only the first one when contacts is not NULL
+================
+*/
+void idCollisionModelManagerLocal::Translation( trace_t* results, const idVec3& start, const idVec3& end,
+		const idTraceModel* trm, const idMat3& trmAxis, int contentMask,
+		cmHandle_t model, const idVec3& modelOrigin, const idMat3& modelAxis,
+		contactInfo_t* contacts, const int maxContacts, int& numContacts )
+{
 
 	int i, j;
 	float dist;
@@ -823,20 +852,21 @@ void idCollisionModelManagerLocal::Translation( trace_t* results, const idVec3&
 	cm_trmPolygon_t* poly;
 	cm_trmEdge_t* edge;
 	cm_trmVertex_t* vert;
-	ALIGN16( static cm_traceWork_t tw );
+	ALIGN16( cm_traceWork_t tw );
 
 	assert( ( ( byte* )&start ) < ( ( byte* )results ) || ( ( byte* )&start ) >= ( ( ( byte* )results ) + sizeof( trace_t ) ) );
 	assert( ( ( byte* )&end ) < ( ( byte* )results ) || ( ( byte* )&end ) >= ( ( ( byte* )results ) + sizeof( trace_t ) ) );
 	assert( ( ( byte* )&trmAxis ) < ( ( byte* )results ) || ( ( byte* )&trmAxis ) >= ( ( ( byte* )results ) + sizeof( trace_t ) ) );
 
 	memset( results, 0, sizeof( *results ) );
+	numContacts = 0;
 
 	if( model < 0 || model > MAX_SUBMODELS || model > idCollisionModelManagerLocal::maxModels )
 	{
 		common->Printf( "idCollisionModelManagerLocal::Translation: invalid model handle\n" );
 		return;
 	}
-	if( !idCollisionModelManagerLocal::models[model] )
+	if( !idCollisionModelManagerLocal::ModelForHandle( model ) )
 	{
 		common->Printf( "idCollisionModelManagerLocal::Translation: invalid model\n" );
 		return;
@@ -854,7 +884,7 @@ void idCollisionModelManagerLocal::Translation( trace_t* results, const idVec3&
 	// test whether or not stuck to begin with
 	if( cm_debugCollision.GetBool() )
 	{
-		if( !entered && !idCollisionModelManagerLocal::getContacts )
+		if( !entered && !contacts )
 		{
 			entered = 1;
 			// if already messed up to begin with
@@ -867,7 +897,7 @@ void idCollisionModelManagerLocal::Translation( trace_t* results, const idVec3&
 	}
 #endif
 
-	idCollisionModelManagerLocal::checkCount++;
+	idCollisionModelManagerLocal::StartTrace( &tw, idCollisionModelManagerLocal::ModelForHandle( model ) );
 
 	tw.trace.fraction = 1.0f;
 	tw.trace.c.contents = 0;
@@ -879,11 +909,10 @@ void idCollisionModelManagerLocal::Translation( trace_t* results, const idVec3&
 	tw.rotation = false;
 	tw.positionTest = false;
 	tw.quickExit = false;
-	tw.getContacts = idCollisionModelManagerLocal::getContacts;
-	tw.contacts = idCollisionModelManagerLocal::contacts;
-	tw.maxContacts = idCollisionModelManagerLocal::maxContacts;
+	tw.getContacts = ( contacts != NULL );
+	tw.contacts = contacts;
+	tw.maxContacts = maxContacts;
 	tw.numContacts = 0;
-	tw.model = idCollisionModelManagerLocal::models[model];
 	tw.start = start - modelOrigin;
 	tw.end = end - modelOrigin;
 	tw.dir = end - start;
@@ -954,7 +983,7 @@ void idCollisionModelManagerLocal::Translation( trace_t* results, const idVec3&
 			results->c.point += modelOrigin;
 			results->c.dist += modelOrigin * results->c.normal;
 		}
-		idCollisionModelManagerLocal::numContacts = tw.numContacts;
+		numContacts = tw.numContacts;
 		return;
 	}
 
@@ -1185,7 +1214,7 @@ void idCollisionModelManagerLocal::Translation( trace_t* results, const idVec3&
 				tw.contacts[i].dist += modelOrigin * tw.contacts[i].normal;
 			}
 		}
-		idCollisionModelManagerLocal::numContacts = tw.numContacts;
+		numContacts = tw.numContacts;
 	}
 	else
 	{
@@ -1216,7 +1245,7 @@ void idCollisionModelManagerLocal::Translation( trace_t* results, const idVec3&
 	// test for missed collisions
 	if( cm_debugCollision.GetBool() )
 	{
-		if( !entered && !idCollisionModelManagerLocal::getContacts )
+		if( !entered && !contacts )
 		{
 			entered = 1;
 			// if the trm is stuck in the model
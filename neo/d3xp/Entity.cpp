@@ -1167,6 +1167,11 @@ idEntity::BecomeActive
 */
 void idEntity::BecomeActive( int flags )
 {
+	if( gameLocal.DeferThinkOp( THINKOP_BECOME_ACTIVE, this, flags ) )
+	{
+		return;
+	}
+
 	if( ( flags & TH_PHYSICS ) )
 	{
 		// enable the team master if this entity is part of a physics team
@@ -1207,6 +1212,11 @@ idEntity::BecomeInactive
 */
 void idEntity::BecomeInactive( int flags )
 {
+	if( gameLocal.DeferThinkOp( THINKOP_BECOME_INACTIVE, this, flags ) )
+	{
+		return;
+	}
+
 	if( ( flags & TH_PHYSICS ) )
 	{
 		// may only disable physics on a team master if no team members are running physics or bound to a joints
@@ -1249,6 +1259,45 @@ void idEntity::BecomeInactive( int flags )
 	}
 }
 
+/*
+================
+idEntity::IsThinkIsolated
+================
+*/
+bool idEntity::IsThinkIsolated() const
+{
+	return false;
+}
+
+/*
+================
+idEntity::ApplyDeferredThinkOp
+
+  Applies a shared state write recorded while the entity was thinking on the job system.
+================
+*/
+void idEntity::ApplyDeferredThinkOp( thinkOp_t op, int parm )
+{
+	switch( op )
+	{
+		case THINKOP_BECOME_ACTIVE:
+			BecomeActive( parm );
+			break;
+		case THINKOP_BECOME_INACTIVE:
+			BecomeInactive( parm );
+			break;
+		case THINKOP_UPDATE_VISUALS:
+			UpdateVisuals();
+			break;
+		case THINKOP_PRESENT:
+			Present();
+			break;
+		default:
+			gameLocal.Error( "idEntity::ApplyDeferredThinkOp: unhandled op %d on '%s'", op, name.c_str() );
+			break;
+	}
+}
+
 /***********************************************************************
 
 	Visuals
@@ -1535,6 +1584,11 @@ idEntity::UpdateVisuals
 */
 void idEntity::UpdateVisuals()
 {
+	if( gameLocal.DeferThinkOp( THINKOP_UPDATE_VISUALS, this ) )
+	{
+		return;
+	}
+
 	UpdateModel();
 	UpdateSound();
 }
@@ -1732,6 +1786,10 @@ Present is called to allow entities to generate refEntities, lights, etc for the
 */
 void idEntity::Present()
 {
+	if( gameLocal.DeferThinkOp( THINKOP_PRESENT, this ) )
+	{
+		return;
+	}
 
 	if( !gameLocal.isNewFrame )
 	{
@@ -1809,6 +1867,11 @@ bool idEntity::UpdateRenderEntity( renderEntity_t* renderEntity, const renderVie
 		{
 			currentTime = gameLocal.GetTimeGroupTime( renderEntity->timeGroup );
 		}
+		if( animator->ConsumeFrameAhead( currentTime ) )
+		{
+			// already created by the game's animation update
+			return true;
+		}
 		return animator->CreateFrame( currentTime, false );
 	}
 
@@ -223,6 +223,7 @@ public:
 		bool				networkSync			: 1; // if true the entity is synchronized over the network
 		bool				grabbed				: 1;	// if true object is currently being grabbed
 		bool				skipReplication		: 1; // don't replicate this entity over the network.
+		bool				thinkDeferred		: 1;	// if true the entity already ran its think on the job system this frame
 	} fl;
 
 	int						timeGroup;
@@ -270,6 +271,10 @@ public:
 	bool					IsActive() const;
 	void					BecomeActive( int flags );
 	void					BecomeInactive( int flags );
+	// true if Think only reads and writes this entity, so that it can run on the job system
+	// with its shared state writes deferred through gameLocal.DeferThinkOp
+	virtual bool			IsThinkIsolated() const;
+	virtual void			ApplyDeferredThinkOp( thinkOp_t op, int parm );
 	void					UpdatePVSAreas( const idVec3& pos );
 	void					BecomeReplicated();
 
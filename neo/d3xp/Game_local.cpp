@@ -58,6 +58,11 @@ idSoundWorld* 				gameSoundWorld = NULL;		// all audio goes to this world
 
 static gameExport_t			gameExport;
 
+#define PARALLEL_THINK_BATCH		16			// minimum number of entity thinks per job
+#define PARALLEL_THINK_MAX_JOBS		256
+#define PARALLEL_ANIM_BATCH			4			// minimum number of animator frames per job
+#define PARALLEL_ANIM_MAX_JOBS		256
+
 // global animation lib
 idAnimManager				animationLib;
 
@@ -222,6 +227,11 @@ void idGameLocal::Clear()
 	numEntitiesToDeactivate = 0;
 	sortPushers = false;
 	sortTeamMasters = false;
+	deferredThinks.Clear();
+	thinkJobList = NULL;
+	deferringThinks = false;
+	animatorUpdates.Clear();
+	animJobList = NULL;
 	persistentLevelInfo.Clear();
 	memset( globalShaderParms, 0, sizeof( globalShaderParms ) );
 	random.SetSeed( 0 );
@@ -338,6 +348,9 @@ void idGameLocal::Init()
 	idEvent::Init();
 	idClass::Init();
 
+	thinkJobList = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_MEDIUM, PARALLEL_THINK_MAX_JOBS, 0, NULL );
+	animJobList = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_MEDIUM, PARALLEL_ANIM_MAX_JOBS, 0, NULL );
+
 	InitConsoleCommands();
 
 	shellHandler = new( TAG_SWF ) idMenuHandler_Shell();
@@ -436,6 +449,17 @@ void idGameLocal::Shutdown()
 
 	ShutdownConsoleCommands();
 
+	if( thinkJobList != NULL )
+	{
+		parallelJobManager->FreeJobList( thinkJobList );
+		thinkJobList = NULL;
+	}
+	if( animJobList != NULL )
+	{
+		parallelJobManager->FreeJobList( animJobList );
+		animJobList = NULL;
+	}
+
 	// free memory allocated by class objects
 	Clear();
 
@@ -1252,6 +1276,12 @@ void idGameLocal::MapPopulate()
 	Printf( "==== Processing events ====\n" );
 	idEvent::ServiceEvents();
 
+	// doors and other entities have set up the area state the map starts with
+	for( int i = 0; i < aasList.Num(); i++ )
+	{
+		aasList[ i ]->PrecomputeRouting();
+	}
+
 	// Must set GAME_FPS for script after populating, because some maps run their own scripts
 	// when spawning the world, and GAME_FPS will not be found before then.
 	SetScriptFPS( com_engineHz_latched );
@@ -2623,6 +2653,244 @@ void idGameLocal::RunSharedThink()
 }
 // jmarshall end
 
+static ID_TLS deferredThinkContext;		// deferredThink_t of the entity thinking on this job thread, 0 on any other thread
+
+typedef struct
+{
+	deferredThink_t* 	thinks;
+	int					numThinks;
+} parallelThinkJob_t;
+
+/*
+================
+Game_ParallelThinkJob
+================
+*/
+static void Game_ParallelThinkJob( parallelThinkJob_t* job )
+{
+	for( int i = 0; i < job->numThinks; i++ )
+	{
+		deferredThinkContext = ( ptrdiff_t )&job->thinks[i];
+		job->thinks[i].ent->Think();
+	}
+	deferredThinkContext = 0;
+}
+
+REGISTER_PARALLEL_JOB( Game_ParallelThinkJob, "Game_ParallelThinkJob" );
+
+/*
+================
+idGameLocal::IsDeferringThink
+================
+*/
+bool idGameLocal::IsDeferringThink() const
+{
+	return deferringThinks && deferredThinkContext != 0;
+}
+
+/*
+================
+idGameLocal::DeferThinkOp
+
+  Returns false when not called from a parallel think, in which case the caller applies the change itself.
+================
+*/
+bool idGameLocal::DeferThinkOp( thinkOp_t op, idClass* obj, int parm, idEvent* event, const idEventDef* eventDef )
+{
+	if( !deferringThinks )
+	{
+		return false;
+	}
+
+	deferredThink_t* think = reinterpret_cast< deferredThink_t* >( ( ptrdiff_t )deferredThinkContext );
+	if( think == NULL )
+	{
+		return false;
+	}
+
+	deferredThinkOp_t& deferred = think->ops.Alloc();
+	deferred.op = op;
+	deferred.obj = obj;
+	deferred.parm = parm;
+	deferred.event = event;
+	deferred.eventDef = eventDef;
+	return true;
+}
+
+/*
+================
+idGameLocal::ApplyDeferredThink
+================
+*/
+void idGameLocal::ApplyDeferredThink( deferredThink_t& think )
+{
+	for( int i = 0; i < think.ops.Num(); i++ )
+	{
+		const deferredThinkOp_t& deferred = think.ops[i];
+		switch( deferred.op )
+		{
+			case THINKOP_SCHEDULE_EVENT:
+				deferred.event->Schedule( deferred.obj, deferred.obj->GetType(), deferred.parm );
+				break;
+			case THINKOP_CANCEL_EVENTS:
+				deferred.obj->CancelEvents( deferred.eventDef );
+				break;
+			default:
+				static_cast< idEntity* >( deferred.obj )->ApplyDeferredThinkOp( deferred.op, deferred.parm );
+				break;
+		}
+	}
+	think.ops.SetNum( 0 );
+}
+
+/*
+================
+idGameLocal::RunParallelThink
+
+  Runs the think of every think-isolated entity on the job system before the serial think loop.
+  Their writes to shared state are recorded and applied afterwards in active entity order, so
+  these entities behave as if they thought first, the same way pushers are sorted to the front.
+================
+*/
+void idGameLocal::RunParallelThink()
+{
+	idEntity* ent;
+	int num = 0;
+
+	for( ent = activeEntities.Next(); ent != NULL; ent = ent->activeNode.Next() )
+	{
+		if( ent->timeGroup != TIME_GROUP1 || ent->entityNumber < MAX_PLAYERS )
+		{
+			continue;
+		}
+		if( ( ent->thinkFlags & TH_PHYSICS ) || ent->GetTeamMaster() != NULL || !ent->IsThinkIsolated() )
+		{
+			continue;
+		}
+		if( num >= deferredThinks.Num() )
+		{
+			deferredThinks.Alloc();
+		}
+		deferredThinks[num].ent = ent;
+		deferredThinks[num].ops.SetNum( 0 );
+		num++;
+	}
+
+	if( num < g_parallelThinkMinEntities.GetInteger() || thinkJobList == NULL )
+	{
+		return;
+	}
+
+	idStaticList< parallelThinkJob_t, PARALLEL_THINK_MAX_JOBS > jobs;
+	const int thinksPerJob = Max( PARALLEL_THINK_BATCH, ( num + PARALLEL_THINK_MAX_JOBS - 1 ) / PARALLEL_THINK_MAX_JOBS );
+	for( int i = 0; i < num; i += thinksPerJob )
+	{
+		parallelThinkJob_t* job = jobs.Alloc();
+		job->thinks = &deferredThinks[i];
+		job->numThinks = Min( thinksPerJob, num - i );
+		thinkJobList->AddJob( ( jobRun_t )Game_ParallelThinkJob, job );
+	}
+
+	deferringThinks = true;
+	thinkJobList->Submit( NULL, JOBLIST_PARALLELISM_MAX_CORES );
+	thinkJobList->Wait();
+	deferringThinks = false;
+
+	for( int i = 0; i < num; i++ )
+	{
+		deferredThinks[i].ent->fl.thinkDeferred = true;
+		ApplyDeferredThink( deferredThinks[i] );
+	}
+}
+
+typedef struct
+{
+	animatorUpdate_t* 	updates;
+	int					numUpdates;
+} parallelAnimJob_t;
+
+/*
+================
+Game_ParallelAnimJob
+================
+*/
+static void Game_ParallelAnimJob( parallelAnimJob_t* job )
+{
+	for( int i = 0; i < job->numUpdates; i++ )
+	{
+		job->updates[i].animator->CreateFrameAhead( job->updates[i].time );
+	}
+}
+
+REGISTER_PARALLEL_JOB( Game_ParallelAnimJob, "Game_ParallelAnimJob" );
+
+/*
+================
+idGameLocal::RunAnimationUpdate
+
+  Creates the joint frames of all visible animating entities on the job system once the game
+  state for the frame is final, instead of one at a time from the render callbacks.
+================
+*/
+void idGameLocal::RunAnimationUpdate()
+{
+	if( animJobList == NULL || ( inCinematic && skipCinematic ) || g_debugAnim.GetInteger() != -1 )
+	{
+		return;
+	}
+
+	animatorUpdates.SetNum( 0 );
+	for( idEntity* ent = activeEntities.Next(); ent != NULL; ent = ent->activeNode.Next() )
+	{
+		if( ent->IsHidden() || ent->GetModelDefHandle() == -1 )
+		{
+			continue;
+		}
+
+		const renderEntity_t* renderEntity = ent->GetRenderEntity();
+		if( renderEntity->callback != idEntity::ModelCallback )
+		{
+			continue;
+		}
+
+		idAnimator* animator = ent->GetAnimator();
+		if( animator == NULL )
+		{
+			continue;
+		}
+
+		// same time the render callback would use
+		const int currentTime = GetTimeGroupTime( renderEntity->timeGroup );
+		if( !animator->NeedsFrame( currentTime ) || !InPlayerPVS( ent ) )
+		{
+			continue;
+		}
+
+		animatorUpdate_t& update = animatorUpdates.Alloc();
+		update.animator = animator;
+		update.time = currentTime;
+	}
+
+	const int num = animatorUpdates.Num();
+	if( num < 2 )
+	{
+		return;
+	}
+
+	idStaticList< parallelAnimJob_t, PARALLEL_ANIM_MAX_JOBS > jobs;
+	const int updatesPerJob = Max( PARALLEL_ANIM_BATCH, ( num + PARALLEL_ANIM_MAX_JOBS - 1 ) / PARALLEL_ANIM_MAX_JOBS );
+	for( int i = 0; i < num; i += updatesPerJob )
+	{
+		parallelAnimJob_t* job = jobs.Alloc();
+		job->updates = &animatorUpdates[i];
+		job->numUpdates = Min( updatesPerJob, num - i );
+		animJobList->AddJob( ( jobRun_t )Game_ParallelAnimJob, job );
+	}
+
+	animJobList->Submit( NULL, JOBLIST_PARALLELISM_MAX_CORES );
+	animJobList->Wait();
+}
+
 /*
 ================
 idGameLocal::RunFrame
@@ -2785,6 +3053,11 @@ void idGameLocal::RunFrame( idUserCmdMgr& cmdMgr, gameReturn_t& ret )
 				}
 				else
 				{
+					if( g_parallelThink.GetBool() )
+					{
+						RunParallelThink();
+					}
+
 					num = 0;
 					for( ent = activeEntities.Next(); ent != NULL; ent = ent->activeNode.Next() )
 					{
@@ -2792,6 +3065,13 @@ void idGameLocal::RunFrame( idUserCmdMgr& cmdMgr, gameReturn_t& ret )
 						{
 							continue;
 						}
+						if( ent->fl.thinkDeferred )
+						{
+							// already thought on the job system
+							ent->fl.thinkDeferred = false;
+							num++;
+							continue;
+						}
 						RunEntityThink( *ent, cmdMgr );
 						num++;
 					}
@@ -2835,15 +3115,21 @@ void idGameLocal::RunFrame( idUserCmdMgr& cmdMgr, gameReturn_t& ret )
 			timer_events.Start();
 
 			// service any pending events
-			idEvent::ServiceEvents();
+			const int numEvents = idEvent::ServiceEvents();
 
 			// service pending fast events
 			SelectTimeGroup( true );
-			idEvent::ServiceFastEvents();
+			const int numFastEvents = idEvent::ServiceFastEvents();
 			SelectTimeGroup( false );
 
 			timer_events.Stop();
 
+			// create the animation frames of visible entities before the renderer asks for them
+			if( g_parallelAnimation.GetBool() )
+			{
+				RunAnimationUpdate();
+			}
+
 			// free the player pvs
 			FreePlayerPVS();
 
@@ -2861,6 +3147,14 @@ void idGameLocal::RunFrame( idUserCmdMgr& cmdMgr, gameReturn_t& ret )
 						timer_think.Milliseconds(), timer_events.Milliseconds(), num );
 			}
 
+			// display how many events were serviced
+			if( g_eventStats.GetBool() )
+			{
+				Printf( "game %d: %d events, %d fast events in %.2f ms, %d queued, %d allocated\n",
+						time, numEvents, numFastEvents, timer_events.Milliseconds(),
+						idEvent::NumQueuedEvents(), idEvent::NumAllocatedEvents() );
+			}
+
 			BuildReturnValue( ret );
 
 			// see if a target_sessionCommand has forced a changelevel
@@ -287,6 +287,42 @@ enum slowmoState_t
 	SLOWMO_STATE_RAMPDOWN
 };
 
+// shared state writes made by think-isolated entities while they think on the job system,
+// recorded per entity and replayed on the main thread in active entity order
+enum thinkOp_t
+{
+	THINKOP_BECOME_ACTIVE,
+	THINKOP_BECOME_INACTIVE,
+	THINKOP_UPDATE_VISUALS,
+	THINKOP_PRESENT,
+	THINKOP_PRESENT_LIGHT_DEF,
+	THINKOP_PRESENT_MODEL_DEF,
+	THINKOP_SCHEDULE_EVENT,
+	THINKOP_CANCEL_EVENTS
+};
+
+struct deferredThinkOp_t
+{
+	thinkOp_t				op;
+	idClass* 				obj;
+	int						parm;			// think flags or event time
+	idEvent* 				event;
+	const idEventDef* 		eventDef;
+};
+
+struct deferredThink_t
+{
+	idEntity* 				ent;
+	idList<deferredThinkOp_t> ops;
+};
+
+// an animator that gets its frame created on the job system ahead of the render callbacks
+struct animatorUpdate_t
+{
+	idAnimator* 			animator;
+	int						time;
+};
+
 //============================================================================
 
 class idGameLocal : public idGame
@@ -410,6 +446,9 @@ public:
 	void					RunAllUserCmdsForPlayer( idUserCmdMgr& cmdMgr, const int playerNumber );
 	void					RunSingleUserCmd( usercmd_t& cmd, idPlayer& player );
 	void					RunEntityThink( idEntity& ent, idUserCmdMgr& userCmdMgr );
+	// records a shared state write when called from a think running on the job system
+	bool					DeferThinkOp( thinkOp_t op, idClass* obj, int parm = 0, idEvent* event = NULL, const idEventDef* eventDef = NULL );
+	bool					IsDeferringThink() const;
 	virtual bool			Draw( int clientNum );
 	virtual bool			HandlePlayerGuiEvent( const sysEvent_t* ev );
 	virtual void			ServerWriteSnapshot( idSnapShot& ss );
@@ -662,6 +701,13 @@ private:
 	idEventQueue			eventQueue;
 	idEventQueue			savedEventQueue;
 
+	idList<deferredThink_t>	deferredThinks;			// think-isolated entities running on the job system this frame
+	idParallelJobList* 		thinkJobList;
+	bool					deferringThinks;		// true while the parallel think jobs are running
+
+	idList<animatorUpdate_t> animatorUpdates;
+	idParallelJobList* 		animJobList;
+
 	idStaticList<spawnSpot_t, MAX_GENTITIES> spawnSpots;
 	idStaticList<idEntity*, MAX_GENTITIES> initialSpots;
 	int						currentInitialSpot;
@@ -715,6 +761,9 @@ private:
 	void					RunDebugInfo();
 
 	void					RunSharedThink();
+	void					RunParallelThink();
+	void					ApplyDeferredThink( deferredThink_t& think );
+	void					RunAnimationUpdate();
 
 	void					InitScriptForMap();
 	void					SetScriptFPS( const float com_engineHz );
@@ -937,6 +986,7 @@ const int	CINEMATIC_SKIP_DELAY	= SEC2MS( 2.0f );
 
 #include "script/Script_Compiler.h"
 #include "script/Script_Interpreter.h"
+#include "script/Script_Profiler.h"
 #include "script/Script_Thread.h"
 
 #endif	/* !__GAME_LOCAL_H__ */
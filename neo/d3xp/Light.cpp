@@ -898,6 +898,11 @@ idLight::PresentLightDefChange
 */
 void idLight::PresentLightDefChange()
 {
+	if( gameLocal.DeferThinkOp( THINKOP_PRESENT_LIGHT_DEF, this ) )
+	{
+		return;
+	}
+
 	// let the renderer apply it to the world
 	if( ( lightDefHandle != -1 ) )
 	{
@@ -916,6 +921,11 @@ idLight::PresentModelDefChange
 */
 void idLight::PresentModelDefChange()
 {
+	if( gameLocal.DeferThinkOp( THINKOP_PRESENT_MODEL_DEF, this ) )
+	{
+		return;
+	}
+
 	if( modelTarget )
 	{
 		modelTarget->BecomeActive( TH_UPDATEVISUALS );
@@ -947,6 +957,11 @@ idLight::Present
 */
 void idLight::Present()
 {
+	if( gameLocal.DeferThinkOp( THINKOP_PRESENT, this ) )
+	{
+		return;
+	}
+
 	// don't present to the renderer if the entity hasn't changed
 	if( !( thinkFlags & TH_UPDATEVISUALS ) )
 	{
@@ -1026,6 +1041,39 @@ void idLight::Think()
 	Present();
 }
 
+/*
+================
+idLight::IsThinkIsolated
+
+  A light that drives the shader parms of a model target writes to another entity while fading.
+================
+*/
+bool idLight::IsThinkIsolated() const
+{
+	return ( modelTarget.GetEntity() == NULL );
+}
+
+/*
+================
+idLight::ApplyDeferredThinkOp
+================
+*/
+void idLight::ApplyDeferredThinkOp( thinkOp_t op, int parm )
+{
+	switch( op )
+	{
+		case THINKOP_PRESENT_LIGHT_DEF:
+			PresentLightDefChange();
+			break;
+		case THINKOP_PRESENT_MODEL_DEF:
+			PresentModelDefChange();
+			break;
+		default:
+			idEntity::ApplyDeferredThinkOp( op, parm );
+			break;
+	}
+}
+
 /*
 ================
 idLight::SharedThink
@@ -91,6 +91,8 @@ public:
 	virtual void	UpdateChangeableSpawnArgs( const idDict* source );
 	virtual void	Think();
 	virtual void	ClientThink( const int curTime, const float fraction, const bool predict );
+	virtual bool	IsThinkIsolated() const;
+	virtual void	ApplyDeferredThinkOp( thinkOp_t op, int parm );
 	virtual void	FreeLightDef();
 	virtual bool	GetPhysicsToSoundTransform( idVec3& origin, idMat3& axis );
 	void			Present();
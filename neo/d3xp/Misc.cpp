@@ -1803,6 +1803,18 @@ void idStaticEntity::Think()
 	}
 }
 
+/*
+================
+idStaticEntity::IsThinkIsolated
+
+  Running the gui reads the local player.
+================
+*/
+bool idStaticEntity::IsThinkIsolated() const
+{
+	return !runGui;
+}
+
 /*
 ================
 idStaticEntity::Fade
@@ -2068,6 +2080,18 @@ void idFuncShootProjectile::Spawn()
 {
 }
 
+/*
+===============
+idFuncShootProjectile::IsThinkIsolated
+
+  Spawns and launches projectiles.
+===============
+*/
+bool idFuncShootProjectile::IsThinkIsolated() const
+{
+	return false;
+}
+
 /*
 ===============
 idFuncShootProjectile::Think
@@ -333,6 +333,7 @@ public:
 	virtual void		Show();
 	void				Fade( const idVec4& to, float fadeTime );
 	virtual void		Think();
+	virtual bool		IsThinkIsolated() const;
 
 	virtual void		WriteToSnapshot( idBitMsg& msg ) const;
 	virtual void		ReadFromSnapshot( const idBitMsg& msg );
@@ -402,6 +403,7 @@ public:
 	void						Event_Activate( idEntity* activator );
 
 	virtual void				Think();
+	virtual bool				IsThinkIsolated() const;
 
 	virtual void				WriteToSnapshot( idBitMsg& msg ) const;
 	virtual void				ReadFromSnapshot( const idBitMsg& msg );
@@ -86,6 +86,8 @@ public:
 	virtual bool				Init( const idStr& mapName, unsigned int mapFileCRC ) = 0;
 	// Print AAS stats.
 	virtual void				Stats() const = 0;
+	// Load the portal routing cache for the current area state from its generated file, or build and write it.
+	virtual void				PrecomputeRouting() = 0;
 	// Test from the given origin.
 	virtual void				Test( const idVec3& origin ) = 0;
 	// Get the AAS settings.
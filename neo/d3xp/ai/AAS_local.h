@@ -53,6 +53,7 @@ private:
 	idRoutingCache* 			prev;					// previous in list
 	idRoutingCache* 			time_next;				// next in time based list
 	idRoutingCache* 			time_prev;				// previous in time based list
+	bool						pinned;					// precomputed cache that is never evicted
 	unsigned short				startTravelTime;		// travel time to start with
 	unsigned char* 				reachabilities;			// reachabilities used for routing
 	unsigned short* 			travelTimes;			// travel time for every area
@@ -75,6 +76,23 @@ private:
 };
 
 
+// origin independent result of a route query, the travel time from the origin
+// to the start of the first reachability is added when the query is answered
+typedef struct aasRouteMemo_s
+{
+	int							areaNum;
+	int							goalAreaNum;
+	int							travelFlags;
+	int							generation;				// valid while equal to the routing generation
+	bool						routed;					// false if the area is not a reachable area of its cluster
+	bool						fromPortal;				// the area itself is a cluster portal
+	unsigned short				areaTime;				// travel time from the first reachability within the cluster of the goal
+	unsigned short				portalTime;				// travel time through the best portal of the area cluster
+	idReachability* 			areaReach;
+	idReachability* 			portalReach;
+} aasRouteMemo_t;
+
+
 class idRoutingObstacle
 {
 	friend class idAASLocal;
@@ -86,14 +104,19 @@ private:
 };
 
 
+struct aasRoutingJob_t;
+
 class idAASLocal : public idAAS
 {
+	friend void					AAS_PrecomputeRoutingJob( aasRoutingJob_t* job );
+
 public:
 	idAASLocal();
 	virtual						~idAASLocal();
 	virtual bool				Init( const idStr& mapName, unsigned int mapFileCRC );
 	virtual void				Shutdown();
 	virtual void				Stats() const;
+	virtual void				PrecomputeRouting();
 	virtual void				Test( const idVec3& origin );
 	virtual const idAASSettings* GetSettings() const;
 	virtual int					PointAreaNum( const idVec3& origin ) const;
@@ -142,6 +165,30 @@ private:	// routing data
 	mutable int					totalCacheMemory;		// total cache memory used
 	idList<idRoutingObstacle*, TAG_AAS>	obstacleList;			// list with obstacles
 
+	mutable int					numAreaCacheLookups;	// routing cache statistics since the routing was set up
+	mutable int					numAreaCacheHits;
+	mutable int					numPortalCacheLookups;
+	mutable int					numPortalCacheHits;
+	mutable idTimer				areaCacheUpdateTime;	// time spent building area cache on demand
+	mutable idTimer				portalCacheUpdateTime;	// time spent building portal cache on demand, includes the area cache it needs
+	double						precomputeTime;			// milliseconds spent precomputing or loading the routing cache
+	bool						precomputeLoaded;		// true if the precomputed cache came from the generated file
+	idList<int>					precomputeTravelFlags;	// travel flags the cache was precomputed for
+	unsigned int				precomputeChecksum;		// area state the cache was precomputed with
+	int							numObstacleReach;		// reachabilities disabled by obstacles, the precomputed cache ignores obstacles
+	idList<idRoutingCache*, TAG_AAS>	suspendedCache;		// pinned cache set aside while the area state differs from the precomputed one
+
+	aasRouteMemo_t* 			routeMemo;				// hashed results of recent route queries
+	int							routeGeneration;		// incremented whenever the area state changes
+	mutable int					numRouteQueries;		// route query statistics since the routing was set up
+	mutable int					numRouteMemoHits;
+	mutable idTimer				routeQueryTime;
+	mutable int					routeStatsFrame;		// game frame the per frame counters are for
+	mutable int					numFrameRouteQueries;
+	mutable int					numFrameRouteMemoHits;
+	mutable int					lastFrameRouteQueries;
+	mutable int					lastFrameRouteMemoHits;
+
 private:	// routing
 	bool						SetupRouting();
 	void						ShutdownRouting();
@@ -149,19 +196,30 @@ private:	// routing
 	void						CalculateAreaTravelTimes();
 	void						DeleteAreaTravelTimes();
 	void						SetupRoutingCache();
-	void						DeleteClusterCache( int clusterNum );
-	void						DeletePortalCache();
+	void						DeleteClusterCache( int clusterNum, bool suspendPinned = false );
+	void						DeletePortalCache( bool suspendPinned = false );
+	void						RestorePinnedCache();
 	void						ShutdownRoutingCache();
 	void						RoutingStats() const;
+	void						AddPinnedCache( idRoutingCache* cache );
+	idRoutingCache* 			FindAreaRoutingCache( int clusterNum, int areaNum, int travelFlags ) const;
+	unsigned int				RoutingCacheChecksum( const idList<int>& travelFlags ) const;
+	idStr						RoutingCacheFileName() const;
+	bool						ReadRoutingCache( unsigned int checksum );
+	void						WriteRoutingCache( unsigned int checksum ) const;
+	void						BuildRoutingCache( const idList<int>& travelFlags );
 	void						LinkCache( idRoutingCache* cache ) const;
 	void						UnlinkCache( idRoutingCache* cache ) const;
 	void						DeleteOldestCache() const;
 	idReachability* 			GetAreaReachability( int areaNum, int reachabilityNum ) const;
 	int							ClusterAreaNum( int clusterNum, int areaNum ) const;
-	void						UpdateAreaRoutingCache( idRoutingCache* areaCache ) const;
+	void						UpdateAreaRoutingCache( idRoutingCache* areaCache, idRoutingUpdate* updates ) const;
 	idRoutingCache* 			GetAreaRoutingCache( int clusterNum, int areaNum, int travelFlags ) const;
-	void						UpdatePortalRoutingCache( idRoutingCache* portalCache ) const;
+	void						UpdatePortalRoutingCache( idRoutingCache* portalCache, idRoutingUpdate* updates, idRoutingCache* goalAreaCache ) const;
 	idRoutingCache* 			GetPortalRoutingCache( int clusterNum, int areaNum, int travelFlags ) const;
+	idRoutingCache* 			BuildPortalRoutingCache( int areaNum, int travelFlags, idRoutingUpdate* areaUpdates, idRoutingUpdate* portalUpdates ) const;
+	const aasRouteMemo_t& 		GetRouteMemo( int areaNum, int goalAreaNum, int travelFlags ) const;
+	void						RouteFromArea( aasRouteMemo_t& memo ) const;
 	void						RemoveRoutingCacheUsingArea( int areaNum );
 	void						DisableArea( int areaNum );
 	void						EnableArea( int areaNum );
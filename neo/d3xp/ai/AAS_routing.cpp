@@ -40,6 +40,12 @@ If you have questions concerning this license or the applicable additional terms
 
 #define LEDGE_TRAVELTIME_PANALTY	250
 
+#define ROUTING_CACHE_VERSION		1
+#define ROUTING_CACHE_MAGIC			( ( 'A' << 24 ) | ( 'R' << 16 ) | ( 'C' << 8 ) | ROUTING_CACHE_VERSION )
+#define ROUTING_PRECOMPUTE_JOBS		32
+
+#define AAS_ROUTE_MEMO_SIZE			4096		// must be a power of two
+
 /*
 ============
 idRoutingCache::idRoutingCache
@@ -51,6 +57,7 @@ idRoutingCache::idRoutingCache( int size )
 	cluster = 0;
 	next = prev = NULL;
 	time_next = time_prev = NULL;
+	pinned = false;
 	travelFlags = 0;
 	startTravelTime = 0;
 	type = 0;
@@ -242,14 +249,34 @@ void idAASLocal::SetupRoutingCache()
 
 	cacheListStart = cacheListEnd = NULL;
 	totalCacheMemory = 0;
+
+	numAreaCacheLookups = numAreaCacheHits = 0;
+	numPortalCacheLookups = numPortalCacheHits = 0;
+	areaCacheUpdateTime.Clear();
+	portalCacheUpdateTime.Clear();
+	precomputeTime = 0.0;
+	precomputeLoaded = false;
+	precomputeTravelFlags.Clear();
+	precomputeChecksum = 0;
+	numObstacleReach = 0;
+
+	routeMemo = ( aasRouteMemo_t* ) Mem_ClearedAlloc( AAS_ROUTE_MEMO_SIZE * sizeof( aasRouteMemo_t ), TAG_AAS );
+	routeGeneration = 1;
+	numRouteQueries = numRouteMemoHits = 0;
+	routeQueryTime.Clear();
+	routeStatsFrame = -1;
+	numFrameRouteQueries = numFrameRouteMemoHits = 0;
+	lastFrameRouteQueries = lastFrameRouteMemoHits = 0;
 }
 
 /*
 ============
 idAASLocal::DeleteClusterCache
+
+  Pinned cache is set aside instead of deleted with suspendPinned so it can be restored later.
 ============
 */
-void idAASLocal::DeleteClusterCache( int clusterNum )
+void idAASLocal::DeleteClusterCache( int clusterNum, bool suspendPinned )
 {
 	int i;
 	idRoutingCache* cache;
@@ -259,6 +286,12 @@ void idAASLocal::DeleteClusterCache( int clusterNum )
 		for( cache = areaCacheIndex[clusterNum][i]; cache; cache = areaCacheIndex[clusterNum][i] )
 		{
 			areaCacheIndex[clusterNum][i] = cache->next;
+			if( suspendPinned && cache->pinned )
+			{
+				cache->next = cache->prev = NULL;
+				suspendedCache.Append( cache );
+				continue;
+			}
 			UnlinkCache( cache );
 			delete cache;
 		}
@@ -270,7 +303,7 @@ void idAASLocal::DeleteClusterCache( int clusterNum )
 idAASLocal::DeletePortalCache
 ============
 */
-void idAASLocal::DeletePortalCache()
+void idAASLocal::DeletePortalCache( bool suspendPinned )
 {
 	int i;
 	idRoutingCache* cache;
@@ -280,12 +313,51 @@ void idAASLocal::DeletePortalCache()
 		for( cache = portalCacheIndex[i]; cache; cache = portalCacheIndex[i] )
 		{
 			portalCacheIndex[i] = cache->next;
+			if( suspendPinned && cache->pinned )
+			{
+				cache->next = cache->prev = NULL;
+				suspendedCache.Append( cache );
+				continue;
+			}
 			UnlinkCache( cache );
 			delete cache;
 		}
 	}
 }
 
+/*
+============
+idAASLocal::RestorePinnedCache
+
+  Pins the suspended cache again once every area and reachability is back in the state the cache was precomputed with.
+============
+*/
+void idAASLocal::RestorePinnedCache()
+{
+	int i;
+
+	if( suspendedCache.Num() == 0 || numObstacleReach > 0 || RoutingCacheChecksum( precomputeTravelFlags ) != precomputeChecksum )
+	{
+		return;
+	}
+
+	// drop the cache built on demand while the pinned cache was suspended
+	for( i = 0; i < suspendedCache.Num(); i++ )
+	{
+		if( suspendedCache[i]->type == CACHETYPE_AREA )
+		{
+			DeleteClusterCache( suspendedCache[i]->cluster );
+		}
+	}
+	DeletePortalCache();
+
+	for( i = 0; i < suspendedCache.Num(); i++ )
+	{
+		AddPinnedCache( suspendedCache[i] );
+	}
+	suspendedCache.Clear();
+}
+
 /*
 ============
 idAASLocal::ShutdownRoutingCache
@@ -302,6 +374,8 @@ void idAASLocal::ShutdownRoutingCache()
 
 	DeletePortalCache();
 
+	suspendedCache.DeleteContents( true );
+
 	Mem_Free( areaCacheIndex );
 	areaCacheIndex = NULL;
 	areaCacheIndexSize = 0;
@@ -314,6 +388,8 @@ void idAASLocal::ShutdownRoutingCache()
 	portalUpdate = NULL;
 	Mem_Free( goalAreaTravelTimes );
 	goalAreaTravelTimes = NULL;
+	Mem_Free( routeMemo );
+	routeMemo = NULL;
 
 	cacheListStart = cacheListEnd = NULL;
 	totalCacheMemory = 0;
@@ -350,8 +426,8 @@ idAASLocal::RoutingStats
 void idAASLocal::RoutingStats() const
 {
 	idRoutingCache* cache;
-	int numAreaCache, numPortalCache;
-	int totalAreaCacheMemory, totalPortalCacheMemory;
+	int numAreaCache, numPortalCache, numPinnedCache;
+	int totalAreaCacheMemory, totalPortalCacheMemory, totalPinnedCacheMemory;
 
 	numAreaCache = numPortalCache = 0;
 	totalAreaCacheMemory = totalPortalCacheMemory = 0;
@@ -375,6 +451,43 @@ void idAASLocal::RoutingStats() const
 	gameLocal.Printf( "%6d area travel times (%d KB)\n", numAreaTravelTimes, ( numAreaTravelTimes * sizeof( unsigned short ) ) >> 10 );
 	gameLocal.Printf( "%6d area cache entries (%d KB)\n", areaCacheIndexSize, ( areaCacheIndexSize * sizeof( idRoutingCache* ) ) >> 10 );
 	gameLocal.Printf( "%6d portal cache entries (%d KB)\n", portalCacheIndexSize, ( portalCacheIndexSize * sizeof( idRoutingCache* ) ) >> 10 );
+
+	// precomputed cache isn't in the time based list
+	numPinnedCache = totalPinnedCacheMemory = 0;
+	for( int i = 0; i < file->GetNumClusters(); i++ )
+	{
+		for( int j = 0; j < file->GetCluster( i ).numReachableAreas; j++ )
+		{
+			for( cache = areaCacheIndex[i][j]; cache; cache = cache->next )
+			{
+				if( cache->pinned )
+				{
+					numPinnedCache++;
+					totalPinnedCacheMemory += cache->Size();
+				}
+			}
+		}
+	}
+	for( int i = 0; i < portalCacheIndexSize; i++ )
+	{
+		for( cache = portalCacheIndex[i]; cache; cache = cache->next )
+		{
+			if( cache->pinned )
+			{
+				numPinnedCache++;
+				totalPinnedCacheMemory += cache->Size();
+			}
+		}
+	}
+
+	gameLocal.Printf( "%6d precomputed cache (%d KB) %s in %.1f ms\n", numPinnedCache, totalPinnedCacheMemory >> 10, precomputeLoaded ? "loaded" : "built", precomputeTime );
+	gameLocal.Printf( "%6d area cache lookups, %.1f%% hits, %.1f ms rebuilding\n", numAreaCacheLookups,
+					  numAreaCacheLookups ? 100.0f * numAreaCacheHits / numAreaCacheLookups : 0.0f, areaCacheUpdateTime.Milliseconds() );
+	gameLocal.Printf( "%6d portal cache lookups, %.1f%% hits, %.1f ms rebuilding\n", numPortalCacheLookups,
+					  numPortalCacheLookups ? 100.0f * numPortalCacheHits / numPortalCacheLookups : 0.0f, portalCacheUpdateTime.Milliseconds() );
+	gameLocal.Printf( "%6d route queries, %.1f%% memo hits, %.4f ms per query\n", numRouteQueries,
+					  numRouteQueries ? 100.0f * numRouteMemoHits / numRouteQueries : 0.0f, numRouteQueries ? routeQueryTime.Milliseconds() / numRouteQueries : 0.0 );
+	gameLocal.Printf( "%6d route queries last frame, %d memo hits\n", lastFrameRouteQueries, lastFrameRouteMemoHits );
 }
 
 /*
@@ -390,15 +503,18 @@ void idAASLocal::RemoveRoutingCacheUsingArea( int areaNum )
 	if( clusterNum > 0 )
 	{
 		// remove all the cache in the cluster the area is in
-		DeleteClusterCache( clusterNum );
+		DeleteClusterCache( clusterNum, true );
 	}
 	else
 	{
 		// if this is a portal remove all cache in both the front and back cluster
-		DeleteClusterCache( file->GetPortal( -clusterNum ).clusters[0] );
-		DeleteClusterCache( file->GetPortal( -clusterNum ).clusters[1] );
+		DeleteClusterCache( file->GetPortal( -clusterNum ).clusters[0], true );
+		DeleteClusterCache( file->GetPortal( -clusterNum ).clusters[1], true );
 	}
-	DeletePortalCache();
+	DeletePortalCache( true );
+
+	// routes remembered from before the change are no longer valid
+	routeGeneration++;
 }
 
 /*
@@ -418,6 +534,7 @@ void idAASLocal::DisableArea( int areaNum )
 	file->SetAreaTravelFlag( areaNum, TFL_INVALID );
 
 	RemoveRoutingCacheUsingArea( areaNum );
+	RestorePinnedCache();
 }
 
 /*
@@ -437,6 +554,7 @@ void idAASLocal::EnableArea( int areaNum )
 	file->RemoveAreaTravelFlag( areaNum, TFL_INVALID );
 
 	RemoveRoutingCacheUsingArea( areaNum );
+	RestorePinnedCache();
 }
 
 /*
@@ -594,6 +712,10 @@ void idAASLocal::SetObstacleState( const idRoutingObstacle* obstacle, bool enabl
 			{
 				if( enable )
 				{
+					if( rev_reach->disableCount == 1 )
+					{
+						numObstacleReach--;
+					}
 					rev_reach->disableCount--;
 					if( rev_reach->disableCount <= 0 )
 					{
@@ -603,12 +725,19 @@ void idAASLocal::SetObstacleState( const idRoutingObstacle* obstacle, bool enabl
 				}
 				else
 				{
+					if( rev_reach->disableCount == 0 )
+					{
+						numObstacleReach++;
+					}
 					rev_reach->travelType |= TFL_INVALID;
 					rev_reach->disableCount++;
 				}
 			}
 		}
 	}
+
+	// the reachabilities changed after the cache using the areas was removed
+	RestorePinnedCache();
 }
 
 /*
@@ -686,6 +815,10 @@ idAASLocal::LinkCache
 */
 void idAASLocal::LinkCache( idRoutingCache* cache ) const
 {
+	if( cache->pinned )
+	{
+		return;
+	}
 
 	// if the cache is already linked
 	if( cache->time_next || cache->time_prev || cacheListStart == cache )
@@ -716,6 +849,10 @@ idAASLocal::UnlinkCache
 */
 void idAASLocal::UnlinkCache( idRoutingCache* cache ) const
 {
+	if( cache->pinned )
+	{
+		return;
+	}
 
 	totalCacheMemory -= cache->Size();
 
@@ -820,7 +957,7 @@ ID_INLINE int idAASLocal::ClusterAreaNum( int clusterNum, int areaNum ) const
 idAASLocal::UpdateAreaRoutingCache
 ============
 */
-void idAASLocal::UpdateAreaRoutingCache( idRoutingCache* areaCache ) const
+void idAASLocal::UpdateAreaRoutingCache( idRoutingCache* areaCache, idRoutingUpdate* updates ) const
 {
 	int i, nextAreaNum, cluster, badTravelFlags, clusterAreaNum, numReachableAreas;
 	unsigned short t, startAreaTravelTimes[MAX_REACH_PER_AREA];
@@ -843,7 +980,7 @@ void idAASLocal::UpdateAreaRoutingCache( idRoutingCache* areaCache ) const
 	memset( startAreaTravelTimes, 0, sizeof( startAreaTravelTimes ) );
 
 	// initialize first update
-	curUpdate = &areaUpdate[clusterAreaNum];
+	curUpdate = &updates[clusterAreaNum];
 	curUpdate->areaNum = areaCache->areaNum;
 	curUpdate->areaTravelTimes = startAreaTravelTimes;
 	curUpdate->tmpTravelTime = areaCache->startTravelTime;
@@ -914,7 +1051,7 @@ void idAASLocal::UpdateAreaRoutingCache( idRoutingCache* areaCache ) const
 
 				areaCache->travelTimes[clusterAreaNum] = t;
 				areaCache->reachabilities[clusterAreaNum] = reach->number; // reversed reachability used to get into this area
-				nextUpdate = &areaUpdate[clusterAreaNum];
+				nextUpdate = &updates[clusterAreaNum];
 				nextUpdate->areaNum = nextAreaNum;
 				nextUpdate->tmpTravelTime = t;
 				nextUpdate->areaTravelTimes = reach->areaTravelTimes;
@@ -949,6 +1086,26 @@ void idAASLocal::UpdateAreaRoutingCache( idRoutingCache* areaCache ) const
 	}
 }
 
+/*
+============
+idAASLocal::FindAreaRoutingCache
+============
+*/
+idRoutingCache* idAASLocal::FindAreaRoutingCache( int clusterNum, int areaNum, int travelFlags ) const
+{
+	idRoutingCache* cache;
+
+	// check if cache without undesired travel flags already exists
+	for( cache = areaCacheIndex[clusterNum][ClusterAreaNum( clusterNum, areaNum )]; cache; cache = cache->next )
+	{
+		if( cache->travelFlags == travelFlags )
+		{
+			break;
+		}
+	}
+	return cache;
+}
+
 /*
 ============
 idAASLocal::GetAreaRoutingCache
@@ -963,14 +1120,8 @@ idRoutingCache* idAASLocal::GetAreaRoutingCache( int clusterNum, int areaNum, in
 	clusterAreaNum = ClusterAreaNum( clusterNum, areaNum );
 	// pointer to the cache for the area in the cluster
 	clusterCache = areaCacheIndex[clusterNum][clusterAreaNum];
-	// check if cache without undesired travel flags already exists
-	for( cache = clusterCache; cache; cache = cache->next )
-	{
-		if( cache->travelFlags == travelFlags )
-		{
-			break;
-		}
-	}
+	cache = FindAreaRoutingCache( clusterNum, areaNum, travelFlags );
+	numAreaCacheLookups++;
 	// if no cache found
 	if( !cache )
 	{
@@ -987,7 +1138,13 @@ idRoutingCache* idAASLocal::GetAreaRoutingCache( int clusterNum, int areaNum, in
 			clusterCache->prev = cache;
 		}
 		areaCacheIndex[clusterNum][clusterAreaNum] = cache;
-		UpdateAreaRoutingCache( cache );
+		areaCacheUpdateTime.Start();
+		UpdateAreaRoutingCache( cache, areaUpdate );
+		areaCacheUpdateTime.Stop();
+	}
+	else
+	{
+		numAreaCacheHits++;
 	}
 	LinkCache( cache );
 	return cache;
@@ -998,7 +1155,7 @@ idRoutingCache* idAASLocal::GetAreaRoutingCache( int clusterNum, int areaNum, in
 idAASLocal::UpdatePortalRoutingCache
 ============
 */
-void idAASLocal::UpdatePortalRoutingCache( idRoutingCache* portalCache ) const
+void idAASLocal::UpdatePortalRoutingCache( idRoutingCache* portalCache, idRoutingUpdate* updates, idRoutingCache* goalAreaCache ) const
 {
 	int i, portalNum, clusterAreaNum;
 	unsigned short t;
@@ -1007,7 +1164,7 @@ void idAASLocal::UpdatePortalRoutingCache( idRoutingCache* portalCache ) const
 	idRoutingCache* cache;
 	idRoutingUpdate* updateListStart, *updateListEnd, *curUpdate, *nextUpdate;
 
-	curUpdate = &portalUpdate[ file->GetNumPortals() ];
+	curUpdate = &updates[ file->GetNumPortals() ];
 	curUpdate->cluster = portalCache->cluster;
 	curUpdate->areaNum = portalCache->areaNum;
 	curUpdate->tmpTravelTime = portalCache->startTravelTime;
@@ -1037,7 +1194,24 @@ void idAASLocal::UpdatePortalRoutingCache( idRoutingCache* portalCache ) const
 		curUpdate->isInList = false;
 
 		cluster = &file->GetCluster( curUpdate->cluster );
-		cache = GetAreaRoutingCache( curUpdate->cluster, curUpdate->areaNum, portalCache->travelFlags );
+		if( goalAreaCache == NULL )
+		{
+			cache = GetAreaRoutingCache( curUpdate->cluster, curUpdate->areaNum, portalCache->travelFlags );
+		}
+		else if( curUpdate == &updates[ file->GetNumPortals() ] )
+		{
+			// precomputing on a job thread, the caller built the cache of the goal area
+			cache = goalAreaCache;
+		}
+		else
+		{
+			// precomputing on a job thread, the cache of every portal area is pinned and read only
+			cache = FindAreaRoutingCache( curUpdate->cluster, curUpdate->areaNum, portalCache->travelFlags );
+			if( cache == NULL )
+			{
+				continue;
+			}
+		}
 
 		// take all portals of the cluster
 		for( i = 0; i < cluster->numPortals; i++ )
@@ -1064,7 +1238,7 @@ void idAASLocal::UpdatePortalRoutingCache( idRoutingCache* portalCache ) const
 
 				portalCache->travelTimes[portalNum] = t;
 				portalCache->reachabilities[portalNum] = cache->reachabilities[clusterAreaNum];
-				nextUpdate = &portalUpdate[portalNum];
+				nextUpdate = &updates[portalNum];
 				if( portal->clusters[0] == curUpdate->cluster )
 				{
 					nextUpdate->cluster = portal->clusters[1];
@@ -1115,6 +1289,7 @@ idRoutingCache* idAASLocal::GetPortalRoutingCache( int clusterNum, int areaNum,
 			break;
 		}
 	}
+	numPortalCacheLookups++;
 	// if no cache found
 	if( !cache )
 	{
@@ -1131,7 +1306,13 @@ idRoutingCache* idAASLocal::GetPortalRoutingCache( int clusterNum, int areaNum,
 			portalCacheIndex[areaNum]->prev = cache;
 		}
 		portalCacheIndex[areaNum] = cache;
-		UpdatePortalRoutingCache( cache );
+		portalCacheUpdateTime.Start();
+		UpdatePortalRoutingCache( cache, portalUpdate, NULL );
+		portalCacheUpdateTime.Stop();
+	}
+	else
+	{
+		numPortalCacheHits++;
 	}
 	LinkCache( cache );
 	return cache;
@@ -1139,42 +1320,457 @@ idRoutingCache* idAASLocal::GetPortalRoutingCache( int clusterNum, int areaNum,
 
 /*
 ============
-idAASLocal::RouteToGoalArea
+idAASLocal::BuildPortalRoutingCache
+
+  Builds the portal cache towards the goal area without touching any shared routing state,
+  so it can run on a job thread while all portal area caches are pinned.
 ============
 */
-bool idAASLocal::RouteToGoalArea( int areaNum, const idVec3 origin, int goalAreaNum, int travelFlags, int& travelTime, idReachability** reach ) const
+idRoutingCache* idAASLocal::BuildPortalRoutingCache( int areaNum, int travelFlags, idRoutingUpdate* areaUpdates, idRoutingUpdate* portalUpdates ) const
 {
-	int clusterNum, goalClusterNum, portalNum, i, clusterAreaNum;
-	unsigned short int t, bestTime;
-	const aasPortal_t* portal;
-	const aasCluster_t* cluster;
-	idRoutingCache* areaCache, *portalCache, *clusterCache;
-	idReachability* bestReach, *r, *nextr;
+	int clusterNum;
+	idRoutingCache* areaCache, *portalCache;
 
-	travelTime = 0;
-	*reach = NULL;
+	clusterNum = file->GetArea( areaNum ).cluster;
+	if( clusterNum < 0 )
+	{
+		// just assume the goal area is part of the front cluster, same as RouteToGoalArea
+		clusterNum = file->GetPortal( -clusterNum ).clusters[0];
+	}
 
-	if( !file )
+	areaCache = FindAreaRoutingCache( clusterNum, areaNum, travelFlags );
+	if( areaCache == NULL || !areaCache->pinned )
 	{
-		return false;
+		areaCache = new( TAG_AAS ) idRoutingCache( file->GetCluster( clusterNum ).numReachableAreas );
+		areaCache->type = CACHETYPE_AREA;
+		areaCache->cluster = clusterNum;
+		areaCache->areaNum = areaNum;
+		areaCache->startTravelTime = 1;
+		areaCache->travelFlags = travelFlags;
+		UpdateAreaRoutingCache( areaCache, areaUpdates );
 	}
 
-	if( areaNum == goalAreaNum )
+	portalCache = new( TAG_AAS ) idRoutingCache( file->GetNumPortals() );
+	portalCache->type = CACHETYPE_PORTAL;
+	portalCache->cluster = clusterNum;
+	portalCache->areaNum = areaNum;
+	portalCache->startTravelTime = 1;
+	portalCache->travelFlags = travelFlags;
+	UpdatePortalRoutingCache( portalCache, portalUpdates, areaCache );
+
+	if( !areaCache->pinned )
 	{
-		return true;
+		delete areaCache;
 	}
 
-	if( areaNum <= 0 || areaNum >= file->GetNumAreas() )
+	return portalCache;
+}
+
+/*
+============
+idAASLocal::AddPinnedCache
+
+  Adds cache that is never deleted to make room for new cache, it's set aside while the areas it uses are changed.
+============
+*/
+void idAASLocal::AddPinnedCache( idRoutingCache* cache )
+{
+	idRoutingCache** head;
+
+	if( cache->type == CACHETYPE_AREA )
+	{
+		head = &areaCacheIndex[cache->cluster][ClusterAreaNum( cache->cluster, cache->areaNum )];
+	}
+	else
+	{
+		head = &portalCacheIndex[cache->areaNum];
+	}
+
+	cache->pinned = true;
+	cache->prev = NULL;
+	cache->next = *head;
+	if( *head )
+	{
+		( *head )->prev = cache;
+	}
+	*head = cache;
+}
+
+/*
+============
+idAASLocal::RoutingCacheChecksum
+
+  The precomputed cache is only valid for the aas file and the area state it was built with.
+============
+*/
+unsigned int idAASLocal::RoutingCacheChecksum( const idList<int>& travelFlags ) const
+{
+	unsigned int crc, value;
+
+	CRC32_InitChecksum( crc );
+	value = file->GetCRC();
+	CRC32_UpdateChecksum( crc, &value, sizeof( value ) );
+	CRC32_UpdateChecksum( crc, travelFlags.Ptr(), travelFlags.Num() * sizeof( travelFlags[0] ) );
+	for( int i = 0; i < file->GetNumAreas(); i++ )
+	{
+		value = file->GetArea( i ).travelFlags;
+		CRC32_UpdateChecksum( crc, &value, sizeof( value ) );
+	}
+	CRC32_FinishChecksum( crc );
+
+	return crc;
+}
+
+/*
+============
+idAASLocal::RoutingCacheFileName
+============
+*/
+idStr idAASLocal::RoutingCacheFileName() const
+{
+	idStr fileName = file->GetName();
+	fileName.Insert( "generated/", 0 );
+	fileName.Append( ".route" );
+	return fileName;
+}
+
+/*
+============
+idAASLocal::ReadRoutingCache
+============
+*/
+bool idAASLocal::ReadRoutingCache( unsigned int checksum )
+{
+	int magic, numCaches, i, j;
+	unsigned int fileChecksum;
+	idList<idRoutingCache*> caches;
+
+	idFileLocal f( fileSystem->OpenFileReadMemory( RoutingCacheFileName() ) );
+	if( f == NULL )
 	{
-		gameLocal.Printf( "RouteToGoalArea: areaNum %d out of range\n", areaNum );
 		return false;
 	}
-	if( goalAreaNum <= 0 || goalAreaNum >= file->GetNumAreas() )
+
+	f->ReadBig( magic );
+	f->ReadBig( fileChecksum );
+	if( magic != ROUTING_CACHE_MAGIC || fileChecksum != checksum )
 	{
-		gameLocal.Printf( "RouteToGoalArea: goalAreaNum %d out of range\n", goalAreaNum );
 		return false;
 	}
 
+	f->ReadBig( numCaches );
+	for( i = 0; i < numCaches; i++ )
+	{
+		int type, cluster, areaNum, travelFlags, size;
+
+		f->ReadBig( type );
+		f->ReadBig( cluster );
+		f->ReadBig( areaNum );
+		f->ReadBig( travelFlags );
+		f->ReadBig( size );
+
+		if( cluster <= 0 || cluster >= file->GetNumClusters() || areaNum <= 0 || areaNum >= file->GetNumAreas() ||
+				( type == CACHETYPE_AREA && size != file->GetCluster( cluster ).numReachableAreas ) ||
+				( type == CACHETYPE_PORTAL && size != file->GetNumPortals() ) ||
+				( type != CACHETYPE_AREA && type != CACHETYPE_PORTAL ) )
+		{
+			break;
+		}
+
+		idRoutingCache* cache = new( TAG_AAS ) idRoutingCache( size );
+		cache->type = type;
+		cache->cluster = cluster;
+		cache->areaNum = areaNum;
+		cache->startTravelTime = 1;
+		cache->travelFlags = travelFlags;
+		f->Read( cache->reachabilities, size );
+		for( j = 0; j < size; j++ )
+		{
+			f->ReadBig( cache->travelTimes[j] );
+		}
+		caches.Append( cache );
+	}
+
+	if( i < numCaches || f->Tell() != f->Length() )
+	{
+		gameLocal.Warning( "%s is corrupt, rebuilding the routing cache", RoutingCacheFileName().c_str() );
+		caches.DeleteContents( true );
+		return false;
+	}
+
+	for( i = 0; i < caches.Num(); i++ )
+	{
+		AddPinnedCache( caches[i] );
+	}
+
+	return true;
+}
+
+/*
+============
+idAASLocal::WriteRoutingCache
+============
+*/
+void idAASLocal::WriteRoutingCache( unsigned int checksum ) const
+{
+	int i, j, numCaches;
+	idRoutingCache* cache;
+	idList<const idRoutingCache*> caches;
+
+	for( i = 0; i < file->GetNumClusters(); i++ )
+	{
+		for( j = 0; j < file->GetCluster( i ).numReachableAreas; j++ )
+		{
+			for( cache = areaCacheIndex[i][j]; cache; cache = cache->next )
+			{
+				if( cache->pinned )
+				{
+					caches.Append( cache );
+				}
+			}
+		}
+	}
+	for( i = 0; i < portalCacheIndexSize; i++ )
+	{
+		for( cache = portalCacheIndex[i]; cache; cache = cache->next )
+		{
+			if( cache->pinned )
+			{
+				caches.Append( cache );
+			}
+		}
+	}
+
+	idFileLocal f( fileSystem->OpenFileWrite( RoutingCacheFileName(), "fs_basepath" ) );
+	if( f == NULL )
+	{
+		gameLocal.Warning( "couldn't write %s", RoutingCacheFileName().c_str() );
+		return;
+	}
+
+	numCaches = caches.Num();
+	f->WriteBig( ROUTING_CACHE_MAGIC );
+	f->WriteBig( checksum );
+	f->WriteBig( numCaches );
+	for( i = 0; i < caches.Num(); i++ )
+	{
+		const idRoutingCache* c = caches[i];
+		f->WriteBig( c->type );
+		f->WriteBig( c->cluster );
+		f->WriteBig( c->areaNum );
+		f->WriteBig( c->travelFlags );
+		f->WriteBig( c->size );
+		f->Write( c->reachabilities, c->size );
+		for( j = 0; j < c->size; j++ )
+		{
+			f->WriteBig( c->travelTimes[j] );
+		}
+	}
+}
+
+struct aasRoutingJob_t
+{
+	const idAASLocal* 	aas;
+	int					travelFlags;
+	const int* 			goalAreas;
+	int					numGoalAreas;
+	idRoutingCache** 	portalCaches;		// portal cache for each goal area
+	idRoutingUpdate* 	areaUpdates;		// scratch memory owned by the job
+	idRoutingUpdate* 	portalUpdates;
+};
+
+/*
+============
+AAS_PrecomputeRoutingJob
+============
+*/
+void AAS_PrecomputeRoutingJob( aasRoutingJob_t* job )
+{
+	for( int i = 0; i < job->numGoalAreas; i++ )
+	{
+		job->portalCaches[i] = job->aas->BuildPortalRoutingCache( job->goalAreas[i], job->travelFlags, job->areaUpdates, job->portalUpdates );
+	}
+}
+
+REGISTER_PARALLEL_JOB( AAS_PrecomputeRoutingJob, "AAS_PrecomputeRoutingJob" );
+
+/*
+============
+idAASLocal::BuildRoutingCache
+
+  Builds and pins the cache of every portal area and the portal cache towards every reachable area.
+============
+*/
+void idAASLocal::BuildRoutingCache( const idList<int>& travelFlags )
+{
+	int i, j, t, numJobs, areaFlags;
+	idList<int> goalAreas;
+	idList<idRoutingCache*> portalCaches;
+	aasRoutingJob_t jobs[ROUTING_PRECOMPUTE_JOBS];
+	idRoutingCache* cache;
+
+	const int numAreaUpdates = file->GetNumAreas();
+	const int numPortalUpdates = file->GetNumPortals() + 1;
+	idRoutingUpdate* updates = ( idRoutingUpdate* ) Mem_ClearedAlloc( ROUTING_PRECOMPUTE_JOBS * ( numAreaUpdates + numPortalUpdates ) * sizeof( idRoutingUpdate ), TAG_AAS );
+	idParallelJobList* jobList = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_MEDIUM, ROUTING_PRECOMPUTE_JOBS, 0, NULL );
+
+	for( t = 0; t < travelFlags.Num(); t++ )
+	{
+		// every job reads the caches of the portal areas, build and pin those first
+		for( i = 0; i < file->GetNumPortals(); i++ )
+		{
+			const aasPortal_t& portal = file->GetPortal( i );
+			for( j = 0; j < 2; j++ )
+			{
+				if( portal.areaNum <= 0 || portal.clusters[j] <= 0 )
+				{
+					continue;
+				}
+				if( ClusterAreaNum( portal.clusters[j], portal.areaNum ) >= file->GetCluster( portal.clusters[j] ).numReachableAreas )
+				{
+					continue;
+				}
+				cache = GetAreaRoutingCache( portal.clusters[j], portal.areaNum, travelFlags[t] );
+				UnlinkCache( cache );
+				cache->pinned = true;
+			}
+		}
+
+		areaFlags = AREA_REACHABLE_WALK;
+		if( travelFlags[t] & TFL_FLY )
+		{
+			areaFlags |= AREA_REACHABLE_FLY;
+		}
+
+		goalAreas.SetNum( 0 );
+		for( i = 1; i < file->GetNumAreas(); i++ )
+		{
+			if( !( file->GetArea( i ).flags & areaFlags ) )
+			{
+				continue;
+			}
+			for( cache = portalCacheIndex[i]; cache; cache = cache->next )
+			{
+				if( cache->travelFlags == travelFlags[t] )
+				{
+					break;
+				}
+			}
+			if( cache == NULL )
+			{
+				goalAreas.Append( i );
+			}
+		}
+		if( goalAreas.Num() == 0 )
+		{
+			continue;
+		}
+
+		portalCaches.SetNum( goalAreas.Num() );
+
+		numJobs = Min( ROUTING_PRECOMPUTE_JOBS, ( goalAreas.Num() + 15 ) / 16 );
+		const int areasPerJob = ( goalAreas.Num() + numJobs - 1 ) / numJobs;
+		for( i = 0; i < numJobs; i++ )
+		{
+			const int first = i * areasPerJob;
+			jobs[i].aas = this;
+			jobs[i].travelFlags = travelFlags[t];
+			jobs[i].goalAreas = goalAreas.Ptr() + first;
+			jobs[i].numGoalAreas = Min( areasPerJob, goalAreas.Num() - first );
+			jobs[i].portalCaches = portalCaches.Ptr() + first;
+			jobs[i].areaUpdates = updates + i * ( numAreaUpdates + numPortalUpdates );
+			jobs[i].portalUpdates = jobs[i].areaUpdates + numAreaUpdates;
+			if( jobs[i].numGoalAreas > 0 )
+			{
+				jobList->AddJob( ( jobRun_t )AAS_PrecomputeRoutingJob, &jobs[i] );
+			}
+		}
+		jobList->Submit( NULL, JOBLIST_PARALLELISM_MAX_CORES );
+		jobList->Wait();
+
+		for( i = 0; i < portalCaches.Num(); i++ )
+		{
+			AddPinnedCache( portalCaches[i] );
+		}
+	}
+
+	parallelJobManager->FreeJobList( jobList );
+	Mem_Free( updates );
+}
+
+/*
+============
+idAASLocal::PrecomputeRouting
+============
+*/
+void idAASLocal::PrecomputeRouting()
+{
+	idList<int> travelFlags;
+	idTimer timer;
+
+	if( !file || !aas_precomputeRouting.GetBool() )
+	{
+		return;
+	}
+
+	// the travel flags the AI use by default
+	travelFlags.Append( TFL_WALK | TFL_AIR );
+	if( file->GetSettings().allowFlyReachabilities )
+	{
+		travelFlags.Append( TFL_WALK | TFL_AIR | TFL_FLY );
+	}
+
+	timer.Start();
+
+	const unsigned int checksum = RoutingCacheChecksum( travelFlags );
+	precomputeTravelFlags = travelFlags;
+	precomputeChecksum = checksum;
+	precomputeLoaded = ReadRoutingCache( checksum );
+	if( !precomputeLoaded )
+	{
+		BuildRoutingCache( travelFlags );
+		WriteRoutingCache( checksum );
+	}
+
+	timer.Stop();
+	precomputeTime = timer.Milliseconds();
+
+	// only count the lookups made by the game
+	numAreaCacheLookups = numAreaCacheHits = 0;
+	numPortalCacheLookups = numPortalCacheHits = 0;
+	areaCacheUpdateTime.Clear();
+	portalCacheUpdateTime.Clear();
+
+	common->Printf( "%s routing cache for %s in %.1f ms\n", precomputeLoaded ? "loaded" : "built", file->GetName(), precomputeTime );
+}
+
+/*
+============
+idAASLocal::RouteFromArea
+
+  Finds the routes from the memo area towards the memo goal area without the
+  travel time from the origin within the area to the start of the first reachability.
+============
+*/
+void idAASLocal::RouteFromArea( aasRouteMemo_t& memo ) const
+{
+	int areaNum, goalAreaNum, travelFlags;
+	int clusterNum, goalClusterNum, portalNum, i, clusterAreaNum;
+	unsigned short int t;
+	const aasPortal_t* portal;
+	const aasCluster_t* cluster;
+	idRoutingCache* areaCache, *portalCache, *clusterCache;
+	idReachability* r, *nextr;
+
+	areaNum = memo.areaNum;
+	goalAreaNum = memo.goalAreaNum;
+	travelFlags = memo.travelFlags;
+
+	memo.routed = false;
+	memo.fromPortal = false;
+	memo.areaTime = memo.portalTime = 0;
+	memo.areaReach = memo.portalReach = NULL;
+
 	while( totalCacheMemory > MAX_ROUTING_CACHE_MEMORY )
 	{
 		DeleteOldestCache();
@@ -1195,14 +1791,13 @@ bool idAASLocal::RouteToGoalArea( int areaNum, const idVec3 origin, int goalArea
 		}
 		// get the portal routing cache
 		portalCache = GetPortalRoutingCache( goalClusterNum, goalAreaNum, travelFlags );
-		*reach = GetAreaReachability( areaNum, portalCache->reachabilities[-clusterNum] );
-		travelTime = portalCache->travelTimes[-clusterNum] + AreaTravelTime( areaNum, origin, ( *reach )->start );
-		return true;
+		memo.portalReach = GetAreaReachability( areaNum, portalCache->reachabilities[-clusterNum] );
+		memo.portalTime = portalCache->travelTimes[-clusterNum];
+		memo.fromPortal = true;
+		memo.routed = true;
+		return;
 	}
 
-	bestTime = 0;
-	bestReach = NULL;
-
 	// check if the goal area is a portal of the source area cluster
 	if( goalClusterNum < 0 )
 	{
@@ -1220,8 +1815,8 @@ bool idAASLocal::RouteToGoalArea( int areaNum, const idVec3 origin, int goalArea
 		clusterAreaNum = ClusterAreaNum( clusterNum, areaNum );
 		if( clusterCache->travelTimes[clusterAreaNum] )
 		{
-			bestReach = GetAreaReachability( areaNum, clusterCache->reachabilities[clusterAreaNum] );
-			bestTime = clusterCache->travelTimes[clusterAreaNum] + AreaTravelTime( areaNum, origin, bestReach->start );
+			memo.areaReach = GetAreaReachability( areaNum, clusterCache->reachabilities[clusterAreaNum] );
+			memo.areaTime = clusterCache->travelTimes[clusterAreaNum];
 		}
 		else
 		{
@@ -1253,8 +1848,9 @@ bool idAASLocal::RouteToGoalArea( int areaNum, const idVec3 origin, int goalArea
 	// if the area is not a reachable area
 	if( clusterAreaNum >= cluster->numReachableAreas )
 	{
-		return false;
+		return;
 	}
+	memo.routed = true;
 
 	// find the portal of the source area cluster leading towards the goal area
 	for( i = 0; i < cluster->numPortals; i++ )
@@ -1298,12 +1894,124 @@ bool idAASLocal::RouteToGoalArea( int areaNum, const idVec3 origin, int goalArea
 		t += portal->maxAreaTravelTime;
 
 		// if the time is better than the one already found
-		if( !bestTime || t < bestTime )
+		if( !memo.portalTime || t < memo.portalTime )
 		{
-			bestReach = r;
-			bestTime = t;
+			memo.portalReach = r;
+			memo.portalTime = t;
 		}
 	}
+}
+
+/*
+============
+idAASLocal::GetRouteMemo
+
+  Route queries are repeated a lot for the same areas while AI evaluates hiding spots,
+  attack positions and paths. The origin independent part of a query is kept in a hash
+  table until the area state changes.
+============
+*/
+const aasRouteMemo_t& idAASLocal::GetRouteMemo( int areaNum, int goalAreaNum, int travelFlags ) const
+{
+	int hash;
+	aasRouteMemo_t* memo;
+
+	if( gameLocal.framenum != routeStatsFrame )
+	{
+		lastFrameRouteQueries = numFrameRouteQueries;
+		lastFrameRouteMemoHits = numFrameRouteMemoHits;
+		numFrameRouteQueries = numFrameRouteMemoHits = 0;
+		routeStatsFrame = gameLocal.framenum;
+	}
+	numRouteQueries++;
+	numFrameRouteQueries++;
+
+	hash = ( areaNum * 31337 + goalAreaNum * 7919 + travelFlags ) & ( AAS_ROUTE_MEMO_SIZE - 1 );
+	memo = &routeMemo[hash];
+
+	if( memo->generation == routeGeneration && memo->areaNum == areaNum && memo->goalAreaNum == goalAreaNum && memo->travelFlags == travelFlags )
+	{
+		numRouteMemoHits++;
+		numFrameRouteMemoHits++;
+		return *memo;
+	}
+
+	memo->areaNum = areaNum;
+	memo->goalAreaNum = goalAreaNum;
+	memo->travelFlags = travelFlags;
+	memo->generation = routeGeneration;
+	RouteFromArea( *memo );
+
+	return *memo;
+}
+
+/*
+============
+idAASLocal::RouteToGoalArea
+============
+*/
+bool idAASLocal::RouteToGoalArea( int areaNum, const idVec3 origin, int goalAreaNum, int travelFlags, int& travelTime, idReachability** reach ) const
+{
+	unsigned short int bestTime;
+	idReachability* bestReach;
+
+	travelTime = 0;
+	*reach = NULL;
+
+	if( !file )
+	{
+		return false;
+	}
+
+	if( areaNum == goalAreaNum )
+	{
+		return true;
+	}
+
+	if( areaNum <= 0 || areaNum >= file->GetNumAreas() )
+	{
+		gameLocal.Printf( "RouteToGoalArea: areaNum %d out of range\n", areaNum );
+		return false;
+	}
+	if( goalAreaNum <= 0 || goalAreaNum >= file->GetNumAreas() )
+	{
+		gameLocal.Printf( "RouteToGoalArea: goalAreaNum %d out of range\n", goalAreaNum );
+		return false;
+	}
+
+	routeQueryTime.Start();
+	const aasRouteMemo_t& memo = GetRouteMemo( areaNum, goalAreaNum, travelFlags );
+	routeQueryTime.Stop();
+
+	// if the source area is a cluster portal the route comes directly from the portal cache
+	if( memo.fromPortal )
+	{
+		*reach = memo.portalReach;
+		travelTime = memo.portalTime + AreaTravelTime( areaNum, origin, memo.portalReach->start );
+		return true;
+	}
+
+	if( !memo.routed )
+	{
+		return false;
+	}
+
+	bestTime = 0;
+	bestReach = NULL;
+
+	// route within the cluster
+	if( memo.areaReach )
+	{
+		bestReach = memo.areaReach;
+		bestTime = memo.areaTime + AreaTravelTime( areaNum, origin, bestReach->start );
+	}
+
+	// route through the best portal of the cluster
+	if( memo.portalReach && ( !bestTime || memo.portalTime < bestTime ) )
+	{
+		bestReach = memo.portalReach;
+		bestTime = memo.portalTime;
+	}
 
 	if( !bestReach )
 	{
@@ -522,6 +522,9 @@ public:
 	void						ForceUpdate();
 	void						ClearForceUpdate();
 	bool						CreateFrame( int animtime, bool force );
+	bool						NeedsFrame( int animtime ) const;
+	void						CreateFrameAhead( int animtime );
+	bool						ConsumeFrameAhead( int animtime );
 	bool						FrameHasChanged( int animtime ) const;
 	void						GetDelta( int fromtime, int totime, idVec3& delta ) const;
 	bool						GetDeltaRotation( int fromtime, int totime, idMat3& delta ) const;
@@ -581,6 +584,7 @@ private:
 
 	mutable int					lastTransformTime;		// mutable because the value is updated in CreateFrame
 	mutable bool				stoppedAnimatingUpdate;
+	int							frameAheadTime;			// time of a frame created by the game's animation update that the renderer hasn't picked up yet
 	bool						removeOriginOffset;
 	bool						forceUpdate;
 
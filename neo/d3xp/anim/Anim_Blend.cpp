@@ -3988,6 +3988,7 @@ idAnimator::idAnimator()
 	joints					= NULL;
 	lastTransformTime		= -1;
 	stoppedAnimatingUpdate	= false;
+	frameAheadTime			= -1;
 	removeOriginOffset		= false;
 	forceUpdate				= false;
 
@@ -4154,6 +4155,7 @@ void idAnimator::Restore( idRestoreGame* savefile )
 
 	savefile->ReadInt( lastTransformTime );
 	savefile->ReadBool( stoppedAnimatingUpdate );
+	frameAheadTime = -1;
 	savefile->ReadBool( forceUpdate );
 	savefile->ReadBounds( frameBounds );
 
@@ -5616,6 +5618,66 @@ bool idAnimator::CreateFrame( int currentTime, bool force )
 	return true;
 }
 
+/*
+=====================
+idAnimator::NeedsFrame
+
+  Same early outs as CreateFrame, used by the game to collect the animators to update ahead of the renderer.
+=====================
+*/
+bool idAnimator::NeedsFrame( int currentTime ) const
+{
+	if( !modelDef || !modelDef->ModelHandle() )
+	{
+		return false;
+	}
+
+	if( lastTransformTime == currentTime )
+	{
+		return false;
+	}
+
+	if( lastTransformTime != -1 && !stoppedAnimatingUpdate && !IsAnimating( currentTime ) )
+	{
+		return false;
+	}
+
+	return true;
+}
+
+/*
+=====================
+idAnimator::CreateFrameAhead
+
+  Runs on the job system from the game's animation update, so it may only touch this animator.
+=====================
+*/
+void idAnimator::CreateFrameAhead( int currentTime )
+{
+	if( CreateFrame( currentTime, false ) )
+	{
+		frameAheadTime = currentTime;
+	}
+}
+
+/*
+=====================
+idAnimator::ConsumeFrameAhead
+
+  Returns true once if a frame for currentTime was created ahead and hasn't been invalidated since.
+=====================
+*/
+bool idAnimator::ConsumeFrameAhead( int currentTime )
+{
+	if( frameAheadTime != currentTime || lastTransformTime != currentTime )
+	{
+		return false;
+	}
+
+	frameAheadTime = -1;
+	return true;
+}
+
 /*
 =====================
 idAnimator::ForceUpdate
@@ -50,6 +50,7 @@ instancing of objects.
 static idTypeInfo*				typelist = NULL;
 static idHierarchy<idTypeInfo>	classHierarchy;
 static int						eventCallbackMemory	= 0;
+static idSysMutex				deferredEventLock;		// serializes event allocation from parallel entity thinks
 
 /*
 ================
@@ -635,6 +636,11 @@ idClass::CancelEvents
 */
 void idClass::CancelEvents( const idEventDef* ev )
 {
+	if( gameLocal.DeferThinkOp( THINKOP_CANCEL_EVENTS, this, 0, NULL, ev ) )
+	{
+		return;
+	}
+
 	idEvent::CancelEvents( this, ev );
 }
 
@@ -682,6 +688,19 @@ bool idClass::PostEventArgs( const idEventDef* ev, int time, int numargs, ... )
 		return true;
 	}
 
+	if( gameLocal.IsDeferringThink() )
+	{
+		// posted from an entity thinking on the job system, the event is scheduled when its think is applied
+		deferredEventLock.Lock();
+		va_start( args, numargs );
+		event = idEvent::Alloc( ev, numargs, args );
+		va_end( args );
+		deferredEventLock.Unlock();
+
+		gameLocal.DeferThinkOp( THINKOP_SCHEDULE_EVENT, this, time, event );
+		return true;
+	}
+
 	va_start( args, numargs );
 	event = idEvent::Alloc( ev, numargs, args );
 	va_end( args );
@@ -40,6 +40,8 @@ Event are used for scheduling tasks and for linking script commands.
 #include "../Game_local.h"
 
 #define MAX_EVENTSPERFRAME			4096
+#define EVENT_BLOCK_SIZE			1024		// the event pool grows by this many events at a time
+#define MAX_EVENT_BLOCKS			256
 //#define CREATE_EVENT_CODE
 
 /***********************************************************************
@@ -234,6 +236,275 @@ const idEventDef* idEventDef::FindEvent( const char* name )
 	return NULL;
 }
 
+/***********************************************************************
+
+  idEventHeap
+
+  Binary heap of scheduled events ordered by time. Events scheduled for
+  the same time are serviced in the order they were scheduled in.
+
+***********************************************************************/
+
+class idEventHeap
+{
+public:
+	idEventHeap();
+
+	void						Clear();
+	int							Num() const;
+	idEvent*					First() const;
+	void						Add( idEvent* event );
+	void						Remove( idEvent* event );
+	void						CancelEvents( const idClass* obj, const idEventDef* evdef );
+	void						GetSortedEvents( idList<idEvent*>& list ) const;
+
+	static bool					Before( const idEvent* a, const idEvent* b );
+
+private:
+	idList<idEvent*>			heap;
+	int64						nextSequence;
+
+	void						Set( int index, idEvent* event );
+	void						MoveUp( int index );
+	void						MoveDown( int index );
+};
+
+class idSort_Events : public idSort_Quick< idEvent*, idSort_Events >
+{
+public:
+	int Compare( idEvent* const& a, idEvent* const& b ) const
+	{
+		if( idEventHeap::Before( a, b ) )
+		{
+			return -1;
+		}
+		if( idEventHeap::Before( b, a ) )
+		{
+			return 1;
+		}
+		return 0;
+	}
+};
+
+/*
+================
+idEventHeap::idEventHeap
+================
+*/
+idEventHeap::idEventHeap()
+{
+	heap.SetGranularity( 1024 );
+	nextSequence = 0;
+}
+
+/*
+================
+idEventHeap::Clear
+================
+*/
+void idEventHeap::Clear()
+{
+	for( int i = 0; i < heap.Num(); i++ )
+	{
+		heap[i]->queue = NULL;
+		heap[i]->queueIndex = -1;
+	}
+	heap.Clear();
+	nextSequence = 0;
+}
+
+/*
+================
+idEventHeap::Num
+================
+*/
+int idEventHeap::Num() const
+{
+	return heap.Num();
+}
+
+/*
+================
+idEventHeap::First
+================
+*/
+idEvent* idEventHeap::First() const
+{
+	return ( heap.Num() > 0 ) ? heap[0] : NULL;
+}
+
+/*
+================
+idEventHeap::Before
+================
+*/
+bool idEventHeap::Before( const idEvent* a, const idEvent* b )
+{
+	if( a->time != b->time )
+	{
+		return ( a->time < b->time );
+	}
+	return ( a->sequence < b->sequence );
+}
+
+/*
+================
+idEventHeap::Set
+================
+*/
+void idEventHeap::Set( int index, idEvent* event )
+{
+	heap[index] = event;
+	event->queueIndex = index;
+}
+
+/*
+================
+idEventHeap::MoveUp
+================
+*/
+void idEventHeap::MoveUp( int index )
+{
+	idEvent* event = heap[index];
+	while( index > 0 )
+	{
+		const int parent = ( index - 1 ) >> 1;
+		if( !Before( event, heap[parent] ) )
+		{
+			break;
+		}
+		Set( index, heap[parent] );
+		index = parent;
+	}
+	Set( index, event );
+}
+
+/*
+================
+idEventHeap::MoveDown
+================
+*/
+void idEventHeap::MoveDown( int index )
+{
+	idEvent* event = heap[index];
+	const int num = heap.Num();
+	for( ;; )
+	{
+		int child = index * 2 + 1;
+		if( child >= num )
+		{
+			break;
+		}
+		if( child + 1 < num && Before( heap[child + 1], heap[child] ) )
+		{
+			child++;
+		}
+		if( !Before( heap[child], event ) )
+		{
+			break;
+		}
+		Set( index, heap[child] );
+		index = child;
+	}
+	Set( index, event );
+}
+
+/*
+================
+idEventHeap::Add
+================
+*/
+void idEventHeap::Add( idEvent* event )
+{
+	assert( event->queue == NULL );
+	event->queue = this;
+	event->sequence = nextSequence++;
+	Set( heap.Append( event ), event );
+	MoveUp( event->queueIndex );
+}
+
+/*
+================
+idEventHeap::Remove
+================
+*/
+void idEventHeap::Remove( idEvent* event )
+{
+	assert( event->queue == this && heap[event->queueIndex] == event );
+
+	const int index = event->queueIndex;
+	idEvent* last = heap[heap.Num() - 1];
+	heap.SetNum( heap.Num() - 1 );
+
+	event->queue = NULL;
+	event->queueIndex = -1;
+
+	if( last != event )
+	{
+		Set( index, last );
+		if( index > 0 && Before( last, heap[( index - 1 ) >> 1] ) )
+		{
+			MoveUp( index );
+		}
+		else
+		{
+			MoveDown( index );
+		}
+	}
+}
+
+/*
+================
+idEventHeap::CancelEvents
+
+  frees all events for the object, or only the given events for the object
+================
+*/
+void idEventHeap::CancelEvents( const idClass* obj, const idEventDef* evdef )
+{
+	int num = 0;
+
+	for( int i = 0; i < heap.Num(); i++ )
+	{
+		idEvent* event = heap[i];
+		if( event->object == obj && ( !evdef || ( evdef == event->eventdef ) ) )
+		{
+			event->queue = NULL;
+			event->queueIndex = -1;
+			event->Free();
+		}
+		else
+		{
+			Set( num++, event );
+		}
+	}
+
+	if( num == heap.Num() )
+	{
+		return;
+	}
+
+	// rebuild the heap from the remaining events
+	heap.SetNum( num );
+	for( int i = num / 2 - 1; i >= 0; i-- )
+	{
+		MoveDown( i );
+	}
+}
+
+/*
+================
+idEventHeap::GetSortedEvents
+
+  lists the events in the order they will be serviced
+================
+*/
+void idEventHeap::GetSortedEvents( idList<idEvent*>& list ) const
+{
+	list = heap;
+	list.SortWithTemplate( idSort_Events() );
+}
+
 /***********************************************************************
 
   idEvent
@@ -241,14 +512,31 @@ const idEventDef* idEventDef::FindEvent( const char* name )
 ***********************************************************************/
 
 static idLinkList<idEvent> FreeEvents;
-static idLinkList<idEvent> EventQueue;
-static idLinkList<idEvent> FastEventQueue;
-static idEvent EventPool[ MAX_EVENTS ];
+static idEventHeap EventQueue;
+static idEventHeap FastEventQueue;
+static idList<idEvent*> EventBlocks;
 
 bool idEvent::initialized = false;
 
 idDynamicBlockAlloc<byte, 16 * 1024, 256>	idEvent::eventDataAllocator;
 
+/*
+================
+idEvent::idEvent()
+================
+*/
+idEvent::idEvent()
+{
+	eventdef = NULL;
+	data = NULL;
+	time = 0;
+	object = NULL;
+	typeinfo = NULL;
+	queue = NULL;
+	queueIndex = -1;
+	sequence = 0;
+}
+
 /*
 ================
 idEvent::~idEvent()
@@ -259,6 +547,57 @@ idEvent::~idEvent()
 	Free();
 }
 
+/*
+================
+idEvent::GetFreeEvent
+
+  grows the event pool when all events are in use
+================
+*/
+idEvent* idEvent::GetFreeEvent()
+{
+	idEvent* ev;
+
+	if( FreeEvents.IsListEmpty() )
+	{
+		if( EventBlocks.Num() >= MAX_EVENT_BLOCKS )
+		{
+			gameLocal.Error( "idEvent::GetFreeEvent : No more free events" );
+		}
+
+		idEvent* block = new( TAG_GAME ) idEvent[ EVENT_BLOCK_SIZE ];
+		for( int i = 0; i < EVENT_BLOCK_SIZE; i++ )
+		{
+			block[ i ].Free();
+		}
+		EventBlocks.Append( block );
+	}
+
+	ev = FreeEvents.Next();
+	ev->eventNode.Remove();
+	return ev;
+}
+
+/*
+================
+idEvent::NumQueuedEvents
+================
+*/
+int idEvent::NumQueuedEvents()
+{
+	return EventQueue.Num() + FastEventQueue.Num();
+}
+
+/*
+================
+idEvent::NumAllocatedEvents
+================
+*/
+int idEvent::NumAllocatedEvents()
+{
+	return EventBlocks.Num() * EVENT_BLOCK_SIZE;
+}
+
 /*
 ================
 idEvent::Alloc
@@ -274,13 +613,7 @@ idEvent* idEvent::Alloc( const idEventDef* evdef, int numargs, va_list args )
 	int			i;
 	const char*	materialName;
 
-	if( FreeEvents.IsListEmpty() )
-	{
-		gameLocal.Error( "idEvent::Alloc : No more free events" );
-	}
-
-	ev = FreeEvents.Next();
-	ev->eventNode.Remove();
+	ev = GetFreeEvent();
 
 	ev->eventdef = evdef;
 
@@ -414,6 +747,11 @@ idEvent::Free
 */
 void idEvent::Free()
 {
+	if( queue != NULL )
+	{
+		queue->Remove( this );
+	}
+
 	if( data )
 	{
 		eventDataAllocator.Free( data );
@@ -436,8 +774,6 @@ idEvent::Schedule
 */
 void idEvent::Schedule( idClass* obj, const idTypeInfo* type, int time )
 {
-	idEvent* event;
-
 	assert( initialized );
 	if( !initialized )
 	{
@@ -447,48 +783,21 @@ void idEvent::Schedule( idClass* obj, const idTypeInfo* type, int time )
 	object = obj;
 	typeinfo = type;
 
-	// wraps after 24 days...like I care. ;)
-	this->time = gameLocal.time + time;
-
-	eventNode.Remove();
-
-	if( obj->IsType( idEntity::Type ) && ( ( ( idEntity* )( obj ) )->timeGroup == TIME_GROUP2 ) )
-	{
-		event = FastEventQueue.Next();
-		while( ( event != NULL ) && ( this->time >= event->time ) )
-		{
-			event = event->eventNode.Next();
-		}
-
-		if( event )
-		{
-			eventNode.InsertBefore( event->eventNode );
-		}
-		else
-		{
-			eventNode.AddToEnd( FastEventQueue );
-		}
-
-		return;
-	}
-	else
-	{
-		this->time = gameLocal.slow.time + time;
-	}
-
-	event = EventQueue.Next();
-	while( ( event != NULL ) && ( this->time >= event->time ) )
+	if( queue != NULL )
 	{
-		event = event->eventNode.Next();
+		queue->Remove( this );
 	}
 
-	if( event )
+	// wraps after 24 days...like I care. ;)
+	if( obj->IsType( idEntity::Type ) && ( ( ( idEntity* )( obj ) )->timeGroup == TIME_GROUP2 ) )
 	{
-		eventNode.InsertBefore( event->eventNode );
+		this->time = gameLocal.time + time;
+		FastEventQueue.Add( this );
 	}
 	else
 	{
-		eventNode.AddToEnd( EventQueue );
+		this->time = gameLocal.slow.time + time;
+		EventQueue.Add( this );
 	}
 }
 
@@ -499,37 +808,13 @@ idEvent::CancelEvents
 */
 void idEvent::CancelEvents( const idClass* obj, const idEventDef* evdef )
 {
-	idEvent* event;
-	idEvent* next;
-
 	if( !initialized )
 	{
 		return;
 	}
 
-	for( event = EventQueue.Next(); event != NULL; event = next )
-	{
-		next = event->eventNode.Next();
-		if( event->object == obj )
-		{
-			if( !evdef || ( evdef == event->eventdef ) )
-			{
-				event->Free();
-			}
-		}
-	}
-
-	for( event = FastEventQueue.Next(); event != NULL; event = next )
-	{
-		next = event->eventNode.Next();
-		if( event->object == obj )
-		{
-			if( !evdef || ( evdef == event->eventdef ) )
-			{
-				event->Free();
-			}
-		}
-	}
+	EventQueue.CancelEvents( obj, evdef );
+	FastEventQueue.CancelEvents( obj, evdef );
 }
 
 /*
@@ -546,13 +831,17 @@ void idEvent::ClearEventList()
 	//
 	FreeEvents.Clear();
 	EventQueue.Clear();
+	FastEventQueue.Clear();
 
 	//
 	// add the events to the free list
 	//
-	for( i = 0; i < MAX_EVENTS; i++ )
+	for( i = 0; i < EventBlocks.Num(); i++ )
 	{
-		EventPool[ i ].Free();
+		for( int j = 0; j < EVENT_BLOCK_SIZE; j++ )
+		{
+			EventBlocks[ i ][ j ].Free();
+		}
 	}
 }
 
@@ -561,7 +850,7 @@ void idEvent::ClearEventList()
 idEvent::ServiceEvents
 ================
 */
-void idEvent::ServiceEvents()
+int idEvent::ServiceEvents()
 {
 	idEvent*		event;
 	int			num;
@@ -578,9 +867,9 @@ void idEvent::ServiceEvents()
 	const char*  materialName;
 
 	num = 0;
-	while( !EventQueue.IsListEmpty() )
+	while( EventQueue.Num() > 0 )
 	{
-		event = EventQueue.Next();
+		event = EventQueue.First();
 		assert( event );
 
 		if( event->time > gameLocal.time )
@@ -642,9 +931,9 @@ void idEvent::ServiceEvents()
 			}
 		}
 
-		// the event is removed from its list so that if then object
+		// the event is removed from its queue so that if then object
 		// is deleted, the event won't be freed twice
-		event->eventNode.Remove();
+		event->queue->Remove( event );
 		assert( event->object );
 		event->object->ProcessEventArgPtr( ev, args );
 
@@ -668,6 +957,8 @@ void idEvent::ServiceEvents()
 			gameLocal.Error( "Event overflow.  Possible infinite loop in script." );
 		}
 	}
+
+	return num;
 }
 
 /*
@@ -675,7 +966,7 @@ void idEvent::ServiceEvents()
 idEvent::ServiceFastEvents
 ================
 */
-void idEvent::ServiceFastEvents()
+int idEvent::ServiceFastEvents()
 {
 	idEvent*	event;
 	int			num;
@@ -692,9 +983,9 @@ void idEvent::ServiceFastEvents()
 	const char*  materialName;
 
 	num = 0;
-	while( !FastEventQueue.IsListEmpty() )
+	while( FastEventQueue.Num() > 0 )
 	{
-		event = FastEventQueue.Next();
+		event = FastEventQueue.First();
 		assert( event );
 
 		if( event->time > gameLocal.fast.time )
@@ -754,9 +1045,9 @@ void idEvent::ServiceFastEvents()
 			}
 		}
 
-		// the event is removed from its list so that if then object
+		// the event is removed from its queue so that if then object
 		// is deleted, the event won't be freed twice
-		event->eventNode.Remove();
+		event->queue->Remove( event );
 		assert( event->object );
 		event->object->ProcessEventArgPtr( ev, args );
 
@@ -780,6 +1071,8 @@ void idEvent::ServiceFastEvents()
 			gameLocal.Error( "Event overflow.  Possible infinite loop in script." );
 		}
 	}
+
+	return num;
 }
 
 /*
@@ -836,6 +1129,14 @@ void idEvent::Shutdown()
 
 	ClearEventList();
 
+	// free the event pool
+	FreeEvents.Clear();
+	for( int i = 0; i < EventBlocks.Num(); i++ )
+	{
+		delete[] EventBlocks[ i ];
+	}
+	EventBlocks.Clear();
+
 	eventDataAllocator.Shutdown();
 
 	// say it is now shutdown
@@ -858,12 +1159,16 @@ void idEvent::Save( idSaveGame* savefile )
 	// RB: for missing D_EVENT_STRING
 	idStr s;
 	// RB end
+	idList<idEvent*> events;
+
+	// events are saved in the order they will be serviced
+	EventQueue.GetSortedEvents( events );
 
-	savefile->WriteInt( EventQueue.Num() );
+	savefile->WriteInt( events.Num() );
 
-	event = EventQueue.Next();
-	while( event != NULL )
+	for( int e = 0; e < events.Num(); e++ )
 	{
+		event = events[ e ];
 		savefile->WriteInt( event->time );
 		savefile->WriteString( event->eventdef->GetName() );
 		savefile->WriteString( event->typeinfo->classname );
@@ -933,23 +1238,22 @@ void idEvent::Save( idSaveGame* savefile )
 			}
 		}
 		assert( size == ( int )event->eventdef->GetArgSize() );
-		event = event->eventNode.Next();
 	}
 
 	// Save the Fast EventQueue
-	savefile->WriteInt( FastEventQueue.Num() );
+	FastEventQueue.GetSortedEvents( events );
 
-	event = FastEventQueue.Next();
-	while( event != NULL )
+	savefile->WriteInt( events.Num() );
+
+	for( int e = 0; e < events.Num(); e++ )
 	{
+		event = events[ e ];
 		savefile->WriteInt( event->time );
 		savefile->WriteString( event->eventdef->GetName() );
 		savefile->WriteString( event->typeinfo->classname );
 		savefile->WriteObject( event->object );
 		savefile->WriteInt( event->eventdef->GetArgSize() );
 		savefile->Write( event->data, event->eventdef->GetArgSize() );
-
-		event = event->eventNode.Next();
 	}
 }
 
@@ -974,16 +1278,10 @@ void idEvent::Restore( idRestoreGame* savefile )
 
 	for( i = 0; i < num; i++ )
 	{
-		if( FreeEvents.IsListEmpty() )
-		{
-			gameLocal.Error( "idEvent::Restore : No more free events" );
-		}
-
-		event = FreeEvents.Next();
-		event->eventNode.Remove();
-		event->eventNode.AddToEnd( EventQueue );
+		event = GetFreeEvent();
 
 		savefile->ReadInt( event->time );
+		EventQueue.Add( event );
 
 		// read the event name
 		savefile->ReadString( name );
@@ -1092,16 +1390,10 @@ void idEvent::Restore( idRestoreGame* savefile )
 
 	for( i = 0; i < num; i++ )
 	{
-		if( FreeEvents.IsListEmpty() )
-		{
-			gameLocal.Error( "idEvent::Restore : No more free events" );
-		}
-
-		event = FreeEvents.Next();
-		event->eventNode.Remove();
-		event->eventNode.AddToEnd( FastEventQueue );
+		event = GetFreeEvent();
 
 		savefile->ReadInt( event->time );
+		FastEventQueue.Add( event );
 
 		// read the event name
 		savefile->ReadString( name );
@@ -91,9 +91,12 @@ public:
 
 class idSaveGame;
 class idRestoreGame;
+class idEventHeap;
 
 class idEvent
 {
+	friend class idEventHeap;
+
 private:
 	const idEventDef*			eventdef;
 	byte*						data;
@@ -101,14 +104,21 @@ private:
 	idClass*						object;
 	const idTypeInfo*			typeinfo;
 
-	idLinkList<idEvent>			eventNode;
+	idLinkList<idEvent>			eventNode;				// node in the free list
+
+	idEventHeap*				queue;					// queue the event is scheduled in
+	int							queueIndex;				// index in the queue heap
+	int64						sequence;				// orders events scheduled for the same time
 
 	static idDynamicBlockAlloc<byte, 16 * 1024, 256> eventDataAllocator;
 
+	static idEvent*				GetFreeEvent();
+
 
 public:
 	static bool					initialized;
 
+	idEvent();
 	~idEvent();
 
 	static idEvent*				Alloc( const idEventDef* evdef, int numargs, va_list args );
@@ -122,11 +132,14 @@ public:
 
 	static void					CancelEvents( const idClass* obj, const idEventDef* evdef = NULL );
 	static void					ClearEventList();
-	static void					ServiceEvents();
-	static void					ServiceFastEvents();
+	static int					ServiceEvents();			// returns the number of events serviced
+	static int					ServiceFastEvents();
 	static void					Init();
 	static void					Shutdown();
 
+	static int					NumQueuedEvents();
+	static int					NumAllocatedEvents();
+
 	// save games
 	static void					Save( idSaveGame* savefile );					// archives object for save game file
 	static void					Restore( idRestoreGame* savefile );				// unarchives object from save game file
@@ -1572,6 +1572,16 @@ static void Cmd_CollisionModelInfo_f( const idCmdArgs& args )
 	}
 }
 
+/*
+==================
+Cmd_ClipIndexStats_f
+==================
+*/
+static void Cmd_ClipIndexStats_f( const idCmdArgs& args )
+{
+	gameLocal.clip.PrintIndexStatistics( args.Argc() > 1 && !idStr::Icmp( args.Argv( 1 ), "reset" ) );
+}
+
 /*
 ==================
 Cmd_ReloadAnims_f
@@ -2328,6 +2338,94 @@ static void Cmd_DisasmScript_f( const idCmdArgs& args )
 	gameLocal.program.Disassemble();
 }
 
+/*
+==================
+Cmd_ScriptBenchmark_f
+
+Calls a script function a number of times with and without the resolved statements.
+==================
+*/
+static void Cmd_ScriptBenchmark_f( const idCmdArgs& args )
+{
+	const function_t*	func;
+	idThread*			thread;
+	idTimer				timer;
+	double				time[ 2 ];
+	int					i, count, pass;
+	bool				optimize;
+
+	if( !gameLocal.CheatsOk() )
+	{
+		return;
+	}
+
+	if( args.Argc() < 2 )
+	{
+		gameLocal.Printf( "usage: scriptBenchmark <function> [count]\n" );
+		return;
+	}
+
+	func = gameLocal.program.FindFunction( args.Argv( 1 ) );
+	if( func == NULL || func->eventdef != NULL )
+	{
+		gameLocal.Printf( "script function '%s' not found\n", args.Argv( 1 ) );
+		return;
+	}
+	if( func->parmTotal )
+	{
+		gameLocal.Printf( "script function '%s' can't take any parameters\n", func->Name() );
+		return;
+	}
+
+	count = 1000;
+	if( args.Argc() > 2 )
+	{
+		count = Max( 1, atoi( args.Argv( 2 ) ) );
+	}
+
+	optimize = g_optimizeScripts.GetBool();
+
+	thread = new idThread();
+	thread->ManualDelete();
+	thread->ManualControl();
+
+	for( pass = 0; pass < 2; pass++ )
+	{
+		g_optimizeScripts.SetBool( pass != 0 );
+
+		timer.Clear();
+		timer.Start();
+		for( i = 0; i < count; i++ )
+		{
+			thread->CallFunction( func, true );
+			if( !thread->Execute() )
+			{
+				break;
+			}
+		}
+		timer.Stop();
+
+		if( i < count )
+		{
+			gameLocal.Printf( "script function '%s' waits, it can't be benchmarked\n", func->Name() );
+			break;
+		}
+		time[ pass ] = timer.Milliseconds();
+	}
+
+	g_optimizeScripts.SetBool( optimize );
+	delete thread;
+
+	if( pass < 2 )
+	{
+		return;
+	}
+
+	gameLocal.Printf( "%s, %d calls\n", func->Name(), count );
+	gameLocal.Printf( "%10.1f ns/op generic\n", time[ 0 ] * 1000000.0 / count );
+	gameLocal.Printf( "%10.1f ns/op resolved (%.2fx)\n", time[ 1 ] * 1000000.0 / count, time[ 1 ] > 0.0 ? time[ 0 ] / time[ 1 ] : 0.0 );
+}
+
 /*
 ==================
 Cmd_TestSave_f
@@ -2836,6 +2934,7 @@ void idGameLocal::InitConsoleCommands()
 	cmdSystem->AddCommand( "script",				Cmd_Script_f,				CMD_FL_GAME | CMD_FL_CHEAT,	"executes a line of script" );
 	cmdSystem->AddCommand( "listCollisionModels",	Cmd_ListCollisionModels_f,	CMD_FL_GAME,				"lists collision models" );
 	cmdSystem->AddCommand( "collisionModelInfo",	Cmd_CollisionModelInfo_f,	CMD_FL_GAME,				"shows collision model info" );
+	cmdSystem->AddCommand( "clipIndexStats",		Cmd_ClipIndexStats_f,		CMD_FL_GAME,				"compares link and query costs of the clip sectors and the dynamic clip tree, usage: clipIndexStats [reset]" );
 	cmdSystem->AddCommand( "reloadanims",			Cmd_ReloadAnims_f,			CMD_FL_GAME | CMD_FL_CHEAT,	"reloads animations" );
 	cmdSystem->AddCommand( "listAnims",				Cmd_ListAnims_f,			CMD_FL_GAME,				"lists all animations" );
 	cmdSystem->AddCommand( "aasStats",				Cmd_AASStats_f,				CMD_FL_GAME,				"shows AAS stats" );
@@ -2853,6 +2952,8 @@ void idGameLocal::InitConsoleCommands()
 	cmdSystem->AddCommand( "gameError",				Cmd_GameError_f,			CMD_FL_GAME | CMD_FL_CHEAT,	"causes a game error" );
 
 	cmdSystem->AddCommand( "disasmScript",			Cmd_DisasmScript_f,			CMD_FL_GAME | CMD_FL_CHEAT,	"disassembles script" );
+	cmdSystem->AddCommand( "scriptProfile",			idScriptProfiler::Profile_f,	CMD_FL_GAME | CMD_FL_CHEAT,	"prints the script profile, 'scriptProfile clear' resets it and 'scriptProfile write [file]' writes folded stacks for flame graphs" );
+	cmdSystem->AddCommand( "scriptBenchmark",		Cmd_ScriptBenchmark_f,		CMD_FL_GAME | CMD_FL_CHEAT,	"times a script function with and without the resolved statements" );
 	cmdSystem->AddCommand( "recordViewNotes",		Cmd_RecordViewNotes_f,		CMD_FL_GAME | CMD_FL_CHEAT,	"record the current view position with notes" );
 	cmdSystem->AddCommand( "showViewNotes",			Cmd_ShowViewNotes_f,		CMD_FL_GAME | CMD_FL_CHEAT,	"show any view notes for the current map, successive calls will cycle to the next note" );
 	cmdSystem->AddCommand( "closeViewNotes",		Cmd_CloseViewNotes_f,		CMD_FL_GAME | CMD_FL_CHEAT,	"close the view showing any notes for this map" );
@@ -89,6 +89,8 @@ idCVar g_debugMove(					"g_debugMove",				"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_debugDamage(				"g_debugDamage",			"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_debugWeapon(				"g_debugWeapon",			"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_debugScript(				"g_debugScript",			"0",			CVAR_GAME | CVAR_BOOL, "" );
+idCVar g_scriptProfile(				"g_scriptProfile",			"0",			CVAR_GAME | CVAR_BOOL, "charges script time and instructions to functions and events, see scriptProfile" );
+idCVar g_optimizeScripts(			"g_optimizeScripts",		"1",			CVAR_GAME | CVAR_BOOL, "run scripts from the resolved statements with fused opcodes" );
 idCVar g_debugMover(				"g_debugMover",				"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_debugTriggers(				"g_debugTriggers",			"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_debugCinematic(			"g_debugCinematic",			"0",			CVAR_GAME | CVAR_BOOL, "" );
@@ -110,6 +112,8 @@ idCVar g_showCollisionWorld(		"g_showCollisionWorld",		"0",			CVAR_GAME | CVAR_B
 idCVar g_showCollisionModels(		"g_showCollisionModels",	"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_showCollisionTraces(		"g_showCollisionTraces",	"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_maxShowDistance(			"g_maxShowDistance",		"128",			CVAR_GAME | CVAR_FLOAT, "" );
+idCVar g_clipTree(					"g_clipTree",				"0",			CVAR_GAME | CVAR_BOOL, "link clip models into a dynamic bounding volume tree instead of the clip sectors, takes effect on map load" );
+idCVar g_clipIndexStats(			"g_clipIndexStats",			"0",			CVAR_GAME | CVAR_BOOL, "time clip model links and queries for clipIndexStats" );
 idCVar g_showEntityInfo(			"g_showEntityInfo",			"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_showviewpos(				"g_showviewpos",			"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_showcamerainfo(			"g_showcamerainfo",			"0",			CVAR_GAME | CVAR_ARCHIVE, "displays the current frame # for the camera when playing cinematics" );
@@ -118,6 +122,10 @@ idCVar g_showActiveEntities(		"g_showActiveEntities",		"0",			CVAR_GAME | CVAR_B
 idCVar g_showEnemies(				"g_showEnemies",			"0",			CVAR_GAME | CVAR_BOOL, "draws boxes around monsters that have targeted the the player" );
 
 idCVar g_frametime(					"g_frametime",				"0",			CVAR_GAME | CVAR_BOOL, "displays timing information for each game frame" );
+idCVar g_eventStats(				"g_eventStats",				"0",			CVAR_GAME | CVAR_BOOL, "displays the number of events serviced each game frame and the time it took" );
+idCVar g_parallelThink(				"g_parallelThink",			"0",			CVAR_GAME | CVAR_BOOL, "run the think of think-isolated entities on the job threads, ignored while g_timeEntities is set or during cinematics" );
+idCVar g_parallelThinkMinEntities(	"g_parallelThinkMinEntities", "32",		CVAR_GAME | CVAR_INTEGER, "minimum number of think-isolated entities before their thinks are sent to the job threads" );
+idCVar g_parallelAnimation(			"g_parallelAnimation",		"1",			CVAR_GAME | CVAR_BOOL, "create the animation frames of visible entities on the job threads at the end of the game frame" );
 idCVar g_timeentities(				"g_timeEntities",			"0",			CVAR_GAME | CVAR_FLOAT, "when non-zero, shows entities whose think functions exceeded the # of milliseconds specified" );
 
 idCVar g_debugShockwave(			"g_debugShockwave",			"0",			CVAR_GAME | CVAR_BOOL, "Debug the shockwave" );
@@ -309,6 +317,7 @@ idCVar aas_pullPlayer(				"aas_pullPlayer",			"0",			CVAR_GAME | CVAR_INTEGER, "
 idCVar aas_randomPullPlayer(		"aas_randomPullPlayer",		"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar aas_goalArea(				"aas_goalArea",				"0",			CVAR_GAME | CVAR_INTEGER, "" );
 idCVar aas_showPushIntoArea(		"aas_showPushIntoArea",		"0",			CVAR_GAME | CVAR_BOOL, "" );
+idCVar aas_precomputeRouting(		"aas_precomputeRouting",	"0",			CVAR_GAME | CVAR_BOOL, "build the portal routing cache towards every area on the job threads at map load and keep it in a generated file next to the aas file" );
 
 idCVar g_countDown(					"g_countDown",				"15",			CVAR_GAME | CVAR_INTEGER | CVAR_ARCHIVE, "pregame countdown in seconds", 4, 3600 );
 idCVar g_gameReviewPause(			"g_gameReviewPause",		"10",			CVAR_GAME | CVAR_NETWORKSYNC | CVAR_INTEGER | CVAR_ARCHIVE, "scores review time in seconds (at end game)", 2, 3600 );
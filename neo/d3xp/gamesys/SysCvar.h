@@ -51,6 +51,8 @@ extern idCVar	g_debugMove;
 extern idCVar	g_debugDamage;
 extern idCVar	g_debugWeapon;
 extern idCVar	g_debugScript;
+extern idCVar	g_optimizeScripts;
+extern idCVar	g_scriptProfile;
 extern idCVar	g_debugMover;
 extern idCVar	g_debugTriggers;
 extern idCVar	g_debugCinematic;
@@ -70,6 +72,8 @@ extern idCVar	g_showCollisionWorld;
 extern idCVar	g_showCollisionModels;
 extern idCVar	g_showCollisionTraces;
 extern idCVar	g_maxShowDistance;
+extern idCVar	g_clipTree;
+extern idCVar	g_clipIndexStats;
 extern idCVar	g_showEntityInfo;
 extern idCVar	g_showviewpos;
 extern idCVar	g_showcamerainfo;
@@ -78,6 +82,10 @@ extern idCVar	g_showActiveEntities;
 extern idCVar	g_showEnemies;
 
 extern idCVar	g_frametime;
+extern idCVar	g_eventStats;
+extern idCVar	g_parallelThink;
+extern idCVar	g_parallelThinkMinEntities;
+extern idCVar	g_parallelAnimation;
 extern idCVar	g_timeentities;
 
 extern idCVar	ai_debugScript;
@@ -249,6 +257,7 @@ extern idCVar	aas_pullPlayer;
 extern idCVar	aas_randomPullPlayer;
 extern idCVar	aas_goalArea;
 extern idCVar	aas_showPushIntoArea;
+extern idCVar	aas_precomputeRouting;
 
 extern idCVar	net_clientPredictGUI;
 
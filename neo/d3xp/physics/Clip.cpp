@@ -65,6 +65,531 @@ idVec3 vec3_boxEpsilon( CM_BOX_EPSILON, CM_BOX_EPSILON, CM_BOX_EPSILON );
 
 idBlockAlloc<clipLink_t, 1024>	clipLinkAllocator;
 
+/*
+===============================================================
+
+	idClipTree
+
+	Dynamic bounding volume tree used instead of the clip sectors when
+	g_clipTree is set at map load. Each linked clip model has a single
+	leaf with bounds fattened by CLIP_TREE_MARGIN so small moves don't
+	change the tree, the leaf is only reinserted when the clip model
+	moves outside of the fattened bounds. A clip model keeps its leaf
+	while unlinked so unlinking and relinking at about the same spot is
+	cheap. The tree is kept balanced with rotations.
+
+===============================================================
+*/
+
+#define CLIP_TREE_MARGIN			8.0f
+#define CLIP_TREE_STACK_SIZE		256
+
+typedef struct clipTreeNode_s
+{
+	idBounds				bounds;			// fattened bounds for leaves
+	idClipModel* 			clipModel;		// NULL for internal nodes
+	int						parent;			// next free node when on the free list
+	int						children[2];
+	int						height;			// 0 for leaves, -1 for free nodes
+} clipTreeNode_t;
+
+class idClipTree
+{
+
+	friend class idClip;
+
+public:
+	idClipTree();
+
+	int						Insert( idClipModel* clipModel, const idBounds& bounds );
+	void					Remove( int leaf );
+	bool					Move( int leaf, const idBounds& bounds );	// returns true if the leaf was reinserted
+
+	int						GetNumLeaves() const;
+	int						GetNumNodes() const;
+	int						GetHeight() const;
+	int						GetNumVisits() const;		// nodes visited by inserts and removes
+
+private:
+	idList<clipTreeNode_t>	nodes;
+	int						root;
+	int						freeList;
+	int						numLeaves;
+	int						numVisits;
+
+	int						AllocNode();
+	void					FreeNode( int node );
+	void					InsertLeaf( int leaf );
+	void					RemoveLeaf( int leaf );
+	int						Balance( int node );
+	void					Refit( int node );
+};
+
+/*
+================
+ClipTree_Area
+
+  half the surface area
+================
+*/
+static ID_INLINE float ClipTree_Area( const idBounds& bounds )
+{
+	const idVec3 size = bounds[1] - bounds[0];
+	return size[0] * size[1] + size[1] * size[2] + size[2] * size[0];
+}
+
+/*
+================
+idClipTree::idClipTree
+================
+*/
+idClipTree::idClipTree()
+{
+	nodes.SetGranularity( 1024 );
+	root = -1;
+	freeList = -1;
+	numLeaves = 0;
+	numVisits = 0;
+}
+
+/*
+================
+idClipTree::GetNumLeaves
+================
+*/
+int idClipTree::GetNumLeaves() const
+{
+	return numLeaves;
+}
+
+/*
+================
+idClipTree::GetNumNodes
+================
+*/
+int idClipTree::GetNumNodes() const
+{
+	return ( numLeaves > 0 ) ? numLeaves * 2 - 1 : 0;
+}
+
+/*
+================
+idClipTree::GetHeight
+================
+*/
+int idClipTree::GetHeight() const
+{
+	return ( root != -1 ) ? nodes[root].height : 0;
+}
+
+/*
+================
+idClipTree::GetNumVisits
+================
+*/
+int idClipTree::GetNumVisits() const
+{
+	return numVisits;
+}
+
+/*
+================
+idClipTree::AllocNode
+================
+*/
+int idClipTree::AllocNode()
+{
+	int node;
+
+	if( freeList != -1 )
+	{
+		node = freeList;
+		freeList = nodes[node].parent;
+	}
+	else
+	{
+		node = nodes.Num();
+		nodes.Alloc();
+	}
+
+	clipTreeNode_t& n = nodes[node];
+	n.bounds.Clear();
+	n.clipModel = NULL;
+	n.parent = -1;
+	n.children[0] = n.children[1] = -1;
+	n.height = 0;
+	return node;
+}
+
+/*
+================
+idClipTree::FreeNode
+================
+*/
+void idClipTree::FreeNode( int node )
+{
+	nodes[node].clipModel = NULL;
+	nodes[node].height = -1;
+	nodes[node].parent = freeList;
+	freeList = node;
+}
+
+/*
+================
+idClipTree::Insert
+================
+*/
+int idClipTree::Insert( idClipModel* clipModel, const idBounds& bounds )
+{
+	const int leaf = AllocNode();
+	nodes[leaf].bounds = bounds.Expand( CLIP_TREE_MARGIN );
+	nodes[leaf].clipModel = clipModel;
+	InsertLeaf( leaf );
+	numLeaves++;
+	return leaf;
+}
+
+/*
+================
+idClipTree::Remove
+================
+*/
+void idClipTree::Remove( int leaf )
+{
+	assert( leaf >= 0 && leaf < nodes.Num() && nodes[leaf].height == 0 );
+	RemoveLeaf( leaf );
+	FreeNode( leaf );
+	numLeaves--;
+}
+
+/*
+================
+idClipTree::Move
+================
+*/
+bool idClipTree::Move( int leaf, const idBounds& bounds )
+{
+	const idBounds& fatBounds = nodes[leaf].bounds;
+
+	if( fatBounds.ContainsPoint( bounds[0] ) && fatBounds.ContainsPoint( bounds[1] ) )
+	{
+		return false;
+	}
+
+	RemoveLeaf( leaf );
+	nodes[leaf].bounds = bounds.Expand( CLIP_TREE_MARGIN );
+	InsertLeaf( leaf );
+	return true;
+}
+
+/*
+================
+idClipTree::InsertLeaf
+
+  walks down the cheapest path by surface area and pairs the leaf with the node found there
+================
+*/
+void idClipTree::InsertLeaf( int leaf )
+{
+	if( root == -1 )
+	{
+		root = leaf;
+		nodes[root].parent = -1;
+		return;
+	}
+
+	const idBounds leafBounds = nodes[leaf].bounds;
+
+	int index = root;
+	while( nodes[index].height > 0 )
+	{
+		const clipTreeNode_t& node = nodes[index];
+		const float area = ClipTree_Area( node.bounds );
+		const float combinedArea = ClipTree_Area( node.bounds + leafBounds );
+
+		// cost of creating a new parent for this node and the new leaf
+		const float cost = 2.0f * combinedArea;
+
+		// minimum cost of pushing the leaf further down the tree
+		const float inheritanceCost = 2.0f * ( combinedArea - area );
+
+		float childCost[2];
+		for( int i = 0; i < 2; i++ )
+		{
+			const clipTreeNode_t& child = nodes[node.children[i]];
+			childCost[i] = ClipTree_Area( child.bounds + leafBounds ) + inheritanceCost;
+			if( child.height > 0 )
+			{
+				childCost[i] -= ClipTree_Area( child.bounds );
+			}
+		}
+
+		numVisits++;
+
+		if( cost < childCost[0] && cost < childCost[1] )
+		{
+			break;
+		}
+
+		index = ( childCost[0] < childCost[1] ) ? node.children[0] : node.children[1];
+	}
+
+	const int sibling = index;
+	const int oldParent = nodes[sibling].parent;
+	const int newParent = AllocNode();
+
+	clipTreeNode_t& parent = nodes[newParent];
+	parent.parent = oldParent;
+	parent.bounds = leafBounds + nodes[sibling].bounds;
+	parent.height = nodes[sibling].height + 1;
+	parent.children[0] = sibling;
+	parent.children[1] = leaf;
+
+	if( oldParent != -1 )
+	{
+		if( nodes[oldParent].children[0] == sibling )
+		{
+			nodes[oldParent].children[0] = newParent;
+		}
+		else
+		{
+			nodes[oldParent].children[1] = newParent;
+		}
+	}
+	else
+	{
+		root = newParent;
+	}
+	nodes[sibling].parent = newParent;
+	nodes[leaf].parent = newParent;
+
+	Refit( nodes[leaf].parent );
+}
+
+/*
+================
+idClipTree::RemoveLeaf
+================
+*/
+void idClipTree::RemoveLeaf( int leaf )
+{
+	if( leaf == root )
+	{
+		root = -1;
+		return;
+	}
+
+	const int parent = nodes[leaf].parent;
+	const int grandParent = nodes[parent].parent;
+	const int sibling = ( nodes[parent].children[0] == leaf ) ? nodes[parent].children[1] : nodes[parent].children[0];
+
+	if( grandParent != -1 )
+	{
+		// connect the sibling to the grand parent
+		if( nodes[grandParent].children[0] == parent )
+		{
+			nodes[grandParent].children[0] = sibling;
+		}
+		else
+		{
+			nodes[grandParent].children[1] = sibling;
+		}
+		nodes[sibling].parent = grandParent;
+		FreeNode( parent );
+
+		Refit( grandParent );
+	}
+	else
+	{
+		root = sibling;
+		nodes[sibling].parent = -1;
+		FreeNode( parent );
+	}
+}
+
+/*
+================
+idClipTree::Refit
+
+  rebalances and updates the bounds and heights from the node up to the root
+================
+*/
+void idClipTree::Refit( int node )
+{
+	while( node != -1 )
+	{
+		node = Balance( node );
+
+		clipTreeNode_t& n = nodes[node];
+		const clipTreeNode_t& child0 = nodes[n.children[0]];
+		const clipTreeNode_t& child1 = nodes[n.children[1]];
+
+		n.height = 1 + Max( child0.height, child1.height );
+		n.bounds = child0.bounds + child1.bounds;
+
+		numVisits++;
+		node = n.parent;
+	}
+}
+
+/*
+================
+idClipTree::Balance
+
+  rotates the taller child up if the children of the node are unbalanced, returns the new root of the sub tree
+================
+*/
+int idClipTree::Balance( int iA )
+{
+	clipTreeNode_t& A = nodes[iA];
+
+	if( A.height < 2 )
+	{
+		return iA;
+	}
+
+	const int iB = A.children[0];
+	const int iC = A.children[1];
+	clipTreeNode_t& B = nodes[iB];
+	clipTreeNode_t& C = nodes[iC];
+
+	const int balance = C.height - B.height;
+
+	if( balance > 1 )
+	{
+		// rotate C up
+		const int iF = C.children[0];
+		const int iG = C.children[1];
+		clipTreeNode_t& F = nodes[iF];
+		clipTreeNode_t& G = nodes[iG];
+
+		C.children[0] = iA;
+		C.parent = A.parent;
+		A.parent = iC;
+
+		if( C.parent != -1 )
+		{
+			if( nodes[C.parent].children[0] == iA )
+			{
+				nodes[C.parent].children[0] = iC;
+			}
+			else
+			{
+				nodes[C.parent].children[1] = iC;
+			}
+		}
+		else
+		{
+			root = iC;
+		}
+
+		if( F.height > G.height )
+		{
+			C.children[1] = iF;
+			A.children[1] = iG;
+			G.parent = iA;
+			A.bounds = B.bounds + G.bounds;
+			C.bounds = A.bounds + F.bounds;
+			A.height = 1 + Max( B.height, G.height );
+			C.height = 1 + Max( A.height, F.height );
+		}
+		else
+		{
+			C.children[1] = iG;
+			A.children[1] = iF;
+			F.parent = iA;
+			A.bounds = B.bounds + F.bounds;
+			C.bounds = A.bounds + G.bounds;
+			A.height = 1 + Max( B.height, F.height );
+			C.height = 1 + Max( A.height, G.height );
+		}
+		return iC;
+	}
+
+	if( balance < -1 )
+	{
+		// rotate B up
+		const int iD = B.children[0];
+		const int iE = B.children[1];
+		clipTreeNode_t& D = nodes[iD];
+		clipTreeNode_t& E = nodes[iE];
+
+		B.children[0] = iA;
+		B.parent = A.parent;
+		A.parent = iB;
+
+		if( B.parent != -1 )
+		{
+			if( nodes[B.parent].children[0] == iA )
+			{
+				nodes[B.parent].children[0] = iB;
+			}
+			else
+			{
+				nodes[B.parent].children[1] = iB;
+			}
+		}
+		else
+		{
+			root = iB;
+		}
+
+		if( D.height > E.height )
+		{
+			B.children[1] = iD;
+			A.children[0] = iE;
+			E.parent = iA;
+			A.bounds = C.bounds + E.bounds;
+			B.bounds = A.bounds + D.bounds;
+			A.height = 1 + Max( C.height, E.height );
+			B.height = 1 + Max( A.height, D.height );
+		}
+		else
+		{
+			B.children[1] = iE;
+			A.children[0] = iD;
+			D.parent = iA;
+			A.bounds = C.bounds + D.bounds;
+			B.bounds = A.bounds + E.bounds;
+			A.height = 1 + Max( C.height, D.height );
+			B.height = 1 + Max( A.height, E.height );
+		}
+		return iB;
+	}
+
+	return iA;
+}
+
+
+/*
+===============================================================
+
+	Clip index statistics
+
+===============================================================
+*/
+
+typedef struct clipIndexStats_s
+{
+	int						numLinks;
+	int						numLinkNodes;		// sector links or tree nodes visited by links
+	int						numReinserts;		// links that had to reinsert the tree leaf
+	int						numUnlinks;
+	int						numQueries;
+	int						numQueryNodes;		// sectors or tree nodes visited by queries
+	int						numQueryModels;		// clip models tested by queries
+	idTimer					linkTime;
+	idTimer					queryTime;
+} clipIndexStats_t;
+
+enum
+{
+	CLIP_INDEX_SECTORS,
+	CLIP_INDEX_TREE
+};
+
+static clipIndexStats_t			clipIndexStats[2];
+
 
 /*
 ===============================================================
@@ -410,6 +935,9 @@ void idClipModel::Init()
 	renderModelHandle = -1;
 	traceModelIndex = -1;
 	clipLinks = NULL;
+	clipTree = NULL;
+	clipTreeLeaf = -1;
+	clipTreeLinked = false;
 	touchCount = -1;
 }
 
@@ -493,6 +1021,9 @@ idClipModel::idClipModel( const idClipModel* model )
 	}
 	renderModelHandle = model->renderModelHandle;
 	clipLinks = NULL;
+	clipTree = NULL;
+	clipTreeLeaf = -1;
+	clipTreeLinked = false;
 	touchCount = -1;
 }
 
@@ -505,6 +1036,10 @@ idClipModel::~idClipModel()
 {
 	// make sure the clip model is no longer linked
 	Unlink();
+	if( clipTree != NULL )
+	{
+		clipTree->Remove( clipTreeLeaf );
+	}
 	if( traceModelIndex != -1 )
 	{
 		FreeTraceModel( traceModelIndex );
@@ -538,7 +1073,7 @@ void idClipModel::Save( idSaveGame* savefile ) const
 	}
 	savefile->WriteInt( traceModelIndex );
 	savefile->WriteInt( renderModelHandle );
-	savefile->WriteBool( clipLinks != NULL );
+	savefile->WriteBool( IsLinked() );
 	savefile->WriteInt( touchCount );
 }
 
@@ -599,7 +1134,7 @@ idClipModel::SetPosition
 */
 void idClipModel::SetPosition( const idVec3& newOrigin, const idMat3& newAxis )
 {
-	if( clipLinks )
+	if( IsLinked() )
 	{
 		Unlink();	// unlink from old position
 	}
@@ -658,6 +1193,18 @@ void idClipModel::Unlink()
 {
 	clipLink_t* link;
 
+	// keep the tree leaf so linking again near the same spot doesn't change the tree
+	if( clipTreeLinked )
+	{
+		clipTreeLinked = false;
+		clipIndexStats[CLIP_INDEX_TREE].numUnlinks++;
+	}
+
+	if( clipLinks )
+	{
+		clipIndexStats[CLIP_INDEX_SECTORS].numUnlinks++;
+	}
+
 	for( link = clipLinks; link; link = clipLinks )
 	{
 		clipLinks = link->nextLink;
@@ -703,6 +1250,8 @@ void idClipModel::Link_r( struct clipSector_s* node )
 		}
 	}
 
+	clipIndexStats[CLIP_INDEX_SECTORS].numLinkNodes++;
+
 	link = clipLinkAllocator.Alloc();
 	link->clipModel = this;
 	link->sector = node;
@@ -731,7 +1280,7 @@ void idClipModel::Link( idClip& clp )
 		return;
 	}
 
-	if( clipLinks )
+	if( IsLinked() )
 	{
 		Unlink();	// unlink from old position
 	}
@@ -741,6 +1290,14 @@ void idClipModel::Link( idClip& clp )
 		return;
 	}
 
+	clipIndexStats_t& stats = clipIndexStats[( clp.clipTree != NULL ) ? CLIP_INDEX_TREE : CLIP_INDEX_SECTORS];
+	const bool timeLink = g_clipIndexStats.GetBool();
+	if( timeLink )
+	{
+		stats.linkTime.Start();
+	}
+	stats.numLinks++;
+
 	// set the abs box
 	if( axis.IsRotated() )
 	{
@@ -759,7 +1316,31 @@ void idClipModel::Link( idClip& clp )
 	absBounds[0] -= vec3_boxEpsilon;
 	absBounds[1] += vec3_boxEpsilon;
 
-	Link_r( clp.clipSectors );
+	if( clp.clipTree != NULL )
+	{
+		const int numVisits = clp.clipTree->GetNumVisits();
+		if( clipTree == NULL )
+		{
+			clipTree = clp.clipTree;
+			clipTreeLeaf = clipTree->Insert( this, absBounds );
+		}
+		else if( clipTree->Move( clipTreeLeaf, absBounds ) )
+		{
+			stats.numReinserts++;
+		}
+		assert( clipTree == clp.clipTree );
+		clipTreeLinked = true;
+		stats.numLinkNodes += clp.clipTree->GetNumVisits() - numVisits;
+	}
+	else
+	{
+		Link_r( clp.clipSectors );
+	}
+
+	if( timeLink )
+	{
+		stats.linkTime.Stop();
+	}
 }
 
 /*
@@ -814,6 +1395,7 @@ idClip::idClip()
 {
 	numClipSectors = 0;
 	clipSectors = NULL;
+	clipTree = NULL;
 	worldBounds.Zero();
 	numRotations = numTranslations = numMotions = numRenderModelTraces = numContents = numContacts = 0;
 }
@@ -904,6 +1486,13 @@ void idClip::Init()
 	gameLocal.Printf( "map bounds are (%1.1f, %1.1f, %1.1f)\n", size[0], size[1], size[2] );
 	gameLocal.Printf( "max clip sector is (%1.1f, %1.1f, %1.1f)\n", maxSector[0], maxSector[1], maxSector[2] );
 
+	// link clip models into a dynamic tree instead of the sectors
+	if( g_clipTree.GetBool() )
+	{
+		clipTree = new( TAG_PHYSICS_CLIP ) idClipTree;
+		gameLocal.Printf( "using dynamic clip tree\n" );
+	}
+
 	// initialize a default clip model
 	defaultClipModel.LoadModel( defaultTraceModel );
 
@@ -921,6 +1510,23 @@ void idClip::Shutdown()
 	delete[] clipSectors;
 	clipSectors = NULL;
 
+	if( clipTree != NULL )
+	{
+		// clip models that are still around lose their leaf
+		for( int i = 0; i < clipTree->nodes.Num(); i++ )
+		{
+			idClipModel* clipModel = clipTree->nodes[i].clipModel;
+			if( clipModel != NULL && clipTree->nodes[i].height == 0 )
+			{
+				clipModel->clipTree = NULL;
+				clipModel->clipTreeLeaf = -1;
+				clipModel->clipTreeLinked = false;
+			}
+		}
+		delete clipTree;
+		clipTree = NULL;
+	}
+
 	// free the trace model used for the temporaryClipModel
 	if( temporaryClipModel.traceModelIndex != -1 )
 	{
@@ -954,9 +1560,11 @@ typedef struct listParms_s
 
 void idClip::ClipModelsTouchingBounds_r( const struct clipSector_s* node, listParms_t& parms ) const
 {
+	clipIndexStats_t& stats = clipIndexStats[CLIP_INDEX_SECTORS];
 
 	while( node->axis != -1 )
 	{
+		stats.numQueryNodes++;
 		if( parms.bounds[0][node->axis] > node->dist )
 		{
 			node = node->children[0];
@@ -972,49 +1580,122 @@ void idClip::ClipModelsTouchingBounds_r( const struct clipSector_s* node, listPa
 		}
 	}
 
+	stats.numQueryNodes++;
+
 	for( clipLink_t* link = node->clipLinks; link; link = link->nextInSector )
 	{
-		idClipModel*	check = link->clipModel;
-
-		// if the clip model is enabled
-		if( !check->enabled )
+		stats.numQueryModels++;
+		if( !AddTouchingClipModel( link->clipModel, parms ) )
 		{
-			continue;
+			return;
 		}
+	}
+}
 
-		// avoid duplicates in the list
-		if( check->touchCount == touchCount )
-		{
-			continue;
-		}
+/*
+====================
+idClip::ClipModelsTouchingTree
+====================
+*/
+void idClip::ClipModelsTouchingTree( listParms_t& parms ) const
+{
+	clipIndexStats_t& stats = clipIndexStats[CLIP_INDEX_TREE];
+	int stack[CLIP_TREE_STACK_SIZE];
+	int stackDepth;
+
+	if( clipTree->root == -1 )
+	{
+		return;
+	}
+
+	stack[0] = clipTree->root;
+	stackDepth = 1;
+
+	while( stackDepth > 0 )
+	{
+		const clipTreeNode_t& node = clipTree->nodes[stack[--stackDepth]];
 
-		// if the clip model does not have any contents we are looking for
-		if( !( check->contents & parms.contentMask ) )
+		stats.numQueryNodes++;
+
+		if( !node.bounds.IntersectsBounds( parms.bounds ) )
 		{
 			continue;
 		}
 
-		// if the bounds really do overlap
-		if(	check->absBounds[0][0] > parms.bounds[1][0] ||
-				check->absBounds[1][0] < parms.bounds[0][0] ||
-				check->absBounds[0][1] > parms.bounds[1][1] ||
-				check->absBounds[1][1] < parms.bounds[0][1] ||
-				check->absBounds[0][2] > parms.bounds[1][2] ||
-				check->absBounds[1][2] < parms.bounds[0][2] )
+		if( node.height == 0 )
 		{
+			// unlinked clip models keep their leaf
+			if( !node.clipModel->clipTreeLinked )
+			{
+				continue;
+			}
+
+			stats.numQueryModels++;
+			if( !AddTouchingClipModel( node.clipModel, parms ) )
+			{
+				return;
+			}
 			continue;
 		}
 
-		if( parms.count >= parms.maxCount )
+		if( stackDepth + 2 > CLIP_TREE_STACK_SIZE )
 		{
-			gameLocal.Warning( "idClip::ClipModelsTouchingBounds_r: max count" );
+			gameLocal.Warning( "idClip::ClipModelsTouchingTree: stack overflow" );
 			return;
 		}
+		stack[stackDepth++] = node.children[0];
+		stack[stackDepth++] = node.children[1];
+	}
+}
+
+/*
+====================
+idClip::AddTouchingClipModel
+
+  returns false if the list is full
+====================
+*/
+bool idClip::AddTouchingClipModel( idClipModel* check, listParms_t& parms ) const
+{
+	// if the clip model is enabled
+	if( !check->enabled )
+	{
+		return true;
+	}
+
+	// avoid duplicates in the list
+	if( check->touchCount == touchCount )
+	{
+		return true;
+	}
+
+	// if the clip model does not have any contents we are looking for
+	if( !( check->contents & parms.contentMask ) )
+	{
+		return true;
+	}
+
+	// if the bounds really do overlap
+	if(	check->absBounds[0][0] > parms.bounds[1][0] ||
+			check->absBounds[1][0] < parms.bounds[0][0] ||
+			check->absBounds[0][1] > parms.bounds[1][1] ||
+			check->absBounds[1][1] < parms.bounds[0][1] ||
+			check->absBounds[0][2] > parms.bounds[1][2] ||
+			check->absBounds[1][2] < parms.bounds[0][2] )
+	{
+		return true;
+	}
 
-		check->touchCount = touchCount;
-		parms.list[parms.count] = check;
-		parms.count++;
+	if( parms.count >= parms.maxCount )
+	{
+		gameLocal.Warning( "idClip::ClipModelsTouchingBounds_r: max count" );
+		return false;
 	}
+
+	check->touchCount = touchCount;
+	parms.list[parms.count] = check;
+	parms.count++;
+	return true;
 }
 
 /*
@@ -1042,8 +1723,28 @@ int idClip::ClipModelsTouchingBounds( const idBounds& bounds, int contentMask, i
 	parms.count = 0;
 	parms.maxCount = maxCount;
 
+	clipIndexStats_t& stats = clipIndexStats[( clipTree != NULL ) ? CLIP_INDEX_TREE : CLIP_INDEX_SECTORS];
+	const bool timeQuery = g_clipIndexStats.GetBool();
+	if( timeQuery )
+	{
+		stats.queryTime.Start();
+	}
+	stats.numQueries++;
+
 	touchCount++;
-	ClipModelsTouchingBounds_r( clipSectors, parms );
+	if( clipTree != NULL )
+	{
+		ClipModelsTouchingTree( parms );
+	}
+	else
+	{
+		ClipModelsTouchingBounds_r( clipSectors, parms );
+	}
+
+	if( timeQuery )
+	{
+		stats.queryTime.Stop();
+	}
 
 	return parms.count;
 }
@@ -1996,6 +2697,65 @@ void idClip::PrintStatistics()
 	numRotations = numTranslations = numMotions = numRenderModelTraces = numContents = numContacts = 0;
 }
 
+/*
+============
+idClip::PrintIndexStatistics
+
+  compares the link and query costs of the clip sectors and the dynamic clip tree,
+  the counts add up over maps so both can be measured by switching g_clipTree and
+  restarting the map
+============
+*/
+void idClip::PrintIndexStatistics( bool reset )
+{
+	if( clipTree != NULL )
+	{
+		gameLocal.Printf( "using dynamic clip tree: %d leaves, %d nodes, height %d\n", clipTree->GetNumLeaves(), clipTree->GetNumNodes(), clipTree->GetHeight() );
+	}
+	else
+	{
+		gameLocal.Printf( "using clip sectors: %d sectors, %d links\n", numClipSectors, clipLinkAllocator.GetAllocCount() );
+	}
+
+	const clipIndexStats_t& s = clipIndexStats[CLIP_INDEX_SECTORS];
+	const clipIndexStats_t& t = clipIndexStats[CLIP_INDEX_TREE];
+
+	gameLocal.Printf( "                     sectors        tree\n" );
+	gameLocal.Printf( "links             %10d  %10d\n", s.numLinks, t.numLinks );
+	gameLocal.Printf( "  nodes per link  %10.1f  %10.1f\n", s.numLinkNodes / Max( 1.0f, ( float )s.numLinks ), t.numLinkNodes / Max( 1.0f, ( float )t.numLinks ) );
+	gameLocal.Printf( "  reinserts                -  %10d\n", t.numReinserts );
+	gameLocal.Printf( "unlinks           %10d  %10d\n", s.numUnlinks, t.numUnlinks );
+	gameLocal.Printf( "queries           %10d  %10d\n", s.numQueries, t.numQueries );
+	gameLocal.Printf( "  nodes per query %10.1f  %10.1f\n", s.numQueryNodes / Max( 1.0f, ( float )s.numQueries ), t.numQueryNodes / Max( 1.0f, ( float )t.numQueries ) );
+	gameLocal.Printf( "  models per query%10.1f  %10.1f\n", s.numQueryModels / Max( 1.0f, ( float )s.numQueries ), t.numQueryModels / Max( 1.0f, ( float )t.numQueries ) );
+
+	if( s.linkTime.Milliseconds() > 0.0 || t.linkTime.Milliseconds() > 0.0 || s.queryTime.Milliseconds() > 0.0 || t.queryTime.Milliseconds() > 0.0 )
+	{
+		gameLocal.Printf( "link usec         %10.3f  %10.3f\n", s.linkTime.Milliseconds() * 1000.0 / Max( 1, s.numLinks ), t.linkTime.Milliseconds() * 1000.0 / Max( 1, t.numLinks ) );
+		gameLocal.Printf( "query usec        %10.3f  %10.3f\n", s.queryTime.Milliseconds() * 1000.0 / Max( 1, s.numQueries ), t.queryTime.Milliseconds() * 1000.0 / Max( 1, t.numQueries ) );
+	}
+	else
+	{
+		gameLocal.Printf( "set g_clipIndexStats 1 to time links and queries\n" );
+	}
+
+	if( reset )
+	{
+		for( int i = 0; i < 2; i++ )
+		{
+			clipIndexStats[i].numLinks = 0;
+			clipIndexStats[i].numLinkNodes = 0;
+			clipIndexStats[i].numReinserts = 0;
+			clipIndexStats[i].numUnlinks = 0;
+			clipIndexStats[i].numQueries = 0;
+			clipIndexStats[i].numQueryNodes = 0;
+			clipIndexStats[i].numQueryModels = 0;
+			clipIndexStats[i].linkTime.Clear();
+			clipIndexStats[i].queryTime.Clear();
+		}
+	}
+}
+
 /*
 ============
 idClip::DrawClipModels
@@ -125,6 +125,9 @@ private:
 	int						renderModelHandle;		// render model def handle
 
 	struct clipLink_s* 		clipLinks;				// links into sectors
+	class idClipTree* 		clipTree;				// dynamic tree with a leaf for this clip model
+	int						clipTreeLeaf;			// leaf in the dynamic tree
+	bool					clipTreeLinked;			// the leaf is kept while unlinked for a cheap relink
 	int						touchCount;
 
 	void					Init();			// initialize
@@ -243,7 +246,7 @@ ID_INLINE bool idClipModel::IsTraceModel() const
 
 ID_INLINE bool idClipModel::IsLinked() const
 {
-	return ( clipLinks != NULL );
+	return ( clipLinks != NULL || clipTreeLinked );
 }
 
 ID_INLINE bool idClipModel::IsEnabled() const
@@ -331,12 +334,14 @@ public:
 
 	// stats and debug drawing
 	void					PrintStatistics();
+	void					PrintIndexStatistics( bool reset );
 	void					DrawClipModels( const idVec3& eye, const float radius, const idEntity* passEntity );
 	bool					DrawModelContactFeature( const contactInfo_t& contact, const idClipModel* clipModel, int lifetime ) const;
 
 private:
 	int						numClipSectors;
 	struct clipSector_s* 	clipSectors;
+	class idClipTree* 		clipTree;				// used instead of the clip sectors when set
 	idBounds				worldBounds;
 	idClipModel				temporaryClipModel;
 	idClipModel				defaultClipModel;
@@ -352,6 +357,8 @@ private:
 private:
 	struct clipSector_s* 	CreateClipSectors_r( const int depth, const idBounds& bounds, idVec3& maxSector );
 	void					ClipModelsTouchingBounds_r( const struct clipSector_s* node, struct listParms_s& parms ) const;
+	void					ClipModelsTouchingTree( struct listParms_s& parms ) const;
+	bool					AddTouchingClipModel( idClipModel* check, struct listParms_s& parms ) const;
 	const idTraceModel* 	TraceModelForClipModel( const idClipModel* mdl ) const;
 	int						GetTraceClipModels( const idBounds& bounds, int contentMask, const idEntity* passEntity, idClipModel** clipModelList ) const;
 	void					TraceRenderModel( trace_t& trace, const idVec3& start, const idVec3& end, const float radius, const idMat3& axis, idClipModel* touch ) const;
@@ -33,6 +33,19 @@ If you have questions concerning this license or the applicable additional terms
 
 #include "../Game_local.h"
 
+// computed goto dispatch for the resolved statements
+#if defined( __GNUC__ )
+	#define SCRIPT_THREADED_DISPATCH
+#endif
+
+#ifdef SCRIPT_THREADED_DISPATCH
+	#define FAST_OP( op )		case op: op##_label:
+	#define FAST_NEXT()			{ if( !--runaway ) { Error( "runaway loop error" ); } st = &statements[ ++instructionPointer ]; goto *dispatchTable[ st->op ]; }
+#else
+	#define FAST_OP( op )		case op:
+	#define FAST_NEXT()			continue
+#endif
+
 /*
 ================
 idInterpreter::idInterpreter()
@@ -43,6 +56,8 @@ idInterpreter::idInterpreter()
 	localstackUsed = 0;
 	terminateOnExit = true;
 	debug = 0;
+	executeRunaway = 0;
+	profiling = false;
 	memset( localstack, 0, sizeof( localstack ) );
 	memset( callStack, 0, sizeof( callStack ) );
 	Reset();
@@ -735,6 +750,15 @@ void idInterpreter::EnterFunction( const function_t* func, bool clearStack )
 		}
 	}
 
+	if( profiling )
+	{
+		scriptProfiler.Charge();
+	}
+	if( g_scriptProfile.GetBool() )
+	{
+		scriptProfiler.FunctionCall( func );
+	}
+
 	currentFunction = func;
 	assert( !func->eventdef );
 	NextInstruction( func->firstStatement );
@@ -814,6 +838,11 @@ void idInterpreter::LeaveFunction( idVarDef* returnDef )
 		}
 	}
 
+	if( profiling )
+	{
+		scriptProfiler.Charge();
+	}
+
 	// up stack
 	callStackDepth--;
 	stack = &callStack[ callStackDepth ];
@@ -1122,1000 +1151,1406 @@ void idInterpreter::CallSysEvent( const function_t* func, int argsize )
 
 /*
 ====================
-idInterpreter::Execute
+idInterpreter::ExecuteStatement
 ====================
 */
-bool idInterpreter::Execute()
+void idInterpreter::ExecuteStatement( statement_t* st )
 {
 	varEval_t	var_a;
 	varEval_t	var_b;
 	varEval_t	var_c;
 	varEval_t	var;
-	statement_t*	st;
-	int 		runaway;
 	idThread*	newThread;
 	float		floatVal;
 	idScriptObject* obj;
 	const function_t* func;
 
-	if( threadDying || !currentFunction )
-	{
-		return true;
-	}
-
-	if( multiFrameEvent )
-	{
-		// move to previous instruction and call it again
-		instructionPointer--;
-	}
-
-	runaway = 5000000;
-
-	doneProcessing = false;
-	while( !doneProcessing && !threadDying )
+	switch( st->op )
 	{
-		instructionPointer++;
-
-		if( !--runaway )
-		{
-			Error( "runaway loop error" );
-		}
+		case OP_RETURN:
+			LeaveFunction( st->a );
+			break;
 
-		// next statement
-		st = &gameLocal.program.GetStatement( instructionPointer );
+		case OP_THREAD:
+			newThread = new idThread( this, st->a->value.functionPtr, st->b->value.argSize );
+			newThread->Start();
 
-		switch( st->op )
-		{
-			case OP_RETURN:
-				LeaveFunction( st->a );
-				break;
+			// return the thread number to the script
+			gameLocal.program.ReturnFloat( newThread->GetThreadNum() );
+			PopParms( st->b->value.argSize );
+			break;
 
-			case OP_THREAD:
-				newThread = new idThread( this, st->a->value.functionPtr, st->b->value.argSize );
+		case OP_OBJTHREAD:
+			var_a = GetVariable( st->a );
+			obj = GetScriptObject( *var_a.entityNumberPtr );
+			if( obj )
+			{
+				func = obj->GetTypeDef()->GetFunction( st->b->value.virtualFunction );
+				assert( st->c->value.argSize == func->parmTotal );
+				newThread = new idThread( this, GetEntity( *var_a.entityNumberPtr ), func, func->parmTotal );
 				newThread->Start();
 
 				// return the thread number to the script
 				gameLocal.program.ReturnFloat( newThread->GetThreadNum() );
-				PopParms( st->b->value.argSize );
-				break;
+			}
+			else
+			{
+				// return a null thread to the script
+				gameLocal.program.ReturnFloat( 0.0f );
+			}
+			PopParms( st->c->value.argSize );
+			break;
 
-			case OP_OBJTHREAD:
-				var_a = GetVariable( st->a );
-				obj = GetScriptObject( *var_a.entityNumberPtr );
-				if( obj )
-				{
-					func = obj->GetTypeDef()->GetFunction( st->b->value.virtualFunction );
-					assert( st->c->value.argSize == func->parmTotal );
-					newThread = new idThread( this, GetEntity( *var_a.entityNumberPtr ), func, func->parmTotal );
-					newThread->Start();
+		case OP_CALL:
+			EnterFunction( st->a->value.functionPtr, false );
+			break;
 
-					// return the thread number to the script
-					gameLocal.program.ReturnFloat( newThread->GetThreadNum() );
-				}
-				else
-				{
-					// return a null thread to the script
-					gameLocal.program.ReturnFloat( 0.0f );
-				}
+		case OP_EVENTCALL:
+			if( profiling )
+			{
+				scriptProfiler.BeginEvent( st->a->value.functionPtr->eventdef );
+			}
+			CallEvent( st->a->value.functionPtr, st->b->value.argSize );
+			if( profiling )
+			{
+				scriptProfiler.EndEvent();
+			}
+			break;
+
+		case OP_OBJECTCALL:
+			var_a = GetVariable( st->a );
+			obj = GetScriptObject( *var_a.entityNumberPtr );
+			if( obj )
+			{
+				func = obj->GetTypeDef()->GetFunction( st->b->value.virtualFunction );
+				EnterFunction( func, false );
+			}
+			else
+			{
+				// return a 'safe' value
+				gameLocal.program.ReturnVector( vec3_zero );
+				gameLocal.program.ReturnString( "" );
 				PopParms( st->c->value.argSize );
-				break;
+			}
+			break;
 
-			case OP_CALL:
-				EnterFunction( st->a->value.functionPtr, false );
-				break;
+		case OP_SYSCALL:
+			if( profiling )
+			{
+				scriptProfiler.BeginEvent( st->a->value.functionPtr->eventdef );
+			}
+			CallSysEvent( st->a->value.functionPtr, st->b->value.argSize );
+			if( profiling )
+			{
+				scriptProfiler.EndEvent();
+			}
+			break;
 
-			case OP_EVENTCALL:
-				CallEvent( st->a->value.functionPtr, st->b->value.argSize );
-				break;
+		case OP_IFNOT:
+			var_a = GetVariable( st->a );
+			if( *var_a.intPtr == 0 )
+			{
+				NextInstruction( instructionPointer + st->b->value.jumpOffset );
+			}
+			break;
 
-			case OP_OBJECTCALL:
-				var_a = GetVariable( st->a );
-				obj = GetScriptObject( *var_a.entityNumberPtr );
-				if( obj )
-				{
-					func = obj->GetTypeDef()->GetFunction( st->b->value.virtualFunction );
-					EnterFunction( func, false );
-				}
-				else
-				{
-					// return a 'safe' value
-					gameLocal.program.ReturnVector( vec3_zero );
-					gameLocal.program.ReturnString( "" );
-					PopParms( st->c->value.argSize );
-				}
-				break;
+		case OP_IF:
+			var_a = GetVariable( st->a );
+			if( *var_a.intPtr != 0 )
+			{
+				NextInstruction( instructionPointer + st->b->value.jumpOffset );
+			}
+			break;
 
-			case OP_SYSCALL:
-				CallSysEvent( st->a->value.functionPtr, st->b->value.argSize );
-				break;
+		case OP_GOTO:
+			NextInstruction( instructionPointer + st->a->value.jumpOffset );
+			break;
 
-			case OP_IFNOT:
-				var_a = GetVariable( st->a );
-				if( *var_a.intPtr == 0 )
-				{
-					NextInstruction( instructionPointer + st->b->value.jumpOffset );
-				}
-				break;
+		case OP_ADD_F:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = *var_a.floatPtr + *var_b.floatPtr;
+			break;
 
-			case OP_IF:
-				var_a = GetVariable( st->a );
-				if( *var_a.intPtr != 0 )
-				{
-					NextInstruction( instructionPointer + st->b->value.jumpOffset );
-				}
-				break;
+		case OP_ADD_V:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.vectorPtr = *var_a.vectorPtr + *var_b.vectorPtr;
+			break;
 
-			case OP_GOTO:
-				NextInstruction( instructionPointer + st->a->value.jumpOffset );
-				break;
+		case OP_ADD_S:
+			SetString( st->c, GetString( st->a ) );
+			AppendString( st->c, GetString( st->b ) );
+			break;
 
-			case OP_ADD_F:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				var_c = GetVariable( st->c );
-				*var_c.floatPtr = *var_a.floatPtr + *var_b.floatPtr;
-				break;
+		case OP_ADD_FS:
+			var_a = GetVariable( st->a );
+			SetString( st->c, FloatToString( *var_a.floatPtr ) );
+			AppendString( st->c, GetString( st->b ) );
+			break;
 
-			case OP_ADD_V:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				var_c = GetVariable( st->c );
-				*var_c.vectorPtr = *var_a.vectorPtr + *var_b.vectorPtr;
-				break;
+		case OP_ADD_SF:
+			var_b = GetVariable( st->b );
+			SetString( st->c, GetString( st->a ) );
+			AppendString( st->c, FloatToString( *var_b.floatPtr ) );
+			break;
 
-			case OP_ADD_S:
-				SetString( st->c, GetString( st->a ) );
-				AppendString( st->c, GetString( st->b ) );
-				break;
+		case OP_ADD_VS:
+			var_a = GetVariable( st->a );
+			SetString( st->c, var_a.vectorPtr->ToString() );
+			AppendString( st->c, GetString( st->b ) );
+			break;
 
-			case OP_ADD_FS:
-				var_a = GetVariable( st->a );
-				SetString( st->c, FloatToString( *var_a.floatPtr ) );
-				AppendString( st->c, GetString( st->b ) );
-				break;
+		case OP_ADD_SV:
+			var_b = GetVariable( st->b );
+			SetString( st->c, GetString( st->a ) );
+			AppendString( st->c, var_b.vectorPtr->ToString() );
+			break;
 
-			case OP_ADD_SF:
-				var_b = GetVariable( st->b );
-				SetString( st->c, GetString( st->a ) );
-				AppendString( st->c, FloatToString( *var_b.floatPtr ) );
-				break;
+		case OP_SUB_F:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = *var_a.floatPtr - *var_b.floatPtr;
+			break;
 
-			case OP_ADD_VS:
-				var_a = GetVariable( st->a );
-				SetString( st->c, var_a.vectorPtr->ToString() );
-				AppendString( st->c, GetString( st->b ) );
-				break;
+		case OP_SUB_V:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.vectorPtr = *var_a.vectorPtr - *var_b.vectorPtr;
+			break;
 
-			case OP_ADD_SV:
-				var_b = GetVariable( st->b );
-				SetString( st->c, GetString( st->a ) );
-				AppendString( st->c, var_b.vectorPtr->ToString() );
-				break;
+		case OP_MUL_F:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = *var_a.floatPtr** var_b.floatPtr;
+			break;
 
-			case OP_SUB_F:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				var_c = GetVariable( st->c );
-				*var_c.floatPtr = *var_a.floatPtr - *var_b.floatPtr;
-				break;
+		case OP_MUL_V:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = *var_a.vectorPtr** var_b.vectorPtr;
+			break;
 
-			case OP_SUB_V:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				var_c = GetVariable( st->c );
-				*var_c.vectorPtr = *var_a.vectorPtr - *var_b.vectorPtr;
-				break;
+		case OP_MUL_FV:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.vectorPtr = *var_a.floatPtr** var_b.vectorPtr;
+			break;
 
-			case OP_MUL_F:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				var_c = GetVariable( st->c );
-				*var_c.floatPtr = *var_a.floatPtr** var_b.floatPtr;
-				break;
+		case OP_MUL_VF:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.vectorPtr = *var_a.vectorPtr** var_b.floatPtr;
+			break;
 
-			case OP_MUL_V:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				var_c = GetVariable( st->c );
-				*var_c.floatPtr = *var_a.vectorPtr** var_b.vectorPtr;
-				break;
+		case OP_DIV_F:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
 
-			case OP_MUL_FV:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				var_c = GetVariable( st->c );
-				*var_c.vectorPtr = *var_a.floatPtr** var_b.vectorPtr;
-				break;
+			if( *var_b.floatPtr == 0.0f )
+			{
+				Warning( "Divide by zero" );
+				*var_c.floatPtr = idMath::INFINITUM;
+			}
+			else
+			{
+				*var_c.floatPtr = *var_a.floatPtr / *var_b.floatPtr;
+			}
+			break;
 
-			case OP_MUL_VF:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				var_c = GetVariable( st->c );
-				*var_c.vectorPtr = *var_a.vectorPtr** var_b.floatPtr;
-				break;
+		case OP_MOD_F:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
 
-			case OP_DIV_F:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				var_c = GetVariable( st->c );
+			if( *var_b.floatPtr == 0.0f )
+			{
+				Warning( "Divide by zero" );
+				*var_c.floatPtr = *var_a.floatPtr;
+			}
+			else
+			{
+				*var_c.floatPtr = static_cast<int>( *var_a.floatPtr ) % static_cast<int>( *var_b.floatPtr );
+			}
+			break;
 
-				if( *var_b.floatPtr == 0.0f )
-				{
-					Warning( "Divide by zero" );
-					*var_c.floatPtr = idMath::INFINITUM;
-				}
-				else
-				{
-					*var_c.floatPtr = *var_a.floatPtr / *var_b.floatPtr;
-				}
-				break;
+		case OP_BITAND:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = static_cast<int>( *var_a.floatPtr ) & static_cast<int>( *var_b.floatPtr );
+			break;
 
-			case OP_MOD_F:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				var_c = GetVariable( st->c );
+		case OP_BITOR:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = static_cast<int>( *var_a.floatPtr ) | static_cast<int>( *var_b.floatPtr );
+			break;
 
-				if( *var_b.floatPtr == 0.0f )
-				{
-					Warning( "Divide by zero" );
-					*var_c.floatPtr = *var_a.floatPtr;
-				}
-				else
-				{
-					*var_c.floatPtr = static_cast<int>( *var_a.floatPtr ) % static_cast<int>( *var_b.floatPtr );
-				}
-				break;
+		case OP_GE:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( *var_a.floatPtr >= *var_b.floatPtr );
+			break;
 
-			case OP_BITAND:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				var_c = GetVariable( st->c );
-				*var_c.floatPtr = static_cast<int>( *var_a.floatPtr ) & static_cast<int>( *var_b.floatPtr );
-				break;
+		case OP_LE:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( *var_a.floatPtr <= *var_b.floatPtr );
+			break;
 
-			case OP_BITOR:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				var_c = GetVariable( st->c );
-				*var_c.floatPtr = static_cast<int>( *var_a.floatPtr ) | static_cast<int>( *var_b.floatPtr );
-				break;
+		case OP_GT:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( *var_a.floatPtr > *var_b.floatPtr );
+			break;
 
-			case OP_GE:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				var_c = GetVariable( st->c );
-				*var_c.floatPtr = ( *var_a.floatPtr >= *var_b.floatPtr );
-				break;
+		case OP_LT:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( *var_a.floatPtr < *var_b.floatPtr );
+			break;
 
-			case OP_LE:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				var_c = GetVariable( st->c );
-				*var_c.floatPtr = ( *var_a.floatPtr <= *var_b.floatPtr );
-				break;
+		case OP_AND:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) && ( *var_b.floatPtr != 0.0f );
+			break;
 
-			case OP_GT:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				var_c = GetVariable( st->c );
-				*var_c.floatPtr = ( *var_a.floatPtr > *var_b.floatPtr );
-				break;
+		case OP_AND_BOOLF:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( *var_a.intPtr != 0 ) && ( *var_b.floatPtr != 0.0f );
+			break;
 
-			case OP_LT:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				var_c = GetVariable( st->c );
-				*var_c.floatPtr = ( *var_a.floatPtr < *var_b.floatPtr );
-				break;
+		case OP_AND_FBOOL:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) && ( *var_b.intPtr != 0 );
+			break;
 
-			case OP_AND:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				var_c = GetVariable( st->c );
-				*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) && ( *var_b.floatPtr != 0.0f );
-				break;
+		case OP_AND_BOOLBOOL:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( *var_a.intPtr != 0 ) && ( *var_b.intPtr != 0 );
+			break;
 
-			case OP_AND_BOOLF:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				var_c = GetVariable( st->c );
-				*var_c.floatPtr = ( *var_a.intPtr != 0 ) && ( *var_b.floatPtr != 0.0f );
-				break;
+		case OP_OR:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) || ( *var_b.floatPtr != 0.0f );
+			break;
 
-			case OP_AND_FBOOL:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				var_c = GetVariable( st->c );
-				*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) && ( *var_b.intPtr != 0 );
-				break;
+		case OP_OR_BOOLF:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( *var_a.intPtr != 0 ) || ( *var_b.floatPtr != 0.0f );
+			break;
 
-			case OP_AND_BOOLBOOL:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				var_c = GetVariable( st->c );
-				*var_c.floatPtr = ( *var_a.intPtr != 0 ) && ( *var_b.intPtr != 0 );
-				break;
+		case OP_OR_FBOOL:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) || ( *var_b.intPtr != 0 );
+			break;
 
-			case OP_OR:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				var_c = GetVariable( st->c );
-				*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) || ( *var_b.floatPtr != 0.0f );
-				break;
+		case OP_OR_BOOLBOOL:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( *var_a.intPtr != 0 ) || ( *var_b.intPtr != 0 );
+			break;
 
-			case OP_OR_BOOLF:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				var_c = GetVariable( st->c );
-				*var_c.floatPtr = ( *var_a.intPtr != 0 ) || ( *var_b.floatPtr != 0.0f );
-				break;
+		case OP_NOT_BOOL:
+			var_a = GetVariable( st->a );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( *var_a.intPtr == 0 );
+			break;
 
-			case OP_OR_FBOOL:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				var_c = GetVariable( st->c );
-				*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) || ( *var_b.intPtr != 0 );
-				break;
+		case OP_NOT_F:
+			var_a = GetVariable( st->a );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( *var_a.floatPtr == 0.0f );
+			break;
 
-			case OP_OR_BOOLBOOL:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				var_c = GetVariable( st->c );
-				*var_c.floatPtr = ( *var_a.intPtr != 0 ) || ( *var_b.intPtr != 0 );
-				break;
+		case OP_NOT_V:
+			var_a = GetVariable( st->a );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( *var_a.vectorPtr == vec3_zero );
+			break;
 
-			case OP_NOT_BOOL:
-				var_a = GetVariable( st->a );
-				var_c = GetVariable( st->c );
-				*var_c.floatPtr = ( *var_a.intPtr == 0 );
-				break;
+		case OP_NOT_S:
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( strlen( GetString( st->a ) ) == 0 );
+			break;
 
-			case OP_NOT_F:
-				var_a = GetVariable( st->a );
-				var_c = GetVariable( st->c );
-				*var_c.floatPtr = ( *var_a.floatPtr == 0.0f );
-				break;
+		case OP_NOT_ENT:
+			var_a = GetVariable( st->a );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( GetEntity( *var_a.entityNumberPtr ) == NULL );
+			break;
 
-			case OP_NOT_V:
-				var_a = GetVariable( st->a );
-				var_c = GetVariable( st->c );
-				*var_c.floatPtr = ( *var_a.vectorPtr == vec3_zero );
-				break;
+		case OP_NEG_F:
+			var_a = GetVariable( st->a );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = -*var_a.floatPtr;
+			break;
 
-			case OP_NOT_S:
-				var_c = GetVariable( st->c );
-				*var_c.floatPtr = ( strlen( GetString( st->a ) ) == 0 );
-				break;
+		case OP_NEG_V:
+			var_a = GetVariable( st->a );
+			var_c = GetVariable( st->c );
+			*var_c.vectorPtr = -*var_a.vectorPtr;
+			break;
 
-			case OP_NOT_ENT:
-				var_a = GetVariable( st->a );
-				var_c = GetVariable( st->c );
-				*var_c.floatPtr = ( GetEntity( *var_a.entityNumberPtr ) == NULL );
-				break;
+		case OP_INT_F:
+			var_a = GetVariable( st->a );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = static_cast<int>( *var_a.floatPtr );
+			break;
 
-			case OP_NEG_F:
-				var_a = GetVariable( st->a );
-				var_c = GetVariable( st->c );
-				*var_c.floatPtr = -*var_a.floatPtr;
-				break;
+		case OP_EQ_F:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( *var_a.floatPtr == *var_b.floatPtr );
+			break;
 
-			case OP_NEG_V:
-				var_a = GetVariable( st->a );
-				var_c = GetVariable( st->c );
-				*var_c.vectorPtr = -*var_a.vectorPtr;
-				break;
+		case OP_EQ_V:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( *var_a.vectorPtr == *var_b.vectorPtr );
+			break;
 
-			case OP_INT_F:
-				var_a = GetVariable( st->a );
-				var_c = GetVariable( st->c );
-				*var_c.floatPtr = static_cast<int>( *var_a.floatPtr );
-				break;
+		case OP_EQ_S:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( idStr::Cmp( GetString( st->a ), GetString( st->b ) ) == 0 );
+			break;
 
-			case OP_EQ_F:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				var_c = GetVariable( st->c );
-				*var_c.floatPtr = ( *var_a.floatPtr == *var_b.floatPtr );
-				break;
+		case OP_EQ_E:
+		case OP_EQ_EO:
+		case OP_EQ_OE:
+		case OP_EQ_OO:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( *var_a.entityNumberPtr == *var_b.entityNumberPtr );
+			break;
 
-			case OP_EQ_V:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				var_c = GetVariable( st->c );
-				*var_c.floatPtr = ( *var_a.vectorPtr == *var_b.vectorPtr );
-				break;
+		case OP_NE_F:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( *var_a.floatPtr != *var_b.floatPtr );
+			break;
 
-			case OP_EQ_S:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				var_c = GetVariable( st->c );
-				*var_c.floatPtr = ( idStr::Cmp( GetString( st->a ), GetString( st->b ) ) == 0 );
-				break;
+		case OP_NE_V:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( *var_a.vectorPtr != *var_b.vectorPtr );
+			break;
 
-			case OP_EQ_E:
-			case OP_EQ_EO:
-			case OP_EQ_OE:
-			case OP_EQ_OO:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				var_c = GetVariable( st->c );
-				*var_c.floatPtr = ( *var_a.entityNumberPtr == *var_b.entityNumberPtr );
-				break;
+		case OP_NE_S:
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( idStr::Cmp( GetString( st->a ), GetString( st->b ) ) != 0 );
+			break;
 
-			case OP_NE_F:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				var_c = GetVariable( st->c );
-				*var_c.floatPtr = ( *var_a.floatPtr != *var_b.floatPtr );
-				break;
-
-			case OP_NE_V:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				var_c = GetVariable( st->c );
-				*var_c.floatPtr = ( *var_a.vectorPtr != *var_b.vectorPtr );
-				break;
+		case OP_NE_E:
+		case OP_NE_EO:
+		case OP_NE_OE:
+		case OP_NE_OO:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( *var_a.entityNumberPtr != *var_b.entityNumberPtr );
+			break;
 
-			case OP_NE_S:
-				var_c = GetVariable( st->c );
-				*var_c.floatPtr = ( idStr::Cmp( GetString( st->a ), GetString( st->b ) ) != 0 );
-				break;
+		case OP_UADD_F:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			*var_b.floatPtr += *var_a.floatPtr;
+			break;
 
-			case OP_NE_E:
-			case OP_NE_EO:
-			case OP_NE_OE:
-			case OP_NE_OO:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				var_c = GetVariable( st->c );
-				*var_c.floatPtr = ( *var_a.entityNumberPtr != *var_b.entityNumberPtr );
-				break;
+		case OP_UADD_V:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			*var_b.vectorPtr += *var_a.vectorPtr;
+			break;
 
-			case OP_UADD_F:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				*var_b.floatPtr += *var_a.floatPtr;
-				break;
+		case OP_USUB_F:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			*var_b.floatPtr -= *var_a.floatPtr;
+			break;
 
-			case OP_UADD_V:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				*var_b.vectorPtr += *var_a.vectorPtr;
-				break;
+		case OP_USUB_V:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			*var_b.vectorPtr -= *var_a.vectorPtr;
+			break;
 
-			case OP_USUB_F:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				*var_b.floatPtr -= *var_a.floatPtr;
-				break;
+		case OP_UMUL_F:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			*var_b.floatPtr *= *var_a.floatPtr;
+			break;
 
-			case OP_USUB_V:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				*var_b.vectorPtr -= *var_a.vectorPtr;
-				break;
+		case OP_UMUL_V:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			*var_b.vectorPtr *= *var_a.floatPtr;
+			break;
 
-			case OP_UMUL_F:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				*var_b.floatPtr *= *var_a.floatPtr;
-				break;
+		case OP_UDIV_F:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
 
-			case OP_UMUL_V:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				*var_b.vectorPtr *= *var_a.floatPtr;
-				break;
+			if( *var_a.floatPtr == 0.0f )
+			{
+				Warning( "Divide by zero" );
+				*var_b.floatPtr = idMath::INFINITUM;
+			}
+			else
+			{
+				*var_b.floatPtr = *var_b.floatPtr / *var_a.floatPtr;
+			}
+			break;
 
-			case OP_UDIV_F:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
+		case OP_UDIV_V:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
 
-				if( *var_a.floatPtr == 0.0f )
-				{
-					Warning( "Divide by zero" );
-					*var_b.floatPtr = idMath::INFINITUM;
-				}
-				else
-				{
-					*var_b.floatPtr = *var_b.floatPtr / *var_a.floatPtr;
-				}
-				break;
+			if( *var_a.floatPtr == 0.0f )
+			{
+				Warning( "Divide by zero" );
+				var_b.vectorPtr->Set( idMath::INFINITUM, idMath::INFINITUM, idMath::INFINITUM );
+			}
+			else
+			{
+				*var_b.vectorPtr = *var_b.vectorPtr / *var_a.floatPtr;
+			}
+			break;
 
-			case OP_UDIV_V:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
+		case OP_UMOD_F:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
 
-				if( *var_a.floatPtr == 0.0f )
-				{
-					Warning( "Divide by zero" );
-					var_b.vectorPtr->Set( idMath::INFINITUM, idMath::INFINITUM, idMath::INFINITUM );
-				}
-				else
-				{
-					*var_b.vectorPtr = *var_b.vectorPtr / *var_a.floatPtr;
-				}
-				break;
+			if( *var_a.floatPtr == 0.0f )
+			{
+				Warning( "Divide by zero" );
+				*var_b.floatPtr = *var_a.floatPtr;
+			}
+			else
+			{
+				*var_b.floatPtr = static_cast<int>( *var_b.floatPtr ) % static_cast<int>( *var_a.floatPtr );
+			}
+			break;
 
-			case OP_UMOD_F:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
+		case OP_UOR_F:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			*var_b.floatPtr = static_cast<int>( *var_b.floatPtr ) | static_cast<int>( *var_a.floatPtr );
+			break;
 
-				if( *var_a.floatPtr == 0.0f )
-				{
-					Warning( "Divide by zero" );
-					*var_b.floatPtr = *var_a.floatPtr;
-				}
-				else
-				{
-					*var_b.floatPtr = static_cast<int>( *var_b.floatPtr ) % static_cast<int>( *var_a.floatPtr );
-				}
-				break;
+		case OP_UAND_F:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			*var_b.floatPtr = static_cast<int>( *var_b.floatPtr ) & static_cast<int>( *var_a.floatPtr );
+			break;
 
-			case OP_UOR_F:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				*var_b.floatPtr = static_cast<int>( *var_b.floatPtr ) | static_cast<int>( *var_a.floatPtr );
-				break;
+		case OP_UINC_F:
+			var_a = GetVariable( st->a );
+			( *var_a.floatPtr )++;
+			break;
 
-			case OP_UAND_F:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				*var_b.floatPtr = static_cast<int>( *var_b.floatPtr ) & static_cast<int>( *var_a.floatPtr );
-				break;
+		case OP_UINCP_F:
+			var_a = GetVariable( st->a );
+			obj = GetScriptObject( *var_a.entityNumberPtr );
+			if( obj )
+			{
+				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+				( *var.floatPtr )++;
+			}
+			break;
 
-			case OP_UINC_F:
-				var_a = GetVariable( st->a );
-				( *var_a.floatPtr )++;
-				break;
+		case OP_UDEC_F:
+			var_a = GetVariable( st->a );
+			( *var_a.floatPtr )--;
+			break;
 
-			case OP_UINCP_F:
-				var_a = GetVariable( st->a );
-				obj = GetScriptObject( *var_a.entityNumberPtr );
-				if( obj )
-				{
-					var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
-					( *var.floatPtr )++;
-				}
-				break;
+		case OP_UDECP_F:
+			var_a = GetVariable( st->a );
+			obj = GetScriptObject( *var_a.entityNumberPtr );
+			if( obj )
+			{
+				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+				( *var.floatPtr )--;
+			}
+			break;
 
-			case OP_UDEC_F:
-				var_a = GetVariable( st->a );
-				( *var_a.floatPtr )--;
-				break;
+		case OP_COMP_F:
+			var_a = GetVariable( st->a );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ~static_cast<int>( *var_a.floatPtr );
+			break;
 
-			case OP_UDECP_F:
-				var_a = GetVariable( st->a );
-				obj = GetScriptObject( *var_a.entityNumberPtr );
-				if( obj )
-				{
-					var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
-					( *var.floatPtr )--;
-				}
-				break;
+		case OP_STORE_F:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			*var_b.floatPtr = *var_a.floatPtr;
+			break;
 
-			case OP_COMP_F:
-				var_a = GetVariable( st->a );
-				var_c = GetVariable( st->c );
-				*var_c.floatPtr = ~static_cast<int>( *var_a.floatPtr );
-				break;
+		case OP_STORE_ENT:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			*var_b.entityNumberPtr = *var_a.entityNumberPtr;
+			break;
 
-			case OP_STORE_F:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				*var_b.floatPtr = *var_a.floatPtr;
-				break;
+		case OP_STORE_BOOL:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			*var_b.intPtr = *var_a.intPtr;
+			break;
 
-			case OP_STORE_ENT:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
+		case OP_STORE_OBJENT:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			obj = GetScriptObject( *var_a.entityNumberPtr );
+			if( !obj )
+			{
+				*var_b.entityNumberPtr = 0;
+			}
+			else if( !obj->GetTypeDef()->Inherits( st->b->TypeDef() ) )
+			{
+				//Warning( "object '%s' cannot be converted to '%s'", obj->GetTypeName(), st->b->TypeDef()->Name() );
+				*var_b.entityNumberPtr = 0;
+			}
+			else
+			{
 				*var_b.entityNumberPtr = *var_a.entityNumberPtr;
-				break;
+			}
+			break;
 
-			case OP_STORE_BOOL:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				*var_b.intPtr = *var_a.intPtr;
-				break;
+		case OP_STORE_OBJ:
+		case OP_STORE_ENTOBJ:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			*var_b.entityNumberPtr = *var_a.entityNumberPtr;
+			break;
 
-			case OP_STORE_OBJENT:
-				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				obj = GetScriptObject( *var_a.entityNumberPtr );
-				if( !obj )
-				{
-					*var_b.entityNumberPtr = 0;
-				}
-				else if( !obj->GetTypeDef()->Inherits( st->b->TypeDef() ) )
-				{
-					//Warning( "object '%s' cannot be converted to '%s'", obj->GetTypeName(), st->b->TypeDef()->Name() );
-					*var_b.entityNumberPtr = 0;
-				}
-				else
-				{
-					*var_b.entityNumberPtr = *var_a.entityNumberPtr;
-				}
-				break;
+		case OP_STORE_S:
+			SetString( st->b, GetString( st->a ) );
+			break;
+
+		case OP_STORE_V:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			*var_b.vectorPtr = *var_a.vectorPtr;
+			break;
+
+		case OP_STORE_FTOS:
+			var_a = GetVariable( st->a );
+			SetString( st->b, FloatToString( *var_a.floatPtr ) );
+			break;
+
+		case OP_STORE_BTOS:
+			var_a = GetVariable( st->a );
+			SetString( st->b, *var_a.intPtr ? "true" : "false" );
+			break;
+
+		case OP_STORE_VTOS:
+			var_a = GetVariable( st->a );
+			SetString( st->b, var_a.vectorPtr->ToString() );
+			break;
+
+		case OP_STORE_FTOBOOL:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			if( *var_a.floatPtr != 0.0f )
+			{
+				*var_b.intPtr = 1;
+			}
+			else
+			{
+				*var_b.intPtr = 0;
+			}
+			break;
+
+		case OP_STORE_BOOLTOF:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			*var_b.floatPtr = static_cast<float>( *var_a.intPtr );
+			break;
 
-			case OP_STORE_OBJ:
-			case OP_STORE_ENTOBJ:
+		case OP_STOREP_F:
+			var_b = GetVariable( st->b );
+			if( var_b.evalPtr && var_b.evalPtr->floatPtr )
+			{
 				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				*var_b.entityNumberPtr = *var_a.entityNumberPtr;
-				break;
+				*var_b.evalPtr->floatPtr = *var_a.floatPtr;
+			}
+			break;
 
-			case OP_STORE_S:
-				SetString( st->b, GetString( st->a ) );
-				break;
+		case OP_STOREP_ENT:
+			var_b = GetVariable( st->b );
+			if( var_b.evalPtr && var_b.evalPtr->entityNumberPtr )
+			{
+				var_a = GetVariable( st->a );
+				*var_b.evalPtr->entityNumberPtr = *var_a.entityNumberPtr;
+			}
+			break;
 
-			case OP_STORE_V:
+		case OP_STOREP_FLD:
+			var_b = GetVariable( st->b );
+			if( var_b.evalPtr && var_b.evalPtr->intPtr )
+			{
 				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				*var_b.vectorPtr = *var_a.vectorPtr;
-				break;
+				*var_b.evalPtr->intPtr = *var_a.intPtr;
+			}
+			break;
 
-			case OP_STORE_FTOS:
+		case OP_STOREP_BOOL:
+			var_b = GetVariable( st->b );
+			if( var_b.evalPtr && var_b.evalPtr->intPtr )
+			{
 				var_a = GetVariable( st->a );
-				SetString( st->b, FloatToString( *var_a.floatPtr ) );
-				break;
+				*var_b.evalPtr->intPtr = *var_a.intPtr;
+			}
+			break;
+
+		case OP_STOREP_S:
+			var_b = GetVariable( st->b );
+			if( var_b.evalPtr && var_b.evalPtr->stringPtr )
+			{
+				idStr::Copynz( var_b.evalPtr->stringPtr, GetString( st->a ), MAX_STRING_LEN );
+			}
+			break;
 
-			case OP_STORE_BTOS:
+		case OP_STOREP_V:
+			var_b = GetVariable( st->b );
+			if( var_b.evalPtr && var_b.evalPtr->vectorPtr )
+			{
 				var_a = GetVariable( st->a );
-				SetString( st->b, *var_a.intPtr ? "true" : "false" );
-				break;
+				*var_b.evalPtr->vectorPtr = *var_a.vectorPtr;
+			}
+			break;
 
-			case OP_STORE_VTOS:
+		case OP_STOREP_FTOS:
+			var_b = GetVariable( st->b );
+			if( var_b.evalPtr && var_b.evalPtr->stringPtr )
+			{
 				var_a = GetVariable( st->a );
-				SetString( st->b, var_a.vectorPtr->ToString() );
-				break;
+				idStr::Copynz( var_b.evalPtr->stringPtr, FloatToString( *var_a.floatPtr ), MAX_STRING_LEN );
+			}
+			break;
 
-			case OP_STORE_FTOBOOL:
+		case OP_STOREP_BTOS:
+			var_b = GetVariable( st->b );
+			if( var_b.evalPtr && var_b.evalPtr->stringPtr )
+			{
 				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
 				if( *var_a.floatPtr != 0.0f )
 				{
-					*var_b.intPtr = 1;
+					idStr::Copynz( var_b.evalPtr->stringPtr, "true", MAX_STRING_LEN );
 				}
 				else
 				{
-					*var_b.intPtr = 0;
+					idStr::Copynz( var_b.evalPtr->stringPtr, "false", MAX_STRING_LEN );
 				}
-				break;
+			}
+			break;
 
-			case OP_STORE_BOOLTOF:
+		case OP_STOREP_VTOS:
+			var_b = GetVariable( st->b );
+			if( var_b.evalPtr && var_b.evalPtr->stringPtr )
+			{
 				var_a = GetVariable( st->a );
-				var_b = GetVariable( st->b );
-				*var_b.floatPtr = static_cast<float>( *var_a.intPtr );
-				break;
-
-			case OP_STOREP_F:
-				var_b = GetVariable( st->b );
-				if( var_b.evalPtr && var_b.evalPtr->floatPtr )
-				{
-					var_a = GetVariable( st->a );
-					*var_b.evalPtr->floatPtr = *var_a.floatPtr;
-				}
-				break;
-
-			case OP_STOREP_ENT:
-				var_b = GetVariable( st->b );
-				if( var_b.evalPtr && var_b.evalPtr->entityNumberPtr )
-				{
-					var_a = GetVariable( st->a );
-					*var_b.evalPtr->entityNumberPtr = *var_a.entityNumberPtr;
-				}
-				break;
-
-			case OP_STOREP_FLD:
-				var_b = GetVariable( st->b );
-				if( var_b.evalPtr && var_b.evalPtr->intPtr )
-				{
-					var_a = GetVariable( st->a );
-					*var_b.evalPtr->intPtr = *var_a.intPtr;
-				}
-				break;
-
-			case OP_STOREP_BOOL:
-				var_b = GetVariable( st->b );
-				if( var_b.evalPtr && var_b.evalPtr->intPtr )
-				{
-					var_a = GetVariable( st->a );
-					*var_b.evalPtr->intPtr = *var_a.intPtr;
-				}
-				break;
+				idStr::Copynz( var_b.evalPtr->stringPtr, var_a.vectorPtr->ToString(), MAX_STRING_LEN );
+			}
+			break;
 
-			case OP_STOREP_S:
-				var_b = GetVariable( st->b );
-				if( var_b.evalPtr && var_b.evalPtr->stringPtr )
+		case OP_STOREP_FTOBOOL:
+			var_b = GetVariable( st->b );
+			if( var_b.evalPtr && var_b.evalPtr->intPtr )
+			{
+				var_a = GetVariable( st->a );
+				if( *var_a.floatPtr != 0.0f )
 				{
-					idStr::Copynz( var_b.evalPtr->stringPtr, GetString( st->a ), MAX_STRING_LEN );
+					*var_b.evalPtr->intPtr = 1;
 				}
-				break;
-
-			case OP_STOREP_V:
-				var_b = GetVariable( st->b );
-				if( var_b.evalPtr && var_b.evalPtr->vectorPtr )
+				else
 				{
-					var_a = GetVariable( st->a );
-					*var_b.evalPtr->vectorPtr = *var_a.vectorPtr;
+					*var_b.evalPtr->intPtr = 0;
 				}
-				break;
+			}
+			break;
 
-			case OP_STOREP_FTOS:
-				var_b = GetVariable( st->b );
-				if( var_b.evalPtr && var_b.evalPtr->stringPtr )
-				{
-					var_a = GetVariable( st->a );
-					idStr::Copynz( var_b.evalPtr->stringPtr, FloatToString( *var_a.floatPtr ), MAX_STRING_LEN );
-				}
-				break;
+		case OP_STOREP_BOOLTOF:
+			var_b = GetVariable( st->b );
+			if( var_b.evalPtr && var_b.evalPtr->floatPtr )
+			{
+				var_a = GetVariable( st->a );
+				*var_b.evalPtr->floatPtr = static_cast<float>( *var_a.intPtr );
+			}
+			break;
 
-			case OP_STOREP_BTOS:
-				var_b = GetVariable( st->b );
-				if( var_b.evalPtr && var_b.evalPtr->stringPtr )
-				{
-					var_a = GetVariable( st->a );
-					if( *var_a.floatPtr != 0.0f )
-					{
-						idStr::Copynz( var_b.evalPtr->stringPtr, "true", MAX_STRING_LEN );
-					}
-					else
-					{
-						idStr::Copynz( var_b.evalPtr->stringPtr, "false", MAX_STRING_LEN );
-					}
-				}
-				break;
+		case OP_STOREP_OBJ:
+			var_b = GetVariable( st->b );
+			if( var_b.evalPtr && var_b.evalPtr->entityNumberPtr )
+			{
+				var_a = GetVariable( st->a );
+				*var_b.evalPtr->entityNumberPtr = *var_a.entityNumberPtr;
+			}
+			break;
 
-			case OP_STOREP_VTOS:
-				var_b = GetVariable( st->b );
-				if( var_b.evalPtr && var_b.evalPtr->stringPtr )
+		case OP_STOREP_OBJENT:
+			var_b = GetVariable( st->b );
+			if( var_b.evalPtr && var_b.evalPtr->entityNumberPtr )
+			{
+				var_a = GetVariable( st->a );
+				obj = GetScriptObject( *var_a.entityNumberPtr );
+				if( !obj )
 				{
-					var_a = GetVariable( st->a );
-					idStr::Copynz( var_b.evalPtr->stringPtr, var_a.vectorPtr->ToString(), MAX_STRING_LEN );
-				}
-				break;
+					*var_b.evalPtr->entityNumberPtr = 0;
 
-			case OP_STOREP_FTOBOOL:
-				var_b = GetVariable( st->b );
-				if( var_b.evalPtr && var_b.evalPtr->intPtr )
-				{
-					var_a = GetVariable( st->a );
-					if( *var_a.floatPtr != 0.0f )
-					{
-						*var_b.evalPtr->intPtr = 1;
-					}
-					else
-					{
-						*var_b.evalPtr->intPtr = 0;
-					}
+					// st->b points to type_pointer, which is just a temporary that gets its type reassigned, so we store the real type in st->c
+					// so that we can do a type check during run time since we don't know what type the script object is at compile time because it
+					// comes from an entity
 				}
-				break;
-
-			case OP_STOREP_BOOLTOF:
-				var_b = GetVariable( st->b );
-				if( var_b.evalPtr && var_b.evalPtr->floatPtr )
+				else if( !obj->GetTypeDef()->Inherits( st->c->TypeDef() ) )
 				{
-					var_a = GetVariable( st->a );
-					*var_b.evalPtr->floatPtr = static_cast<float>( *var_a.intPtr );
+					//Warning( "object '%s' cannot be converted to '%s'", obj->GetTypeName(), st->c->TypeDef()->Name() );
+					*var_b.evalPtr->entityNumberPtr = 0;
 				}
-				break;
-
-			case OP_STOREP_OBJ:
-				var_b = GetVariable( st->b );
-				if( var_b.evalPtr && var_b.evalPtr->entityNumberPtr )
+				else
 				{
-					var_a = GetVariable( st->a );
 					*var_b.evalPtr->entityNumberPtr = *var_a.entityNumberPtr;
 				}
-				break;
+			}
+			break;
 
-			case OP_STOREP_OBJENT:
-				var_b = GetVariable( st->b );
-				if( var_b.evalPtr && var_b.evalPtr->entityNumberPtr )
-				{
-					var_a = GetVariable( st->a );
-					obj = GetScriptObject( *var_a.entityNumberPtr );
-					if( !obj )
-					{
-						*var_b.evalPtr->entityNumberPtr = 0;
+		case OP_ADDRESS:
+			var_a = GetVariable( st->a );
+			var_c = GetVariable( st->c );
+			obj = GetScriptObject( *var_a.entityNumberPtr );
+			if( obj )
+			{
+				var_c.evalPtr->bytePtr = &obj->data[ st->b->value.ptrOffset ];
+			}
+			else
+			{
+				var_c.evalPtr->bytePtr = NULL;
+			}
+			break;
 
-						// st->b points to type_pointer, which is just a temporary that gets its type reassigned, so we store the real type in st->c
-						// so that we can do a type check during run time since we don't know what type the script object is at compile time because it
-						// comes from an entity
-					}
-					else if( !obj->GetTypeDef()->Inherits( st->c->TypeDef() ) )
-					{
-						//Warning( "object '%s' cannot be converted to '%s'", obj->GetTypeName(), st->c->TypeDef()->Name() );
-						*var_b.evalPtr->entityNumberPtr = 0;
-					}
-					else
-					{
-						*var_b.evalPtr->entityNumberPtr = *var_a.entityNumberPtr;
-					}
-				}
-				break;
+		case OP_INDIRECT_F:
+			var_a = GetVariable( st->a );
+			var_c = GetVariable( st->c );
+			obj = GetScriptObject( *var_a.entityNumberPtr );
+			if( obj )
+			{
+				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+				*var_c.floatPtr = *var.floatPtr;
+			}
+			else
+			{
+				*var_c.floatPtr = 0.0f;
+			}
+			break;
 
-			case OP_ADDRESS:
-				var_a = GetVariable( st->a );
-				var_c = GetVariable( st->c );
-				obj = GetScriptObject( *var_a.entityNumberPtr );
-				if( obj )
-				{
-					var_c.evalPtr->bytePtr = &obj->data[ st->b->value.ptrOffset ];
-				}
-				else
-				{
-					var_c.evalPtr->bytePtr = NULL;
-				}
-				break;
+		case OP_INDIRECT_ENT:
+			var_a = GetVariable( st->a );
+			var_c = GetVariable( st->c );
+			obj = GetScriptObject( *var_a.entityNumberPtr );
+			if( obj )
+			{
+				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+				*var_c.entityNumberPtr = *var.entityNumberPtr;
+			}
+			else
+			{
+				*var_c.entityNumberPtr = 0;
+			}
+			break;
 
-			case OP_INDIRECT_F:
-				var_a = GetVariable( st->a );
-				var_c = GetVariable( st->c );
-				obj = GetScriptObject( *var_a.entityNumberPtr );
-				if( obj )
-				{
-					var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
-					*var_c.floatPtr = *var.floatPtr;
-				}
-				else
-				{
-					*var_c.floatPtr = 0.0f;
-				}
-				break;
+		case OP_INDIRECT_BOOL:
+			var_a = GetVariable( st->a );
+			var_c = GetVariable( st->c );
+			obj = GetScriptObject( *var_a.entityNumberPtr );
+			if( obj )
+			{
+				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+				*var_c.intPtr = *var.intPtr;
+			}
+			else
+			{
+				*var_c.intPtr = 0;
+			}
+			break;
 
-			case OP_INDIRECT_ENT:
-				var_a = GetVariable( st->a );
-				var_c = GetVariable( st->c );
-				obj = GetScriptObject( *var_a.entityNumberPtr );
-				if( obj )
-				{
-					var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
-					*var_c.entityNumberPtr = *var.entityNumberPtr;
-				}
-				else
-				{
-					*var_c.entityNumberPtr = 0;
-				}
-				break;
+		case OP_INDIRECT_S:
+			var_a = GetVariable( st->a );
+			obj = GetScriptObject( *var_a.entityNumberPtr );
+			if( obj )
+			{
+				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+				SetString( st->c, var.stringPtr );
+			}
+			else
+			{
+				SetString( st->c, "" );
+			}
+			break;
 
-			case OP_INDIRECT_BOOL:
-				var_a = GetVariable( st->a );
-				var_c = GetVariable( st->c );
-				obj = GetScriptObject( *var_a.entityNumberPtr );
-				if( obj )
-				{
-					var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
-					*var_c.intPtr = *var.intPtr;
-				}
-				else
+		case OP_INDIRECT_V:
+			var_a = GetVariable( st->a );
+			var_c = GetVariable( st->c );
+			obj = GetScriptObject( *var_a.entityNumberPtr );
+			if( obj )
+			{
+				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+				*var_c.vectorPtr = *var.vectorPtr;
+			}
+			else
+			{
+				var_c.vectorPtr->Zero();
+			}
+			break;
+
+		case OP_INDIRECT_OBJ:
+			var_a = GetVariable( st->a );
+			var_c = GetVariable( st->c );
+			obj = GetScriptObject( *var_a.entityNumberPtr );
+			if( !obj )
+			{
+				*var_c.entityNumberPtr = 0;
+			}
+			else
+			{
+				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+				*var_c.entityNumberPtr = *var.entityNumberPtr;
+			}
+			break;
+
+		case OP_PUSH_F:
+			var_a = GetVariable( st->a );
+			Push( *var_a.intPtr );
+			break;
+
+		case OP_PUSH_FTOS:
+			var_a = GetVariable( st->a );
+			PushString( FloatToString( *var_a.floatPtr ) );
+			break;
+
+		case OP_PUSH_BTOF:
+			var_a = GetVariable( st->a );
+			floatVal = *var_a.intPtr;
+			Push( *reinterpret_cast<int*>( &floatVal ) );
+			break;
+
+		case OP_PUSH_FTOB:
+			var_a = GetVariable( st->a );
+			if( *var_a.floatPtr != 0.0f )
+			{
+				Push( 1 );
+			}
+			else
+			{
+				Push( 0 );
+			}
+			break;
+
+		case OP_PUSH_VTOS:
+			var_a = GetVariable( st->a );
+			PushString( var_a.vectorPtr->ToString() );
+			break;
+
+		case OP_PUSH_BTOS:
+			var_a = GetVariable( st->a );
+			PushString( *var_a.intPtr ? "true" : "false" );
+			break;
+
+		case OP_PUSH_ENT:
+			var_a = GetVariable( st->a );
+			Push( *var_a.entityNumberPtr );
+			break;
+
+		case OP_PUSH_S:
+			PushString( GetString( st->a ) );
+			break;
+
+		case OP_PUSH_V:
+			var_a = GetVariable( st->a );
+			// RB: 64 bit fix, changed individual pushes with PushVector
+			/*
+			Push( *reinterpret_cast<int *>( &var_a.vectorPtr->x ) );
+			Push( *reinterpret_cast<int *>( &var_a.vectorPtr->y ) );
+			Push( *reinterpret_cast<int *>( &var_a.vectorPtr->z ) );
+			*/
+			PushVector( *var_a.vectorPtr );
+			// RB end
+			break;
+
+		case OP_PUSH_OBJ:
+			var_a = GetVariable( st->a );
+			Push( *var_a.entityNumberPtr );
+			break;
+
+		case OP_PUSH_OBJENT:
+			var_a = GetVariable( st->a );
+			Push( *var_a.entityNumberPtr );
+			break;
+
+		case OP_BREAK:
+		case OP_CONTINUE:
+		default:
+			Error( "Bad opcode %i", st->op );
+			break;
+	}
+}
+
+/*
+====================
+idInterpreter::Execute
+====================
+*/
+bool idInterpreter::Execute()
+{
+	statement_t*	st;
+	int 		runaway;
+
+	if( threadDying || !currentFunction )
+	{
+		return true;
+	}
+
+	if( multiFrameEvent )
+	{
+		// move to previous instruction and call it again
+		instructionPointer--;
+	}
+
+	runaway = 5000000;
+	executeRunaway = runaway;
+
+	profiling = g_scriptProfile.GetBool();
+	if( profiling )
+	{
+		scriptProfiler.EnterInterpreter( this, runaway );
+	}
+
+	doneProcessing = false;
+
+	if( g_optimizeScripts.GetBool() && ( gameLocal.program.NumFastStatements() == gameLocal.program.NumStatements() ) )
+	{
+		ExecuteFast( runaway );
+	}
+	else
+	{
+		while( !doneProcessing && !threadDying )
+		{
+			instructionPointer++;
+
+			if( !--runaway )
+			{
+				Error( "runaway loop error" );
+			}
+
+			// next statement
+			st = &gameLocal.program.GetStatement( instructionPointer );
+
+			executeRunaway = runaway;
+			ExecuteStatement( st );
+		}
+	}
+
+	if( profiling )
+	{
+		scriptProfiler.LeaveInterpreter( this );
+		profiling = false;
+	}
+
+	return threadDying;
+}
+
+/*
+====================
+idInterpreter::ExecuteFast
+
+Runs the resolved statements of the program.  Every handler dispatches the next
+statement itself, so with computed gotos each handler gets its own indirect branch.
+The instruction pointer advances exactly as in Execute, so the call stack, errors,
+the debugger and save games see the same statements.
+====================
+*/
+void idInterpreter::ExecuteFast( int runaway )
+{
+	const fastStatement_t*	statements;
+	const fastStatement_t*	st;
+	varEval_t				var_a;
+	varEval_t				var_b;
+	varEval_t				var_c;
+
+#ifdef SCRIPT_THREADED_DISPATCH
+	// must match the order of fastOp_t
+	static void* const dispatchTable[] =
+	{
+		&&FASTOP_GENERIC_label,
+		&&FASTOP_GOTO_label,
+		&&FASTOP_IF_label,
+		&&FASTOP_IFNOT_label,
+		&&FASTOP_ADD_F_label,
+		&&FASTOP_ADD_V_label,
+		&&FASTOP_SUB_F_label,
+		&&FASTOP_SUB_V_label,
+		&&FASTOP_MUL_F_label,
+		&&FASTOP_MUL_V_label,
+		&&FASTOP_GE_label,
+		&&FASTOP_LE_label,
+		&&FASTOP_GT_label,
+		&&FASTOP_LT_label,
+		&&FASTOP_EQ_F_label,
+		&&FASTOP_NE_F_label,
+		&&FASTOP_NOT_F_label,
+		&&FASTOP_NOT_BOOL_label,
+		&&FASTOP_UADD_F_label,
+		&&FASTOP_USUB_F_label,
+		&&FASTOP_UINC_F_label,
+		&&FASTOP_UDEC_F_label,
+		&&FASTOP_STORE_label,
+		&&FASTOP_STORE_V_label,
+		&&FASTOP_PUSH_label,
+		&&FASTOP_GE_IFNOT_label,
+		&&FASTOP_LE_IFNOT_label,
+		&&FASTOP_GT_IFNOT_label,
+		&&FASTOP_LT_IFNOT_label,
+		&&FASTOP_EQ_F_IFNOT_label,
+		&&FASTOP_NE_F_IFNOT_label,
+		&&FASTOP_ADD_F_STORE_label,
+		&&FASTOP_SUB_F_STORE_label,
+		&&FASTOP_MUL_F_STORE_label,
+	};
+	compile_time_assert( sizeof( dispatchTable ) / sizeof( dispatchTable[ 0 ] ) == NUM_FASTOPS );
+#endif
+
+	statements = gameLocal.program.GetFastStatements();
+
+	for( ;; )
+	{
+		if( !--runaway )
+		{
+			Error( "runaway loop error" );
+		}
+
+		// next statement
+		st = &statements[ ++instructionPointer ];
+
+		switch( st->op )
+		{
+				FAST_OP( FASTOP_GENERIC )
+				executeRunaway = runaway;
+				ExecuteStatement( &gameLocal.program.GetStatement( instructionPointer ) );
+				if( doneProcessing || threadDying )
 				{
-					*var_c.intPtr = 0;
+					return;
 				}
-				break;
+				statements = gameLocal.program.GetFastStatements();
+				FAST_NEXT();
 
-			case OP_INDIRECT_S:
-				var_a = GetVariable( st->a );
-				obj = GetScriptObject( *var_a.entityNumberPtr );
-				if( obj )
+				FAST_OP( FASTOP_GOTO )
+				instructionPointer += st->jumpOffset - 1;
+				FAST_NEXT();
+
+				FAST_OP( FASTOP_IF )
+				var_a = FastVariable( st->a );
+				if( *var_a.intPtr != 0 )
 				{
-					var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
-					SetString( st->c, var.stringPtr );
+					instructionPointer += st->jumpOffset - 1;
 				}
-				else
+				FAST_NEXT();
+
+				FAST_OP( FASTOP_IFNOT )
+				var_a = FastVariable( st->a );
+				if( *var_a.intPtr == 0 )
 				{
-					SetString( st->c, "" );
+					instructionPointer += st->jumpOffset - 1;
 				}
-				break;
+				FAST_NEXT();
 
-			case OP_INDIRECT_V:
-				var_a = GetVariable( st->a );
-				var_c = GetVariable( st->c );
-				obj = GetScriptObject( *var_a.entityNumberPtr );
-				if( obj )
+				FAST_OP( FASTOP_ADD_F )
+				var_a = FastVariable( st->a );
+				var_b = FastVariable( st->b );
+				var_c = FastVariable( st->c );
+				*var_c.floatPtr = *var_a.floatPtr + *var_b.floatPtr;
+				FAST_NEXT();
+
+				FAST_OP( FASTOP_ADD_V )
+				var_a = FastVariable( st->a );
+				var_b = FastVariable( st->b );
+				var_c = FastVariable( st->c );
+				*var_c.vectorPtr = *var_a.vectorPtr + *var_b.vectorPtr;
+				FAST_NEXT();
+
+				FAST_OP( FASTOP_SUB_F )
+				var_a = FastVariable( st->a );
+				var_b = FastVariable( st->b );
+				var_c = FastVariable( st->c );
+				*var_c.floatPtr = *var_a.floatPtr - *var_b.floatPtr;
+				FAST_NEXT();
+
+				FAST_OP( FASTOP_SUB_V )
+				var_a = FastVariable( st->a );
+				var_b = FastVariable( st->b );
+				var_c = FastVariable( st->c );
+				*var_c.vectorPtr = *var_a.vectorPtr - *var_b.vectorPtr;
+				FAST_NEXT();
+
+				FAST_OP( FASTOP_MUL_F )
+				var_a = FastVariable( st->a );
+				var_b = FastVariable( st->b );
+				var_c = FastVariable( st->c );
+				*var_c.floatPtr = *var_a.floatPtr * *var_b.floatPtr;
+				FAST_NEXT();
+
+				FAST_OP( FASTOP_MUL_V )
+				var_a = FastVariable( st->a );
+				var_b = FastVariable( st->b );
+				var_c = FastVariable( st->c );
+				*var_c.floatPtr = *var_a.vectorPtr * *var_b.vectorPtr;
+				FAST_NEXT();
+
+				FAST_OP( FASTOP_GE )
+				var_a = FastVariable( st->a );
+				var_b = FastVariable( st->b );
+				var_c = FastVariable( st->c );
+				*var_c.floatPtr = ( *var_a.floatPtr >= *var_b.floatPtr );
+				FAST_NEXT();
+
+				FAST_OP( FASTOP_LE )
+				var_a = FastVariable( st->a );
+				var_b = FastVariable( st->b );
+				var_c = FastVariable( st->c );
+				*var_c.floatPtr = ( *var_a.floatPtr <= *var_b.floatPtr );
+				FAST_NEXT();
+
+				FAST_OP( FASTOP_GT )
+				var_a = FastVariable( st->a );
+				var_b = FastVariable( st->b );
+				var_c = FastVariable( st->c );
+				*var_c.floatPtr = ( *var_a.floatPtr > *var_b.floatPtr );
+				FAST_NEXT();
+
+				FAST_OP( FASTOP_LT )
+				var_a = FastVariable( st->a );
+				var_b = FastVariable( st->b );
+				var_c = FastVariable( st->c );
+				*var_c.floatPtr = ( *var_a.floatPtr < *var_b.floatPtr );
+				FAST_NEXT();
+
+				FAST_OP( FASTOP_EQ_F )
+				var_a = FastVariable( st->a );
+				var_b = FastVariable( st->b );
+				var_c = FastVariable( st->c );
+				*var_c.floatPtr = ( *var_a.floatPtr == *var_b.floatPtr );
+				FAST_NEXT();
+
+				FAST_OP( FASTOP_NE_F )
+				var_a = FastVariable( st->a );
+				var_b = FastVariable( st->b );
+				var_c = FastVariable( st->c );
+				*var_c.floatPtr = ( *var_a.floatPtr != *var_b.floatPtr );
+				FAST_NEXT();
+
+				FAST_OP( FASTOP_NOT_F )
+				var_a = FastVariable( st->a );
+				var_c = FastVariable( st->c );
+				*var_c.floatPtr = ( *var_a.floatPtr == 0.0f );
+				FAST_NEXT();
+
+				FAST_OP( FASTOP_NOT_BOOL )
+				var_a = FastVariable( st->a );
+				var_c = FastVariable( st->c );
+				*var_c.floatPtr = ( *var_a.intPtr == 0 );
+				FAST_NEXT();
+
+				FAST_OP( FASTOP_UADD_F )
+				var_a = FastVariable( st->a );
+				var_b = FastVariable( st->b );
+				*var_b.floatPtr += *var_a.floatPtr;
+				FAST_NEXT();
+
+				FAST_OP( FASTOP_USUB_F )
+				var_a = FastVariable( st->a );
+				var_b = FastVariable( st->b );
+				*var_b.floatPtr -= *var_a.floatPtr;
+				FAST_NEXT();
+
+				FAST_OP( FASTOP_UINC_F )
+				var_a = FastVariable( st->a );
+				( *var_a.floatPtr )++;
+				FAST_NEXT();
+
+				FAST_OP( FASTOP_UDEC_F )
+				var_a = FastVariable( st->a );
+				( *var_a.floatPtr )--;
+				FAST_NEXT();
+
+				FAST_OP( FASTOP_STORE )
+				var_a = FastVariable( st->a );
+				var_b = FastVariable( st->b );
+				*var_b.intPtr = *var_a.intPtr;
+				FAST_NEXT();
+
+				FAST_OP( FASTOP_STORE_V )
+				var_a = FastVariable( st->a );
+				var_b = FastVariable( st->b );
+				*var_b.vectorPtr = *var_a.vectorPtr;
+				FAST_NEXT();
+
+				FAST_OP( FASTOP_PUSH )
+				var_a = FastVariable( st->a );
+				Push( *var_a.intPtr );
+				FAST_NEXT();
+
+				FAST_OP( FASTOP_GE_IFNOT )
+				var_a = FastVariable( st->a );
+				var_b = FastVariable( st->b );
+				var_c = FastVariable( st->c );
+				*var_c.floatPtr = ( *var_a.floatPtr >= *var_b.floatPtr );
+				// conditional jump on the result
+				instructionPointer++;
+				if( *var_c.intPtr == 0 )
 				{
-					var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
-					*var_c.vectorPtr = *var.vectorPtr;
+					instructionPointer += st->jumpOffset - 1;
 				}
-				else
+				FAST_NEXT();
+
+				FAST_OP( FASTOP_LE_IFNOT )
+				var_a = FastVariable( st->a );
+				var_b = FastVariable( st->b );
+				var_c = FastVariable( st->c );
+				*var_c.floatPtr = ( *var_a.floatPtr <= *var_b.floatPtr );
+				// conditional jump on the result
+				instructionPointer++;
+				if( *var_c.intPtr == 0 )
 				{
-					var_c.vectorPtr->Zero();
+					instructionPointer += st->jumpOffset - 1;
 				}
-				break;
+				FAST_NEXT();
 
-			case OP_INDIRECT_OBJ:
-				var_a = GetVariable( st->a );
-				var_c = GetVariable( st->c );
-				obj = GetScriptObject( *var_a.entityNumberPtr );
-				if( !obj )
+				FAST_OP( FASTOP_GT_IFNOT )
+				var_a = FastVariable( st->a );
+				var_b = FastVariable( st->b );
+				var_c = FastVariable( st->c );
+				*var_c.floatPtr = ( *var_a.floatPtr > *var_b.floatPtr );
+				// conditional jump on the result
+				instructionPointer++;
+				if( *var_c.intPtr == 0 )
 				{
-					*var_c.entityNumberPtr = 0;
+					instructionPointer += st->jumpOffset - 1;
 				}
-				else
+				FAST_NEXT();
+
+				FAST_OP( FASTOP_LT_IFNOT )
+				var_a = FastVariable( st->a );
+				var_b = FastVariable( st->b );
+				var_c = FastVariable( st->c );
+				*var_c.floatPtr = ( *var_a.floatPtr < *var_b.floatPtr );
+				// conditional jump on the result
+				instructionPointer++;
+				if( *var_c.intPtr == 0 )
 				{
-					var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
-					*var_c.entityNumberPtr = *var.entityNumberPtr;
+					instructionPointer += st->jumpOffset - 1;
 				}
-				break;
-
-			case OP_PUSH_F:
-				var_a = GetVariable( st->a );
-				Push( *var_a.intPtr );
-				break;
-
-			case OP_PUSH_FTOS:
-				var_a = GetVariable( st->a );
-				PushString( FloatToString( *var_a.floatPtr ) );
-				break;
+				FAST_NEXT();
 
-			case OP_PUSH_BTOF:
-				var_a = GetVariable( st->a );
-				floatVal = *var_a.intPtr;
-				Push( *reinterpret_cast<int*>( &floatVal ) );
-				break;
-
-			case OP_PUSH_FTOB:
-				var_a = GetVariable( st->a );
-				if( *var_a.floatPtr != 0.0f )
+				FAST_OP( FASTOP_EQ_F_IFNOT )
+				var_a = FastVariable( st->a );
+				var_b = FastVariable( st->b );
+				var_c = FastVariable( st->c );
+				*var_c.floatPtr = ( *var_a.floatPtr == *var_b.floatPtr );
+				// conditional jump on the result
+				instructionPointer++;
+				if( *var_c.intPtr == 0 )
 				{
-					Push( 1 );
+					instructionPointer += st->jumpOffset - 1;
 				}
-				else
+				FAST_NEXT();
+
+				FAST_OP( FASTOP_NE_F_IFNOT )
+				var_a = FastVariable( st->a );
+				var_b = FastVariable( st->b );
+				var_c = FastVariable( st->c );
+				*var_c.floatPtr = ( *var_a.floatPtr != *var_b.floatPtr );
+				// conditional jump on the result
+				instructionPointer++;
+				if( *var_c.intPtr == 0 )
 				{
-					Push( 0 );
+					instructionPointer += st->jumpOffset - 1;
 				}
-				break;
+				FAST_NEXT();
 
-			case OP_PUSH_VTOS:
-				var_a = GetVariable( st->a );
-				PushString( var_a.vectorPtr->ToString() );
-				break;
-
-			case OP_PUSH_BTOS:
-				var_a = GetVariable( st->a );
-				PushString( *var_a.intPtr ? "true" : "false" );
-				break;
-
-			case OP_PUSH_ENT:
-				var_a = GetVariable( st->a );
-				Push( *var_a.entityNumberPtr );
-				break;
-
-			case OP_PUSH_S:
-				PushString( GetString( st->a ) );
-				break;
-
-			case OP_PUSH_V:
-				var_a = GetVariable( st->a );
-				// RB: 64 bit fix, changed individual pushes with PushVector
-				/*
-				Push( *reinterpret_cast<int *>( &var_a.vectorPtr->x ) );
-				Push( *reinterpret_cast<int *>( &var_a.vectorPtr->y ) );
-				Push( *reinterpret_cast<int *>( &var_a.vectorPtr->z ) );
-				*/
-				PushVector( *var_a.vectorPtr );
-				// RB end
-				break;
-
-			case OP_PUSH_OBJ:
-				var_a = GetVariable( st->a );
-				Push( *var_a.entityNumberPtr );
-				break;
-
-			case OP_PUSH_OBJENT:
-				var_a = GetVariable( st->a );
-				Push( *var_a.entityNumberPtr );
-				break;
+				FAST_OP( FASTOP_ADD_F_STORE )
+				var_a = FastVariable( st->a );
+				var_b = FastVariable( st->b );
+				var_c = FastVariable( st->c );
+				*var_c.floatPtr = *var_a.floatPtr + *var_b.floatPtr;
+				// store of the result
+				instructionPointer++;
+				var_b = FastVariable( st->d );
+				*var_b.floatPtr = *var_c.floatPtr;
+				FAST_NEXT();
+
+				FAST_OP( FASTOP_SUB_F_STORE )
+				var_a = FastVariable( st->a );
+				var_b = FastVariable( st->b );
+				var_c = FastVariable( st->c );
+				*var_c.floatPtr = *var_a.floatPtr - *var_b.floatPtr;
+				// store of the result
+				instructionPointer++;
+				var_b = FastVariable( st->d );
+				*var_b.floatPtr = *var_c.floatPtr;
+				FAST_NEXT();
+
+				FAST_OP( FASTOP_MUL_F_STORE )
+				var_a = FastVariable( st->a );
+				var_b = FastVariable( st->b );
+				var_c = FastVariable( st->c );
+				*var_c.floatPtr = *var_a.floatPtr * *var_b.floatPtr;
+				// store of the result
+				instructionPointer++;
+				var_b = FastVariable( st->d );
+				*var_b.floatPtr = *var_c.floatPtr;
+				FAST_NEXT();
 
-			case OP_BREAK:
-			case OP_CONTINUE:
 			default:
-				Error( "Bad opcode %i", st->op );
-				break;
+				Error( "Bad resolved opcode %i", st->op );
+				return;
 		}
 	}
-
-	return threadDying;
 }
 
 // RB: moved from Script_Interpreter.h to avoid include problems with the script debugger
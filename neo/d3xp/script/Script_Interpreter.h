@@ -64,6 +64,9 @@ private:
 
 	idThread*			thread;
 
+	int					executeRunaway;		// runaway count before the last generic statement, for the profiler
+	bool				profiling;			// charging costs to the script profiler during Execute
+
 	void				PopParms( int numParms );
 
 	// RB begin
@@ -84,6 +87,10 @@ private:
 	idScriptObject*		GetScriptObject( int entnum ) const;
 	void				NextInstruction( int position );
 
+	varEval_t			FastVariable( const fastOperand_t& operand );
+	void				ExecuteStatement( statement_t* st );
+	void				ExecuteFast( int runaway );
+
 	void				LeaveFunction( idVarDef* returnDef );
 	void				CallEvent( const function_t* func, int argsize );
 	void				CallSysEvent( const function_t* func, int argsize );
@@ -127,6 +134,10 @@ public:
 	const prstack_t*		GetCallstack() const;
 	const function_t*	GetCurrentFunction() const;
 	idThread*			GetThread() const;
+	int					GetRunaway() const
+	{
+		return executeRunaway;
+	}
 
 };
 
@@ -286,6 +297,25 @@ ID_INLINE varEval_t idInterpreter::GetVariable( idVarDef* def )
 	}
 }
 
+/*
+====================
+idInterpreter::FastVariable
+====================
+*/
+ID_INLINE varEval_t idInterpreter::FastVariable( const fastOperand_t& operand )
+{
+	varEval_t val;
+	if( operand.ptr != NULL )
+	{
+		val.bytePtr = operand.ptr;
+	}
+	else
+	{
+		val.bytePtr = &localstack[ localstackBase + operand.stackOffset ];
+	}
+	return val;
+}
+
 /*
 ====================
 idInterpreter::NextInstruction
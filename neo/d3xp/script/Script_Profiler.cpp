@@ -0,0 +1,477 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#include "precompiled.h"
+#pragma hdrstop
+
+#include "../Game_local.h"
+
+idScriptProfiler	scriptProfiler;
+
+/*
+================
+idScriptProfiler::idScriptProfiler
+================
+*/
+idScriptProfiler::idScriptProfiler()
+{
+	lastTicks = 0.0;
+	startFrame = 0;
+}
+
+/*
+================
+idScriptProfiler::Clear
+================
+*/
+void idScriptProfiler::Clear()
+{
+	contexts.Clear();
+	functionStats.Clear();
+	eventStats.Clear();
+	stacks.Clear();
+	stackHash.Free();
+	lastTicks = Sys_GetClockTicks();
+	startFrame = gameLocal.framenum;
+}
+
+/*
+================
+idScriptProfiler::FunctionStat
+================
+*/
+scriptProfileStat_t& idScriptProfiler::FunctionStat( int functionNum )
+{
+	if( functionNum >= functionStats.Num() )
+	{
+		int num = functionStats.Num();
+		functionStats.SetNum( functionNum + 1 );
+		memset( &functionStats[ num ], 0, ( functionStats.Num() - num ) * sizeof( scriptProfileStat_t ) );
+	}
+	return functionStats[ functionNum ];
+}
+
+/*
+================
+idScriptProfiler::EventStat
+================
+*/
+scriptProfileStat_t& idScriptProfiler::EventStat( int eventNum )
+{
+	if( eventNum >= eventStats.Num() )
+	{
+		int num = eventStats.Num();
+		eventStats.SetNum( eventNum + 1 );
+		memset( &eventStats[ num ], 0, ( eventStats.Num() - num ) * sizeof( scriptProfileStat_t ) );
+	}
+	return eventStats[ eventNum ];
+}
+
+/*
+================
+idScriptProfiler::EnterInterpreter
+================
+*/
+void idScriptProfiler::EnterInterpreter( const idInterpreter* interpreter, int runaway )
+{
+	context_t* context;
+
+	if( contexts.Num() )
+	{
+		Charge();
+	}
+	else
+	{
+		lastTicks = Sys_GetClockTicks();
+	}
+
+	context = contexts.Alloc();
+	if( context == NULL )
+	{
+		// an error unwound the interpreters without leaving them
+		contexts.Clear();
+		context = contexts.Alloc();
+	}
+
+	context->interpreter = interpreter;
+	context->event = NULL;
+	context->runaway = runaway;
+}
+
+/*
+================
+idScriptProfiler::LeaveInterpreter
+================
+*/
+void idScriptProfiler::LeaveInterpreter( const idInterpreter* interpreter )
+{
+	Charge();
+
+	if( contexts.Num() && contexts[ contexts.Num() - 1 ].interpreter == interpreter )
+	{
+		contexts.RemoveIndex( contexts.Num() - 1 );
+	}
+	else
+	{
+		contexts.Clear();
+	}
+}
+
+/*
+================
+idScriptProfiler::FunctionCall
+================
+*/
+void idScriptProfiler::FunctionCall( const function_t* func )
+{
+	FunctionStat( gameLocal.program.GetFunctionIndex( func ) ).calls++;
+}
+
+/*
+================
+idScriptProfiler::BeginEvent
+================
+*/
+void idScriptProfiler::BeginEvent( const idEventDef* event )
+{
+	Charge();
+
+	if( contexts.Num() )
+	{
+		contexts[ contexts.Num() - 1 ].event = event;
+	}
+	EventStat( event->GetEventNum() ).calls++;
+}
+
+/*
+================
+idScriptProfiler::EndEvent
+================
+*/
+void idScriptProfiler::EndEvent()
+{
+	Charge();
+
+	if( contexts.Num() )
+	{
+		contexts[ contexts.Num() - 1 ].event = NULL;
+	}
+}
+
+/*
+================
+idScriptProfiler::Charge
+
+Charges the time and instructions since the last charge to what the innermost interpreter is running.
+================
+*/
+void idScriptProfiler::Charge()
+{
+	double ticks, now;
+	int runaway;
+	const function_t* func;
+
+	now = Sys_GetClockTicks();
+	ticks = now - lastTicks;
+	lastTicks = now;
+
+	if( !contexts.Num() )
+	{
+		return;
+	}
+
+	context_t& context = contexts[ contexts.Num() - 1 ];
+	func = context.interpreter->GetCurrentFunction();
+
+	// instructions always belong to the function, even the event call itself
+	runaway = context.interpreter->GetRunaway();
+	if( func != NULL && context.runaway > runaway )
+	{
+		FunctionStat( gameLocal.program.GetFunctionIndex( func ) ).instructions += context.runaway - runaway;
+	}
+	context.runaway = runaway;
+
+	if( context.event != NULL )
+	{
+		EventStat( context.event->GetEventNum() ).ticks += ticks;
+	}
+	else if( func != NULL )
+	{
+		FunctionStat( gameLocal.program.GetFunctionIndex( func ) ).ticks += ticks;
+	}
+	else
+	{
+		return;
+	}
+
+	ChargeStack( context, ticks );
+}
+
+/*
+================
+idScriptProfiler::ChargeStack
+================
+*/
+void idScriptProfiler::ChargeStack( const context_t& context, double ticks )
+{
+	idStaticList < int, MAX_STACK_DEPTH + 2 > frames;
+	const prstack_t* callStack;
+	const function_t* func;
+	int i, j, depth, hash;
+
+	// the bottom of the call stack is the function that was running before the first call
+	callStack = context.interpreter->GetCallstack();
+	depth = context.interpreter->GetCallstackDepth();
+	for( i = 1; i < depth; i++ )
+	{
+		if( callStack[ i ].f != NULL )
+		{
+			frames.Append( gameLocal.program.GetFunctionIndex( callStack[ i ].f ) );
+		}
+	}
+	func = context.interpreter->GetCurrentFunction();
+	if( func != NULL )
+	{
+		frames.Append( gameLocal.program.GetFunctionIndex( func ) );
+	}
+	if( context.event != NULL )
+	{
+		frames.Append( -1 - context.event->GetEventNum() );
+	}
+
+	hash = 0;
+	for( i = 0; i < frames.Num(); i++ )
+	{
+		hash = hash * 31 + frames[ i ];
+	}
+
+	for( i = stackHash.First( hash ); i != -1; i = stackHash.Next( i ) )
+	{
+		const stack_t& stack = stacks[ i ];
+		if( stack.frames.Num() != frames.Num() )
+		{
+			continue;
+		}
+		for( j = 0; j < frames.Num(); j++ )
+		{
+			if( stack.frames[ j ] != frames[ j ] )
+			{
+				break;
+			}
+		}
+		if( j == frames.Num() )
+		{
+			stacks[ i ].ticks += ticks;
+			return;
+		}
+	}
+
+	stack_t& stack = stacks.Alloc();
+	stack.frames.SetNum( frames.Num() );
+	for( i = 0; i < frames.Num(); i++ )
+	{
+		stack.frames[ i ] = frames[ i ];
+	}
+	stack.ticks = ticks;
+	stackHash.Add( hash, stacks.Num() - 1 );
+}
+
+/*
+================
+idScriptProfiler::StackName
+================
+*/
+void idScriptProfiler::StackName( const stack_t& stack, idStr& name ) const
+{
+	int i;
+
+	name.Clear();
+	for( i = 0; i < stack.frames.Num(); i++ )
+	{
+		if( i > 0 )
+		{
+			name += ";";
+		}
+		if( stack.frames[ i ] < 0 )
+		{
+			name += va( "[%s]", idEventDef::GetEventCommand( -1 - stack.frames[ i ] )->GetName() );
+		}
+		else
+		{
+			name += gameLocal.program.GetFunction( stack.frames[ i ] )->Name();
+		}
+	}
+}
+
+/*
+================
+idSort_ScriptProfileLine
+================
+*/
+typedef struct scriptProfileLine_s
+{
+	const char*					name;
+	const scriptProfileStat_t*	stat;
+} scriptProfileLine_t;
+
+class idSort_ScriptProfileLine : public idSort_Quick< scriptProfileLine_t, idSort_ScriptProfileLine >
+{
+public:
+	int Compare( const scriptProfileLine_t& a, const scriptProfileLine_t& b ) const
+	{
+		if( a.stat->ticks > b.stat->ticks )
+		{
+			return -1;
+		}
+		if( a.stat->ticks < b.stat->ticks )
+		{
+			return 1;
+		}
+		return 0;
+	}
+};
+
+/*
+================
+idScriptProfiler::PrintStats
+================
+*/
+void idScriptProfiler::PrintStats( int maxLines ) const
+{
+	idList<scriptProfileLine_t> functionLines;
+	idList<scriptProfileLine_t> eventLines;
+	double totalTicks, toMS;
+	int i, numFrames;
+
+	totalTicks = 0.0;
+	for( i = 0; i < functionStats.Num(); i++ )
+	{
+		if( functionStats[ i ].calls || functionStats[ i ].ticks > 0.0 )
+		{
+			scriptProfileLine_t& line = functionLines.Alloc();
+			line.name = gameLocal.program.GetFunction( i )->Name();
+			line.stat = &functionStats[ i ];
+			totalTicks += functionStats[ i ].ticks;
+		}
+	}
+	for( i = 0; i < eventStats.Num(); i++ )
+	{
+		if( eventStats[ i ].calls || eventStats[ i ].ticks > 0.0 )
+		{
+			scriptProfileLine_t& line = eventLines.Alloc();
+			line.name = idEventDef::GetEventCommand( i )->GetName();
+			line.stat = &eventStats[ i ];
+			totalTicks += eventStats[ i ].ticks;
+		}
+	}
+
+	functionLines.SortWithTemplate( idSort_ScriptProfileLine() );
+	eventLines.SortWithTemplate( idSort_ScriptProfileLine() );
+
+	toMS = 1000.0 / Sys_ClockTicksPerSecond();
+	numFrames = Max( 1, gameLocal.framenum - startFrame );
+
+	gameLocal.Printf( "%d frames, %.2f ms script time, %.3f ms per frame\n", numFrames, totalTicks * toMS, totalTicks * toMS / numFrames );
+	if( totalTicks <= 0.0 )
+	{
+		totalTicks = 1.0;
+	}
+
+	gameLocal.Printf( "\n    self ms      %%     calls   instructions  function\n" );
+	for( i = 0; i < functionLines.Num() && i < maxLines; i++ )
+	{
+		const scriptProfileStat_t* stat = functionLines[ i ].stat;
+		gameLocal.Printf( "%11.3f %6.2f %9d %14lld  %s\n", stat->ticks * toMS, 100.0 * stat->ticks / totalTicks, stat->calls, ( long long )stat->instructions, functionLines[ i ].name );
+	}
+
+	gameLocal.Printf( "\n    self ms      %%     calls  event\n" );
+	for( i = 0; i < eventLines.Num() && i < maxLines; i++ )
+	{
+		const scriptProfileStat_t* stat = eventLines[ i ].stat;
+		gameLocal.Printf( "%11.3f %6.2f %9d  %s\n", stat->ticks * toMS, 100.0 * stat->ticks / totalTicks, stat->calls, eventLines[ i ].name );
+	}
+}
+
+/*
+================
+idScriptProfiler::WriteStacks
+
+Writes the folded call stacks with their self time in microseconds, the input format of flamegraph.pl.
+================
+*/
+void idScriptProfiler::WriteStacks( const char* fileName ) const
+{
+	idFile* file;
+	idStr name;
+	double toUS;
+	int i;
+
+	file = fileSystem->OpenFileWrite( fileName );
+	if( file == NULL )
+	{
+		gameLocal.Warning( "couldn't open %s", fileName );
+		return;
+	}
+
+	toUS = 1000000.0 / Sys_ClockTicksPerSecond();
+	for( i = 0; i < stacks.Num(); i++ )
+	{
+		StackName( stacks[ i ], name );
+		file->Printf( "%s %lld\n", name.c_str(), ( long long )( stacks[ i ].ticks * toUS ) );
+	}
+
+	fileSystem->CloseFile( file );
+
+	gameLocal.Printf( "wrote %d call stacks to %s\n", stacks.Num(), fileName );
+}
+
+/*
+================
+idScriptProfiler::Profile_f
+================
+*/
+void idScriptProfiler::Profile_f( const idCmdArgs& args )
+{
+	if( args.Argc() > 1 && !idStr::Icmp( args.Argv( 1 ), "clear" ) )
+	{
+		scriptProfiler.Clear();
+		return;
+	}
+
+	if( args.Argc() > 1 && !idStr::Icmp( args.Argv( 1 ), "write" ) )
+	{
+		scriptProfiler.WriteStacks( args.Argc() > 2 ? args.Argv( 2 ) : "script/profile.folded" );
+		return;
+	}
+
+	if( !g_scriptProfile.GetBool() )
+	{
+		gameLocal.Printf( "set g_scriptProfile 1 to profile the scripts\n" );
+	}
+	scriptProfiler.PrintStats( args.Argc() > 1 ? atoi( args.Argv( 1 ) ) : 30 );
+}
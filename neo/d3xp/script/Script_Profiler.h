@@ -0,0 +1,100 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#ifndef __SCRIPT_PROFILER_H__
+#define __SCRIPT_PROFILER_H__
+
+/***********************************************************************
+
+idScriptProfiler
+
+Instrumented profiler for the script interpreter.  While g_scriptProfile is set,
+time and instructions are charged to the script function or native event that
+is running whenever an interpreter enters or leaves a function or event, so all
+numbers are exclusive (self) costs.  The costs are also kept per call stack for
+flame graphs.
+
+***********************************************************************/
+
+typedef struct scriptProfileStat_s
+{
+	int						calls;
+	int64					instructions;
+	double					ticks;
+} scriptProfileStat_t;
+
+class idScriptProfiler
+{
+public:
+	idScriptProfiler();
+
+	void					Clear();
+
+	void					EnterInterpreter( const idInterpreter* interpreter, int runaway );
+	void					LeaveInterpreter( const idInterpreter* interpreter );
+	void					FunctionCall( const function_t* func );
+	void					BeginEvent( const idEventDef* event );
+	void					EndEvent();
+	void					Charge();
+
+	void					PrintStats( int maxLines ) const;
+	void					WriteStacks( const char* fileName ) const;
+
+	static void				Profile_f( const idCmdArgs& args );
+
+private:
+	typedef struct context_s
+	{
+		const idInterpreter*	interpreter;
+		const idEventDef*		event;
+		int						runaway;		// runaway count of the interpreter at the last charge
+	} context_t;
+
+	typedef struct stack_s
+	{
+		idList<int, TAG_SCRIPT>	frames;			// function numbers, events are stored as -1 - event number
+		double					ticks;
+	} stack_t;
+
+	idStaticList<context_t, MAX_STACK_DEPTH>	contexts;		// nested interpreters, threads started from events run nested
+	double										lastTicks;
+	int											startFrame;			// game frame the profile was cleared
+	idList<scriptProfileStat_t, TAG_SCRIPT>		functionStats;
+	idList<scriptProfileStat_t, TAG_SCRIPT>		eventStats;
+	idList<stack_t, TAG_SCRIPT>					stacks;
+	idHashIndex									stackHash;
+
+	scriptProfileStat_t& 	FunctionStat( int functionNum );
+	scriptProfileStat_t& 	EventStat( int eventNum );
+	void					ChargeStack( const context_t& context, double ticks );
+	void					StackName( const stack_t& stack, idStr& name ) const;
+};
+
+extern idScriptProfiler		scriptProfiler;
+
+#endif /* !__SCRIPT_PROFILER_H__ */
@@ -1931,6 +1931,7 @@ void idProgram::BeginCompilation()
 	statement_t*	statement;
 
 	FreeData();
+	scriptProfiler.Clear();
 
 #if defined(USE_EXCEPTIONS)
 	try
@@ -2064,6 +2065,226 @@ void idProgram::FinishCompilation()
 	}
 }
 
+/*
+==============
+idProgram::ResolveOperand
+==============
+*/
+bool idProgram::ResolveOperand( const idVarDef* def, fastOperand_t& operand ) const
+{
+	operand.ptr = NULL;
+	operand.stackOffset = 0;
+
+	if( def == NULL )
+	{
+		return false;
+	}
+
+	if( def->initialized == idVarDef::stackVariable )
+	{
+		operand.stackOffset = def->value.stackOffset;
+		return true;
+	}
+
+	operand.ptr = def->value.bytePtr;
+	return ( operand.ptr != NULL );
+}
+
+/*
+==============
+idProgram::ResolveStatements
+
+Builds the resolved copy of all statements compiled since the last call.
+==============
+*/
+void idProgram::ResolveStatements()
+{
+	int i, first, fastOp;
+	bool resolved;
+
+	first = fastStatements.Num();
+	fastStatements.SetNum( statements.Num() );
+
+	for( i = first; i < statements.Num(); i++ )
+	{
+		const statement_t& st = statements[ i ];
+		fastStatement_t& fst = fastStatements[ i ];
+
+		memset( &fst, 0, sizeof( fst ) );
+		fst.op = FASTOP_GENERIC;
+
+		switch( st.op )
+		{
+			case OP_GOTO:
+				fst.op = FASTOP_GOTO;
+				fst.jumpOffset = st.a->value.jumpOffset;
+				continue;
+
+			case OP_IF:
+			case OP_IFNOT:
+				if( ResolveOperand( st.a, fst.a ) )
+				{
+					fst.op = ( st.op == OP_IF ) ? FASTOP_IF : FASTOP_IFNOT;
+					fst.jumpOffset = st.b->value.jumpOffset;
+				}
+				continue;
+
+			case OP_ADD_F:
+				fastOp = FASTOP_ADD_F;
+				break;
+			case OP_ADD_V:
+				fastOp = FASTOP_ADD_V;
+				break;
+			case OP_SUB_F:
+				fastOp = FASTOP_SUB_F;
+				break;
+			case OP_SUB_V:
+				fastOp = FASTOP_SUB_V;
+				break;
+			case OP_MUL_F:
+				fastOp = FASTOP_MUL_F;
+				break;
+			case OP_MUL_V:
+				fastOp = FASTOP_MUL_V;
+				break;
+			case OP_GE:
+				fastOp = FASTOP_GE;
+				break;
+			case OP_LE:
+				fastOp = FASTOP_LE;
+				break;
+			case OP_GT:
+				fastOp = FASTOP_GT;
+				break;
+			case OP_LT:
+				fastOp = FASTOP_LT;
+				break;
+			case OP_EQ_F:
+				fastOp = FASTOP_EQ_F;
+				break;
+			case OP_NE_F:
+				fastOp = FASTOP_NE_F;
+				break;
+			case OP_NOT_F:
+				fastOp = FASTOP_NOT_F;
+				break;
+			case OP_NOT_BOOL:
+				fastOp = FASTOP_NOT_BOOL;
+				break;
+			case OP_UADD_F:
+				fastOp = FASTOP_UADD_F;
+				break;
+			case OP_USUB_F:
+				fastOp = FASTOP_USUB_F;
+				break;
+			case OP_UINC_F:
+				fastOp = FASTOP_UINC_F;
+				break;
+			case OP_UDEC_F:
+				fastOp = FASTOP_UDEC_F;
+				break;
+			case OP_STORE_F:
+			case OP_STORE_ENT:
+			case OP_STORE_BOOL:
+			case OP_STORE_OBJ:
+			case OP_STORE_ENTOBJ:
+				fastOp = FASTOP_STORE;
+				break;
+			case OP_STORE_V:
+				fastOp = FASTOP_STORE_V;
+				break;
+			case OP_PUSH_F:
+			case OP_PUSH_ENT:
+			case OP_PUSH_OBJ:
+			case OP_PUSH_OBJENT:
+				fastOp = FASTOP_PUSH;
+				break;
+			default:
+				continue;
+		}
+
+		// all operands used by the opcode must be plain variables
+		resolved = true;
+		if( st.a && !ResolveOperand( st.a, fst.a ) )
+		{
+			resolved = false;
+		}
+		if( st.b && !ResolveOperand( st.b, fst.b ) )
+		{
+			resolved = false;
+		}
+		if( st.c && !ResolveOperand( st.c, fst.c ) )
+		{
+			resolved = false;
+		}
+		if( resolved )
+		{
+			fst.op = fastOp;
+		}
+	}
+
+	// fuse a comparison with the conditional jump on its result, and arithmetic with the store of its result
+	// the second statement stays as is so jumps into the middle of a superinstruction still work
+	for( i = Max( first, 1 ); i < statements.Num(); i++ )
+	{
+		const statement_t& prev = statements[ i - 1 ];
+		const statement_t& st = statements[ i ];
+		fastStatement_t& fprev = fastStatements[ i - 1 ];
+		const fastStatement_t& fst = fastStatements[ i ];
+
+		if( prev.c == NULL || st.a != prev.c )
+		{
+			continue;
+		}
+
+		if( fst.op == FASTOP_IFNOT )
+		{
+			switch( fprev.op )
+			{
+				case FASTOP_GE:
+					fprev.op = FASTOP_GE_IFNOT;
+					break;
+				case FASTOP_LE:
+					fprev.op = FASTOP_LE_IFNOT;
+					break;
+				case FASTOP_GT:
+					fprev.op = FASTOP_GT_IFNOT;
+					break;
+				case FASTOP_LT:
+					fprev.op = FASTOP_LT_IFNOT;
+					break;
+				case FASTOP_EQ_F:
+					fprev.op = FASTOP_EQ_F_IFNOT;
+					break;
+				case FASTOP_NE_F:
+					fprev.op = FASTOP_NE_F_IFNOT;
+					break;
+				default:
+					continue;
+			}
+			fprev.jumpOffset = fst.jumpOffset;
+		}
+		else if( fst.op == FASTOP_STORE && st.op == OP_STORE_F )
+		{
+			switch( fprev.op )
+			{
+				case FASTOP_ADD_F:
+					fprev.op = FASTOP_ADD_F_STORE;
+					break;
+				case FASTOP_SUB_F:
+					fprev.op = FASTOP_SUB_F_STORE;
+					break;
+				case FASTOP_MUL_F:
+					fprev.op = FASTOP_MUL_F_STORE;
+					break;
+				default:
+					continue;
+			}
+			fprev.d = fst.b;
+		}
+	}
+}
+
 /*
 ==============
 idProgram::CompileStats
@@ -2078,6 +2299,8 @@ void idProgram::CompileStats()
 	int	numdefs;
 	int	stringspace;
 	int funcMem;
+	int	numResolved;
+	int	numFused;
 	int	i;
 
 	gameLocal.Printf( "---------- Compile stats ----------\n" );
@@ -2109,13 +2332,28 @@ void idProgram::CompileStats()
 
 	memallocated = funcMem + memused + sizeof( idProgram );
 
+	numResolved = numFused = 0;
+	for( i = 0; i < fastStatements.Num(); i++ )
+	{
+		if( fastStatements[ i ].op != FASTOP_GENERIC )
+		{
+			numResolved++;
+		}
+		if( fastStatements[ i ].op > FASTOP_PUSH )
+		{
+			numFused++;
+		}
+	}
+
 	memused += statements.MemoryUsed();
+	memused += fastStatements.MemoryUsed();
 	memused += functions.MemoryUsed();	// name and filename of functions are shared, so no need to include them
 	memused += sizeof( variables );
 
 	gameLocal.Printf( "\nMemory usage:\n" );
 	gameLocal.Printf( "     Strings: %d, %d bytes\n", fileList.Num(), stringspace );
 	gameLocal.Printf( "  Statements: %d, %d bytes\n", statements.Num(), statements.MemoryUsed() );
+	gameLocal.Printf( "    Resolved: %d, %d fused, %d bytes\n", numResolved, numFused, fastStatements.MemoryUsed() );
 	gameLocal.Printf( "   Functions: %d, %d bytes\n", functions.Num(), funcMem );
 	gameLocal.Printf( "   Variables: %d bytes\n", numVariables );
 	gameLocal.Printf( "    Mem used: %d bytes\n", memused );
@@ -2178,6 +2416,8 @@ bool idProgram::CompileText( const char* source, const char* text, bool console
 	};
 #endif
 
+	ResolveStatements();
+
 	if( !console )
 	{
 		CompileStats();
@@ -2276,6 +2516,7 @@ void idProgram::FreeData()
 	filename.Clear();
 	fileList.Clear();
 	statements.Clear();
+	fastStatements.Clear();
 	functions.Clear();
 
 	top_functions	= 0;
@@ -2527,6 +2768,11 @@ void idProgram::Restart()
 	functions.SetNum( top_functions	);
 
 	statements.SetNum( top_statements );
+	scriptProfiler.Clear();
+	if( fastStatements.Num() > top_statements )
+	{
+		fastStatements.SetNum( top_statements );
+	}
 	fileList.SetNum( top_files );
 	filename.Clear();
 
@@ -478,6 +478,75 @@ typedef struct statement_s
 	idVarDef*		c;
 } statement_t;
 
+/***********************************************************************
+
+  Resolved statements
+
+  After compilation every statement gets a resolved copy that the interpreter
+  can execute without going through idVarDef.  Common opcode sequences are
+  fused into a single superinstruction on the first statement of the sequence.
+  Statements that aren't resolved use FASTOP_GENERIC and run the normal opcode.
+
+***********************************************************************/
+
+typedef enum
+{
+	FASTOP_GENERIC,
+	FASTOP_GOTO,
+	FASTOP_IF,
+	FASTOP_IFNOT,
+	FASTOP_ADD_F,
+	FASTOP_ADD_V,
+	FASTOP_SUB_F,
+	FASTOP_SUB_V,
+	FASTOP_MUL_F,
+	FASTOP_MUL_V,
+	FASTOP_GE,
+	FASTOP_LE,
+	FASTOP_GT,
+	FASTOP_LT,
+	FASTOP_EQ_F,
+	FASTOP_NE_F,
+	FASTOP_NOT_F,
+	FASTOP_NOT_BOOL,
+	FASTOP_UADD_F,
+	FASTOP_USUB_F,
+	FASTOP_UINC_F,
+	FASTOP_UDEC_F,
+	FASTOP_STORE,			// float, bool, entity and object stores are all a 4 byte copy
+	FASTOP_STORE_V,
+	FASTOP_PUSH,			// float, entity and object pushes
+
+	// superinstructions, the second statement is skipped
+	FASTOP_GE_IFNOT,
+	FASTOP_LE_IFNOT,
+	FASTOP_GT_IFNOT,
+	FASTOP_LT_IFNOT,
+	FASTOP_EQ_F_IFNOT,
+	FASTOP_NE_F_IFNOT,
+	FASTOP_ADD_F_STORE,
+	FASTOP_SUB_F_STORE,
+	FASTOP_MUL_F_STORE,
+
+	NUM_FASTOPS
+} fastOp_t;
+
+typedef struct fastOperand_s
+{
+	byte*			ptr;			// address of a global variable or constant, NULL for stack variables
+	int				stackOffset;	// offset from the local stack base
+} fastOperand_t;
+
+typedef struct fastStatement_s
+{
+	unsigned short	op;
+	int				jumpOffset;		// jump offset of the (last) jump in the statement
+	fastOperand_t	a;
+	fastOperand_t	b;
+	fastOperand_t	c;
+	fastOperand_t	d;				// destination of the second statement of a superinstruction
+} fastStatement_t;
+
 /***********************************************************************
 
 idProgram
@@ -506,6 +575,7 @@ private:
 	idList<idVarDefName*, TAG_SCRIPT>			varDefNames;
 	idHashIndex									varDefNameHash;
 	idList<idVarDef*, TAG_SCRIPT>				varDefs;
+	idList<fastStatement_t, TAG_SCRIPT>			fastStatements;
 
 	idVarDef*									sysDef;
 
@@ -518,6 +588,8 @@ private:
 	void										CompileStats();
 	byte*										ReserveDefMemory( int size );
 	idVarDef*									AllocVarDef( idTypeDef* type, const char* name, idVarDef* scope );
+	bool										ResolveOperand( const idVarDef* def, fastOperand_t& operand ) const;
+	void										ResolveStatements();
 
 public:
 	idVarDef*									returnDef;
@@ -574,6 +646,14 @@ public:
 	{
 		return statements.Num();
 	}
+	const fastStatement_t*						GetFastStatements() const
+	{
+		return fastStatements.Ptr();
+	}
+	int											NumFastStatements() const
+	{
+		return fastStatements.Num();
+	}
 
 	int 										GetReturnedInteger();
 
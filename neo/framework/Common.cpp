@@ -1228,6 +1228,9 @@ void idCommonLocal::Init( int argc, const char* const* argv, const char* cmdline
 		// override cvars from command line
 		StartupVariable( NULL );
 
+		// start serving small allocations from slabs
+		Mem_Init();
+
 		consoleUsed = com_allowConsole.GetBool();
 
 		if( Sys_AlreadyRunning() )
@@ -1257,15 +1260,15 @@ void idCommonLocal::Init( int argc, const char* const* argv, const char* cmdline
 
 		fileSystem->BeginLevelLoad( "_startup", saveFile.GetDataPtr(), saveFile.GetAllocated() );
 
+		// init the parallel job manager, the declaration manager scans the decl files on the job threads
+		parallelJobManager->Init();
+
 		// initialize the declaration manager
 		declManager->Init();
 
 		// init journalling, etc
 		eventLoop->Init();
 
-		// init the parallel job manager
-		parallelJobManager->Init();
-
 		// exec the startup scripts
 		cmdSystem->BufferCommandText( CMD_EXEC_APPEND, "exec default.cfg\n" );
 
@@ -507,6 +507,16 @@ float idConsoleLocal::DrawFPS( float y )
 								commonLocal.stats_frontend.c_mocVerts,
 								commonLocal.stats_frontend.c_mocIndexes );
 
+			ImGui::TextColored( colorLtGrey, "OCCLUDERS: surfs:%-4i small:%-4i binnedTris:%i rounds:%i",
+								commonLocal.stats_frontend.c_mocOccluders,
+								commonLocal.stats_frontend.c_mocSkippedOccluders,
+								commonLocal.stats_frontend.c_mocBinnedTris,
+								commonLocal.stats_frontend.c_mocBinningRounds );
+
+			ImGui::TextColored( colorLtGrey, "SORT: drawSurfs:%-5i time:%i us",
+								commonLocal.stats_frontend.c_sortedDrawSurfs,
+								( int )commonLocal.stats_frontend.sortMicroSec );
+
 			ImGui::TextColored( colorLtGrey, "ADDMODEL: callback:%-2i createInteractions:%i createShadowVolumes:%i",
 								commonLocal.stats_frontend.c_entityDefCallbacks,
 								commonLocal.stats_frontend.c_createInteractions,
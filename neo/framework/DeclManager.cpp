@@ -89,6 +89,8 @@ public:
 };
 
 class idDeclFile;
+class idDeclFileScan;
+class idDeclCache;
 
 class idDeclLocal : public idDeclBase
 {
@@ -141,6 +143,9 @@ protected:
 	// Set textSource possible with compression.
 	void						SetTextLocal( const char* text, const int length );
 
+	// Takes ownership of text allocated with AllocDeclText.
+	void						SetCompressedTextLocal( char* text, const int compressedLength, const int length, const int checksum );
+
 private:
 	idDecl* 					self;
 
@@ -172,7 +177,9 @@ public:
 	idDeclFile( const char* fileName, declType_t defaultType );
 
 	void						Reload( bool force );
+	bool						NeedsReload( bool force ) const;
 	int							LoadAndParse();
+	void						MergeScan( idDeclFileScan& scan );
 
 public:
 	idStr						fileName;
@@ -186,6 +193,180 @@ public:
 	idDeclLocal* 				decls;
 };
 
+// a declaration found while scanning a decl file
+struct declScanEntry_t
+{
+	declType_t					type;
+	idStr						name;
+	int							sourceTextOffset;
+	int							sourceTextLength;
+	int							sourceLine;
+	int							checksum;
+	char* 						textSource;				// allocated with AllocDeclText
+	int							compressedLength;
+};
+
+struct declScanWarning_t
+{
+	int							line;
+	idStr						text;
+};
+
+// reads a decl file and splits it up into declarations, the scans of several
+// files are run in parallel and merged into the decl lists on the main thread
+class idDeclFileScan
+{
+public:
+	idDeclFileScan( const idDeclFile* file, const idDeclCache* cache, int typesChecksum );
+	~idDeclFileScan();
+
+	void						Scan();
+
+public:
+	fileReadRequest_t			request;
+	declType_t					defaultType;
+	const idDeclCache* 			cache;
+	int							typesChecksum;			// the decl types that were registered when the file was scanned
+	bool						fromCache;
+	bool						parseFailed;			// the lexer couldn't load the file, reported on the main thread
+
+	idList<declScanEntry_t, TAG_DECL>	entries;
+	idList<declScanWarning_t, TAG_DECL>	warnings;
+	int							checksum;
+	int							numLines;
+	uint64						scanTime[DECL_MAX_TYPES];	// microseconds spent per decl type
+
+private:
+	void						Warning( int line, VERIFY_FORMAT_STRING const char* fmt, ... ) ID_INSTANCE_ATTRIBUTE_PRINTF( 2, 3 );
+
+	friend class idDeclCache;
+};
+
+/*
+================================================================================================
+
+	Decl cache
+
+	Holds the scans of the decl files from a previous run so unchanged files don't have to be
+	lexed and compressed again. The file is written in the native layout with offsets instead of
+	pointers so it can be used directly from the loaded or mapped file.
+
+================================================================================================
+*/
+
+static const int		DECL_CACHE_MAGIC	= ( 'D' << 24 ) | ( 'C' << 16 ) | ( 'C' << 8 ) | 'H';
+#ifdef USE_COMPRESSED_DECLS
+	static const int	DECL_CACHE_VERSION	= 1;
+#else
+	static const int	DECL_CACHE_VERSION	= 0x10001;
+#endif
+static const char* 		DECL_CACHE_FILENAME	= "generated/decls.bdecls";
+
+struct declCacheHeader_t
+{
+	int							magic;
+	int							version;
+	int							numFiles;
+	int							numEntries;
+	int							numWarnings;
+	int							dataSize;				// strings and decl text following the warnings
+};
+
+struct declCacheFile_t
+{
+	int							nameOffset;
+	int							checksum;				// MD5_BlockChecksum of the file text
+	int							fileSize;
+	int							numLines;
+	int							typesChecksum;
+	int							firstEntry;
+	int							numEntries;
+	int							firstWarning;
+	int							numWarnings;
+};
+
+struct declCacheEntry_t
+{
+	int							type;
+	int							nameOffset;
+	int							sourceTextOffset;
+	int							sourceTextLength;
+	int							sourceLine;
+	int							checksum;
+	int							textOffset;
+	int							compressedLength;
+};
+
+struct declCacheWarning_t
+{
+	int							line;
+	int							textOffset;
+};
+
+class idDeclCache
+{
+public:
+	idDeclCache();
+
+	void						Load();
+	void						Write();
+	void						Free();
+
+	bool						IsEnabled() const
+	{
+		return enabled;
+	}
+
+	// thread safe
+	bool						Restore( idDeclFileScan& scan ) const;
+
+	// adds a scan that didn't come from the cache, written with the next Write
+	void						AddScan( const idDeclFileScan& scan );
+
+private:
+	// the cache layout in growable lists, used to collect the files before writing the cache
+	struct declCacheImage_t
+	{
+		declCacheImage_t();
+
+		int						AddData( const char* bytes, int length, bool terminate );
+		void					AddFile( const declCacheFile_t& file, const declCacheEntry_t* fileEntries, const declCacheWarning_t* fileWarnings, const char* fileData );
+		int						FindFile( const char* fileName ) const;
+		void					Clear();
+
+		idList<declCacheFile_t, TAG_DECL>		files;
+		idList<declCacheEntry_t, TAG_DECL>		entries;
+		idList<declCacheWarning_t, TAG_DECL>	warnings;
+		idList<char, TAG_DECL>					data;
+		idHashIndex				hash;
+	};
+
+	const declCacheFile_t* 		FindFile( const char* fileName ) const;
+	static bool					IsValidImage( const byte* buffer, int length );
+	void						SetImage( byte* buffer, int length );
+
+	bool						enabled;
+
+	byte* 						buffer;
+	const declCacheHeader_t* 	header;
+	const declCacheFile_t* 		files;
+	const declCacheEntry_t* 	entries;
+	const declCacheWarning_t* 	warnings;
+	const char* 				data;
+	idHashIndex					hash;
+
+	declCacheImage_t			added;
+};
+
+// load times per decl type
+struct declTypeTiming_t
+{
+	int							numScanned;
+	uint64						scanTime;
+	int							numParsed;
+	uint64						parseTime;				// not including the decls parsed by this decl
+};
+
 class idDeclManagerLocal : public idDeclManager
 {
 	friend class idDeclLocal;
@@ -238,6 +419,7 @@ public:
 public:
 	static void					MakeNameCanonical( const char* name, char* result, int maxLength );
 	idDeclLocal* 				FindTypeWithoutParsing( declType_t type, const char* name, bool makeDefault = true );
+	int							LoadAndParseFiles( idDeclFile* const* files, int numFiles );
 
 	idDeclType* 				GetDeclType( int type ) const
 	{
@@ -266,10 +448,21 @@ private:
 	int							indent;			// for MediaPrint
 	bool						insideLevelLoad;
 
+	declTypeTiming_t			typeTimings[DECL_MAX_TYPES];
+	uint64						nestedParseTime;	// time spent parsing decls referenced by the decl being parsed
+
+	idDeclCache					declCache;
+
 	static idCVar				decl_show;
+	static idCVar				decl_parallelScan;
+	static idCVar				decl_cache;
+
+private:
+	int							GetDeclTypesChecksum() const;
 
 private:
 	static void					ListDecls_f( const idCmdArgs& args );
+	static void					ListDeclTimings_f( const idCmdArgs& args );
 	static void					ReloadDecls_f( const idCmdArgs& args );
 	static void					TouchDecl_f( const idCmdArgs& args );
 	// RB begin
@@ -284,6 +477,8 @@ private:
 };
 
 idCVar idDeclManagerLocal::decl_show( "decl_show", "0", CVAR_SYSTEM, "set to 1 to print parses, 2 to also print references", 0, 2, idCmdSystem::ArgCompletion_Integer<0, 2> );
+idCVar idDeclManagerLocal::decl_parallelScan( "decl_parallelScan", "1", CVAR_SYSTEM | CVAR_BOOL, "scan decl files for declarations on the job threads" );
+idCVar idDeclManagerLocal::decl_cache( "decl_cache", "1", CVAR_SYSTEM | CVAR_BOOL | CVAR_INIT, "keep the scanned decl files in generated/decls.bdecls so unchanged files load without being parsed" );
 
 idDeclManagerLocal	declManagerLocal;
 idDeclManager* 		declManager = &declManagerLocal;
@@ -532,8 +727,6 @@ int HuffmanCompressText( const char* text, int textLength, byte* compressed, int
 	int i, j;
 	idBitMsg msg;
 
-	totalUncompressedLength += textLength;
-
 	msg.InitWrite( compressed, maxCompressedSize );
 	msg.BeginWriting();
 	for( i = 0; i < textLength; i++ )
@@ -549,8 +742,6 @@ int HuffmanCompressText( const char* text, int textLength, byte* compressed, int
 		}
 	}
 
-	totalCompressedLength += msg.GetSize();
-
 	return msg.GetSize();
 }
 
@@ -583,6 +774,39 @@ int HuffmanDecompressText( char* text, int textLength, const byte* compressed, i
 	return msg.GetReadCount();
 }
 
+/*
+================
+AllocDeclText
+
+Returns the possibly compressed decl text, this is safe to call from any thread.
+================
+*/
+static char* AllocDeclText( const char* text, const int length, int& compressedLength )
+{
+	char* textSource;
+
+#ifdef GET_HUFFMAN_FREQUENCIES
+	for( int i = 0; i < length; i++ )
+	{
+		huffmanFrequencies[( ( const unsigned char* )text )[i]]++;
+	}
+#endif
+
+#ifdef USE_COMPRESSED_DECLS
+	int maxBytesPerCode = ( maxHuffmanBits + 7 ) >> 3;
+	idTempArray<byte> compressed( length * maxBytesPerCode );
+	compressedLength = HuffmanCompressText( text, length, compressed.Ptr(), length * maxBytesPerCode );
+	textSource = ( char* )Mem_Alloc( compressedLength, TAG_DECLTEXT );
+	memcpy( textSource, compressed.Ptr(), compressedLength );
+#else
+	compressedLength = length;
+	textSource = ( char* ) Mem_Alloc( length + 1, TAG_DECLTEXT );
+	memcpy( textSource, text, length );
+	textSource[length] = '\0';
+#endif
+	return textSource;
+}
+
 /*
 ================
 ListHuffmanFrequencies_f
@@ -659,6 +883,24 @@ ForceReload will cause it to reload even if the timestamp hasn't changed
 ================
 */
 void idDeclFile::Reload( bool force )
+{
+	if( !NeedsReload( force ) )
+	{
+		return;
+	}
+
+	// parse the text
+	LoadAndParse();
+}
+
+/*
+================
+idDeclFile::NeedsReload
+
+ForceReload will cause it to reload even if the timestamp hasn't changed
+================
+*/
+bool idDeclFile::NeedsReload( bool force ) const
 {
 	// check for an unchanged timestamp
 	if( !force && timestamp != 0 )
@@ -668,12 +910,10 @@ void idDeclFile::Reload( bool force )
 
 		if( testTimeStamp == timestamp )
 		{
-			return;
+			return false;
 		}
 	}
-
-	// parse the text
-	LoadAndParse();
+	return true;
 }
 
 /*
@@ -687,203 +927,801 @@ int c_savedMemory = 0;
 
 int idDeclFile::LoadAndParse()
 {
-	int			i, numTypes;
+	idDeclFile* file = this;
+	declManagerLocal.LoadAndParseFiles( &file, 1 );
+	return checksum;
+}
+
+/*
+================
+idDeclFileScan::idDeclFileScan
+================
+*/
+idDeclFileScan::idDeclFileScan( const idDeclFile* file, const idDeclCache* cache, int typesChecksum )
+{
+	request.fileName = file->fileName;
+	defaultType = file->defaultType;
+	this->cache = cache;
+	this->typesChecksum = typesChecksum;
+	fromCache = false;
+	parseFailed = false;
+	checksum = 0;
+	numLines = 0;
+	memset( scanTime, 0, sizeof( scanTime ) );
+}
+
+/*
+================
+idDeclFileScan::~idDeclFileScan
+================
+*/
+idDeclFileScan::~idDeclFileScan()
+{
+	for( int i = 0; i < entries.Num(); i++ )
+	{
+		Mem_Free( entries[i].textSource );
+	}
+	fileSystem->FreeFileRead( &request );
+}
+
+/*
+================
+idDeclFileScan::Warning
+================
+*/
+void idDeclFileScan::Warning( int line, const char* fmt, ... )
+{
+	char text[MAX_STRING_CHARS];
+	va_list ap;
+
+	va_start( ap, fmt );
+	idStr::vsnPrintf( text, sizeof( text ), fmt, ap );
+	va_end( ap );
+
+	declScanWarning_t& warning = warnings.Alloc();
+	warning.line = line;
+	warning.text = text;
+}
+
+/*
+================
+idDeclFileScan::Scan
+
+Identifies each individual declaration in the file text. This can run on any
+thread so it doesn't touch the decl lists and doesn't print anything.
+================
+*/
+void idDeclFileScan::Scan()
+{
 	idLexer		src;
 	idToken		token;
-	int			startMarker;
-	char* 		buffer;
-	int			length, size;
-	int			sourceLine;
 	idStr		name;
-	idDeclLocal* newDecl;
-	bool		reparse;
 
-	// load the text
+	fileSystem->WaitForFileRead( &request );
+	if( request.length == -1 )
+	{
+		return;
+	}
+
+	const char* buffer = ( const char* )request.buffer;
+
+	checksum = MD5_BlockChecksum( buffer, request.length );
+
+	if( cache != NULL && cache->Restore( *this ) )
+	{
+		fromCache = true;
+		return;
+	}
+
+	if( !src.LoadMemory( buffer, request.length, request.fileName ) )
+	{
+		parseFailed = true;
+		return;
+	}
+
+	// lexer warnings are reported when the decl itself is parsed
+	src.SetFlags( DECL_LEXER_FLAGS | LEXFL_NOWARNINGS | LEXFL_NOERRORS );
+
+	// scan through, identifying each individual declaration
+	while( 1 )
+	{
+		const uint64 startTime = Sys_Microseconds();
+		const int startMarker = src.GetFileOffset();
+		const int sourceLine = src.GetLineNum();
+
+		// parse the decl type name
+		if( !src.ReadToken( &token ) )
+		{
+			break;
+		}
+
+		declType_t identifiedType = DECL_MAX_TYPES;
+
+		// get the decl type from the type name
+		int i;
+		const int numTypes = declManagerLocal.GetNumDeclTypes();
+		for( i = 0; i < numTypes; i++ )
+		{
+			idDeclType* typeInfo = declManagerLocal.GetDeclType( i );
+			if( typeInfo != NULL && typeInfo->typeName.Icmp( token ) == 0 )
+			{
+				identifiedType = ( declType_t ) typeInfo->type;
+				break;
+			}
+		}
+
+		if( i >= numTypes )
+		{
+
+			if( token.Icmp( "{" ) == 0 )
+			{
+
+				// if we ever see an open brace, we somehow missed the [type] <name> prefix
+				Warning( src.GetLineNum(), "Missing decl name" );
+				src.SkipBracedSection( false );
+				continue;
+
+			}
+			else
+			{
+
+				if( defaultType == DECL_MAX_TYPES )
+				{
+					Warning( src.GetLineNum(), "No type" );
+					continue;
+				}
+				src.UnreadToken( &token );
+				// use the default type
+				identifiedType = defaultType;
+			}
+		}
+
+		// now parse the name
+		if( !src.ReadToken( &token ) )
+		{
+			Warning( src.GetLineNum(), "Type without definition at end of file" );
+			break;
+		}
+
+		if( !token.Icmp( "{" ) )
+		{
+			// if we ever see an open brace, we somehow missed the [type] <name> prefix
+			Warning( src.GetLineNum(), "Missing decl name" );
+			src.SkipBracedSection( false );
+			continue;
+		}
+
+		// FIXME: export decls are only used by the model exporter, they are skipped here for now
+		if( identifiedType == DECL_MODELEXPORT )
+		{
+			src.SkipBracedSection();
+			continue;
+		}
+
+		name = token;
+
+		// make sure there's a '{'
+		if( !src.ReadToken( &token ) )
+		{
+			Warning( src.GetLineNum(), "Type without definition at end of file" );
+			break;
+		}
+		if( token != "{" )
+		{
+			Warning( src.GetLineNum(), "Expecting '{' but found '%s'", token.c_str() );
+			continue;
+		}
+		src.UnreadToken( &token );
+
+		// now take everything until a matched closing brace
+		src.SkipBracedSection();
+
+		declScanEntry_t& entry = entries.Alloc();
+		entry.type = identifiedType;
+		entry.name = name;
+		entry.sourceTextOffset = startMarker;
+		entry.sourceTextLength = src.GetFileOffset() - startMarker;
+		entry.sourceLine = sourceLine;
+		entry.checksum = MD5_BlockChecksum( buffer + startMarker, entry.sourceTextLength );
+		entry.textSource = AllocDeclText( buffer + startMarker, entry.sourceTextLength, entry.compressedLength );
+
+		scanTime[identifiedType] += Sys_Microseconds() - startTime;
+	}
+
+	numLines = src.GetLineNum();
+}
+
+/*
+================
+DeclFileScanJob
+================
+*/
+static void DeclFileScanJob( idDeclFileScan* scan )
+{
+	scan->Scan();
+}
+
+REGISTER_PARALLEL_JOB( DeclFileScanJob, "DeclFileScanJob" );
+
+/*
+================
+idDeclFile::MergeScan
+
+Adds the scanned declarations to the decl lists, this runs on the main thread
+in file order so the results don't depend on which file was scanned first.
+================
+*/
+void idDeclFile::MergeScan( idDeclFileScan& scan )
+{
 	common->DPrintf( "...loading '%s'\n", fileName.c_str() );
-	length = fileSystem->ReadFile( fileName, ( void** )&buffer, &timestamp );
-	if( length == -1 )
+	if( scan.request.length == -1 )
 	{
 		common->FatalError( "couldn't load %s", fileName.c_str() );
-		return 0;
+		return;
 	}
 
-	if( !src.LoadMemory( buffer, length, fileName ) )
+	if( scan.parseFailed )
 	{
 		common->Error( "Couldn't parse %s", fileName.c_str() );
-		Mem_Free( buffer );
-		return 0;
+		return;
 	}
 
+	timestamp = scan.request.timestamp;
+
 	// mark all the defs that were from the last reload of this file
 	for( idDeclLocal* decl = decls; decl; decl = decl->nextInFile )
 	{
 		decl->redefinedInReload = false;
 	}
 
-	src.SetFlags( DECL_LEXER_FLAGS );
+	checksum = scan.checksum;
 
-	checksum = MD5_BlockChecksum( buffer, length );
+	fileSize = scan.request.length;
 
-	fileSize = length;
+	int nextWarning = 0;
+	for( int i = 0; i < scan.entries.Num(); i++ )
+	{
+		declScanEntry_t& entry = scan.entries[i];
 
-	// scan through, identifying each individual declaration
-	while( 1 )
+		// keep the warnings in source order
+		for( ; nextWarning < scan.warnings.Num() && scan.warnings[nextWarning].line <= entry.sourceLine; nextWarning++ )
+		{
+			common->Warning( "file %s, line %d: %s", fileName.c_str(), scan.warnings[nextWarning].line, scan.warnings[nextWarning].text.c_str() );
+		}
+
+		// look it up, possibly getting a newly created default decl
+		bool reparse = false;
+		idDeclLocal* newDecl = declManagerLocal.FindTypeWithoutParsing( entry.type, entry.name, false );
+		if( newDecl )
+		{
+			// update the existing copy
+			if( newDecl->sourceFile != this || newDecl->redefinedInReload )
+			{
+				common->Warning( "file %s, line %d: %s '%s' previously defined at %s:%i", fileName.c_str(), entry.sourceLine,
+								 declManagerLocal.GetDeclNameFromType( entry.type ), entry.name.c_str(), newDecl->sourceFile->fileName.c_str(), newDecl->sourceLine );
+				continue;
+			}
+			if( newDecl->declState != DS_UNPARSED )
+			{
+				reparse = true;
+			}
+		}
+		else
+		{
+			// allow it to be created as a default, then add it to the per-file list
+			newDecl = declManagerLocal.FindTypeWithoutParsing( entry.type, entry.name, true );
+			newDecl->nextInFile = this->decls;
+			this->decls = newDecl;
+		}
+
+		newDecl->redefinedInReload = true;
+
+		newDecl->SetCompressedTextLocal( entry.textSource, entry.compressedLength, entry.sourceTextLength, entry.checksum );
+		entry.textSource = NULL;
+
+		newDecl->sourceFile = this;
+		newDecl->sourceTextOffset = entry.sourceTextOffset;
+		newDecl->sourceTextLength = entry.sourceTextLength;
+		newDecl->sourceLine = entry.sourceLine;
+		newDecl->declState = DS_UNPARSED;
+
+		// if it is currently in use, reparse it immedaitely
+		if( reparse )
+		{
+			newDecl->ParseLocal();
+		}
+	}
+
+	for( ; nextWarning < scan.warnings.Num(); nextWarning++ )
 	{
+		common->Warning( "file %s, line %d: %s", fileName.c_str(), scan.warnings[nextWarning].line, scan.warnings[nextWarning].text.c_str() );
+	}
 
-		startMarker = src.GetFileOffset();
-		sourceLine = src.GetLineNum();
+	numLines = scan.numLines;
 
-		// parse the decl type name
-		if( !src.ReadToken( &token ) )
+	// any defs that weren't redefinedInReload should now be defaulted
+	for( idDeclLocal* decl = decls ; decl ; decl = decl->nextInFile )
+	{
+		if( decl->redefinedInReload == false )
 		{
-			break;
+			decl->MakeDefault();
+			decl->sourceTextOffset = decl->sourceFile->fileSize;
+			decl->sourceTextLength = 0;
+			decl->sourceLine = decl->sourceFile->numLines;
 		}
+	}
+}
 
-		declType_t identifiedType = DECL_MAX_TYPES;
+/*
+================================================================================================
+
+	idDeclCache
+
+================================================================================================
+*/
+
+/*
+================
+idDeclCache::declCacheImage_t::declCacheImage_t
+================
+*/
+idDeclCache::declCacheImage_t::declCacheImage_t()
+{
+	files.SetGranularity( 256 );
+	entries.SetGranularity( 4096 );
+	warnings.SetGranularity( 256 );
+}
+
+/*
+================
+idDeclCache::declCacheImage_t::AddData
+================
+*/
+int idDeclCache::declCacheImage_t::AddData( const char* bytes, int length, bool terminate )
+{
+	const int offset = data.Num();
+	const int newNum = offset + length + ( terminate ? 1 : 0 );
+	if( newNum > data.NumAllocated() )
+	{
+		data.Resize( Max( data.NumAllocated() * 2, newNum + 65536 ) );
+	}
+	data.SetNum( newNum );
+	memcpy( data.Ptr() + offset, bytes, length );
+	if( terminate )
+	{
+		data[offset + length] = '\0';
+	}
+	return offset;
+}
+
+/*
+================
+idDeclCache::declCacheImage_t::AddFile
+================
+*/
+void idDeclCache::declCacheImage_t::AddFile( const declCacheFile_t& file, const declCacheEntry_t* fileEntries, const declCacheWarning_t* fileWarnings, const char* fileData )
+{
+	const char* name = fileData + file.nameOffset;
+
+	declCacheFile_t& newFile = files.Alloc();
+	newFile = file;
+	newFile.nameOffset = AddData( name, idStr::Length( name ), true );
+	newFile.firstEntry = entries.Num();
+	newFile.firstWarning = warnings.Num();
+
+	for( int i = 0; i < file.numEntries; i++ )
+	{
+		const declCacheEntry_t& entry = fileEntries[file.firstEntry + i];
+		const char* entryName = fileData + entry.nameOffset;
+
+		declCacheEntry_t& newEntry = entries.Alloc();
+		newEntry = entry;
+		newEntry.nameOffset = AddData( entryName, idStr::Length( entryName ), true );
+		newEntry.textOffset = AddData( fileData + entry.textOffset, entry.compressedLength, false );
+	}
+
+	for( int i = 0; i < file.numWarnings; i++ )
+	{
+		const declCacheWarning_t& warning = fileWarnings[file.firstWarning + i];
+		const char* text = fileData + warning.textOffset;
+
+		declCacheWarning_t& newWarning = warnings.Alloc();
+		newWarning.line = warning.line;
+		newWarning.textOffset = AddData( text, idStr::Length( text ), true );
+	}
+
+	hash.Add( hash.GenerateKey( name, false ), files.Num() - 1 );
+}
+
+/*
+================
+idDeclCache::declCacheImage_t::FindFile
+================
+*/
+int idDeclCache::declCacheImage_t::FindFile( const char* fileName ) const
+{
+	const int key = hash.GenerateKey( fileName, false );
+	for( int i = hash.First( key ); i != -1; i = hash.Next( i ) )
+	{
+		if( idStr::Icmp( data.Ptr() + files[i].nameOffset, fileName ) == 0 )
+		{
+			return i;
+		}
+	}
+	return -1;
+}
+
+/*
+================
+idDeclCache::declCacheImage_t::Clear
+================
+*/
+void idDeclCache::declCacheImage_t::Clear()
+{
+	files.Clear();
+	entries.Clear();
+	warnings.Clear();
+	data.Clear();
+	hash.Free();
+}
+
+/*
+================
+idDeclCache::idDeclCache
+================
+*/
+idDeclCache::idDeclCache()
+{
+	enabled = false;
+	buffer = NULL;
+	header = NULL;
+	files = NULL;
+	entries = NULL;
+	warnings = NULL;
+	data = NULL;
+}
+
+/*
+================
+idDeclCache::Load
+================
+*/
+void idDeclCache::Load()
+{
+	enabled = true;
+
+	void* fileBuffer = NULL;
+	const int length = fileSystem->ReadFile( DECL_CACHE_FILENAME, &fileBuffer );
+	if( length <= 0 )
+	{
+		return;
+	}
+	SetImage( ( byte* )fileBuffer, length );
+}
+
+/*
+================
+DeclCache_IsRange
+================
+*/
+static bool DeclCache_IsRange( int offset, int length, int size )
+{
+	return offset >= 0 && length >= 0 && offset <= size && length <= size - offset;
+}
+
+/*
+================
+DeclCache_IsString
+
+The string has to be terminated within the data.
+================
+*/
+static bool DeclCache_IsString( const char* data, int dataSize, int offset )
+{
+	return offset >= 0 && offset < dataSize && memchr( data + offset, '\0', dataSize - offset ) != NULL;
+}
+
+/*
+================
+idDeclCache::IsValidImage
+
+Checks that every offset and count in the image stays within it, so the cache can be used without further checks.
+================
+*/
+bool idDeclCache::IsValidImage( const byte* buffer, int length )
+{
+	const declCacheHeader_t* header = ( const declCacheHeader_t* )buffer;
+	if( length < ( int )sizeof( declCacheHeader_t ) || header->magic != DECL_CACHE_MAGIC || header->version != DECL_CACHE_VERSION ||
+			header->numFiles < 0 || header->numEntries < 0 || header->numWarnings < 0 || header->dataSize < 0 ||
+			( size_t )length != sizeof( declCacheHeader_t ) + header->numFiles * sizeof( declCacheFile_t ) + header->numEntries * sizeof( declCacheEntry_t ) +
+			header->numWarnings * sizeof( declCacheWarning_t ) + header->dataSize )
+	{
+		return false;
+	}
+
+	const declCacheFile_t* files = ( const declCacheFile_t* )( header + 1 );
+	const declCacheEntry_t* entries = ( const declCacheEntry_t* )( files + header->numFiles );
+	const declCacheWarning_t* warnings = ( const declCacheWarning_t* )( entries + header->numEntries );
+	const char* data = ( const char* )( warnings + header->numWarnings );
+
+	for( int i = 0; i < header->numFiles; i++ )
+	{
+		const declCacheFile_t& file = files[i];
+		if( !DeclCache_IsString( data, header->dataSize, file.nameOffset ) || file.fileSize < 0 ||
+				!DeclCache_IsRange( file.firstEntry, file.numEntries, header->numEntries ) ||
+				!DeclCache_IsRange( file.firstWarning, file.numWarnings, header->numWarnings ) )
+		{
+			return false;
+		}
+
+		for( int j = 0; j < file.numEntries; j++ )
+		{
+			const declCacheEntry_t& entry = entries[file.firstEntry + j];
+			if( entry.type < 0 || entry.type >= DECL_MAX_TYPES || !DeclCache_IsString( data, header->dataSize, entry.nameOffset ) ||
+					!DeclCache_IsRange( entry.sourceTextOffset, entry.sourceTextLength, file.fileSize ) ||
+					!DeclCache_IsRange( entry.textOffset, entry.compressedLength, header->dataSize ) )
+			{
+				return false;
+			}
+		}
+	}
+
+	for( int i = 0; i < header->numWarnings; i++ )
+	{
+		if( !DeclCache_IsString( data, header->dataSize, warnings[i].textOffset ) )
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/*
+================
+idDeclCache::SetImage
+
+Takes ownership of the buffer.
+================
+*/
+void idDeclCache::SetImage( byte* newBuffer, int length )
+{
+	Mem_Free( buffer );
+	buffer = NULL;
+	header = NULL;
+	hash.Free();
+
+	if( !IsValidImage( newBuffer, length ) )
+	{
+		common->Printf( "ignoring out of date or corrupt %s\n", DECL_CACHE_FILENAME );
+		Mem_Free( newBuffer );
+		return;
+	}
+
+	buffer = newBuffer;
+	header = ( const declCacheHeader_t* )newBuffer;
+	files = ( const declCacheFile_t* )( header + 1 );
+	entries = ( const declCacheEntry_t* )( files + header->numFiles );
+	warnings = ( const declCacheWarning_t* )( entries + header->numEntries );
+	data = ( const char* )( warnings + header->numWarnings );
+
+	for( int i = 0; i < header->numFiles; i++ )
+	{
+		hash.Add( hash.GenerateKey( data + files[i].nameOffset, false ), i );
+	}
+}
+
+/*
+================
+idDeclCache::Free
+================
+*/
+void idDeclCache::Free()
+{
+	Mem_Free( buffer );
+	buffer = NULL;
+	header = NULL;
+	hash.Free();
+	added.Clear();
+	enabled = false;
+}
+
+/*
+================
+idDeclCache::FindFile
+================
+*/
+const declCacheFile_t* idDeclCache::FindFile( const char* fileName ) const
+{
+	if( header == NULL )
+	{
+		return NULL;
+	}
 
-		// get the decl type from the type name
-		numTypes = declManagerLocal.GetNumDeclTypes();
-		for( i = 0; i < numTypes; i++ )
+	const int key = hash.GenerateKey( fileName, false );
+	for( int i = hash.First( key ); i != -1; i = hash.Next( i ) )
+	{
+		if( idStr::Icmp( data + files[i].nameOffset, fileName ) == 0 )
 		{
-			idDeclType* typeInfo = declManagerLocal.GetDeclType( i );
-			if( typeInfo != NULL && typeInfo->typeName.Icmp( token ) == 0 )
-			{
-				identifiedType = ( declType_t ) typeInfo->type;
-				break;
-			}
+			return &files[i];
 		}
+	}
+	return NULL;
+}
 
-		if( i >= numTypes )
-		{
+/*
+================
+idDeclCache::Restore
 
-			if( token.Icmp( "{" ) == 0 )
-			{
+Fills in the scan from the cache if the file didn't change since it was cached.
+================
+*/
+bool idDeclCache::Restore( idDeclFileScan& scan ) const
+{
+	const declCacheFile_t* file = FindFile( scan.request.fileName );
+	if( file == NULL || file->checksum != scan.checksum || file->fileSize != scan.request.length || file->typesChecksum != scan.typesChecksum )
+	{
+		return false;
+	}
 
-				// if we ever see an open brace, we somehow missed the [type] <name> prefix
-				src.Warning( "Missing decl name" );
-				src.SkipBracedSection( false );
-				continue;
+	scan.entries.SetNum( file->numEntries );
+	for( int i = 0; i < file->numEntries; i++ )
+	{
+		const declCacheEntry_t& cached = entries[file->firstEntry + i];
+		declScanEntry_t& entry = scan.entries[i];
 
-			}
-			else
-			{
+		entry.type = ( declType_t )cached.type;
+		entry.name = data + cached.nameOffset;
+		entry.sourceTextOffset = cached.sourceTextOffset;
+		entry.sourceTextLength = cached.sourceTextLength;
+		entry.sourceLine = cached.sourceLine;
+		entry.checksum = cached.checksum;
+		entry.compressedLength = cached.compressedLength;
+#ifdef USE_COMPRESSED_DECLS
+		entry.textSource = ( char* )Mem_Alloc( cached.compressedLength, TAG_DECLTEXT );
+#else
+		entry.textSource = ( char* )Mem_Alloc( cached.compressedLength + 1, TAG_DECLTEXT );
+		entry.textSource[cached.compressedLength] = '\0';
+#endif
+		memcpy( entry.textSource, data + cached.textOffset, cached.compressedLength );
+	}
 
-				if( defaultType == DECL_MAX_TYPES )
-				{
-					src.Warning( "No type" );
-					continue;
-				}
-				src.UnreadToken( &token );
-				// use the default type
-				identifiedType = defaultType;
-			}
-		}
+	scan.warnings.SetNum( file->numWarnings );
+	for( int i = 0; i < file->numWarnings; i++ )
+	{
+		const declCacheWarning_t& cached = warnings[file->firstWarning + i];
+		scan.warnings[i].line = cached.line;
+		scan.warnings[i].text = data + cached.textOffset;
+	}
 
-		// now parse the name
-		if( !src.ReadToken( &token ) )
-		{
-			src.Warning( "Type without definition at end of file" );
-			break;
-		}
+	scan.numLines = file->numLines;
 
-		if( !token.Icmp( "{" ) )
-		{
-			// if we ever see an open brace, we somehow missed the [type] <name> prefix
-			src.Warning( "Missing decl name" );
-			src.SkipBracedSection( false );
-			continue;
-		}
+	return true;
+}
 
-		// FIXME: export decls are only used by the model exporter, they are skipped here for now
-		if( identifiedType == DECL_MODELEXPORT )
-		{
-			src.SkipBracedSection();
-			continue;
-		}
+/*
+================
+idDeclCache::AddScan
+================
+*/
+void idDeclCache::AddScan( const idDeclFileScan& scan )
+{
+	if( scan.request.length == -1 || scan.parseFailed )
+	{
+		return;
+	}
 
-		name = token;
+	// store the scan in the cache layout so it can be copied like a cached file
+	declCacheImage_t image;
 
-		// make sure there's a '{'
-		if( !src.ReadToken( &token ) )
-		{
-			src.Warning( "Type without definition at end of file" );
-			break;
-		}
-		if( token != "{" )
-		{
-			src.Warning( "Expecting '{' but found '%s'", token.c_str() );
-			continue;
-		}
-		src.UnreadToken( &token );
+	declCacheFile_t file;
+	file.nameOffset = image.AddData( scan.request.fileName, scan.request.fileName.Length(), true );
+	file.checksum = scan.checksum;
+	file.fileSize = scan.request.length;
+	file.numLines = scan.numLines;
+	file.typesChecksum = scan.typesChecksum;
+	file.firstEntry = 0;
+	file.numEntries = scan.entries.Num();
+	file.firstWarning = 0;
+	file.numWarnings = scan.warnings.Num();
 
-		// now take everything until a matched closing brace
-		src.SkipBracedSection();
-		size = src.GetFileOffset() - startMarker;
+	for( int i = 0; i < scan.entries.Num(); i++ )
+	{
+		const declScanEntry_t& entry = scan.entries[i];
 
-		// look it up, possibly getting a newly created default decl
-		reparse = false;
-		newDecl = declManagerLocal.FindTypeWithoutParsing( identifiedType, name, false );
-		if( newDecl )
-		{
-			// update the existing copy
-			if( newDecl->sourceFile != this || newDecl->redefinedInReload )
-			{
-				src.Warning( "%s '%s' previously defined at %s:%i", declManagerLocal.GetDeclNameFromType( identifiedType ),
-							 name.c_str(), newDecl->sourceFile->fileName.c_str(), newDecl->sourceLine );
-				continue;
-			}
-			if( newDecl->declState != DS_UNPARSED )
-			{
-				reparse = true;
-			}
-		}
-		else
-		{
-			// allow it to be created as a default, then add it to the per-file list
-			newDecl = declManagerLocal.FindTypeWithoutParsing( identifiedType, name, true );
-			newDecl->nextInFile = this->decls;
-			this->decls = newDecl;
-		}
+		declCacheEntry_t& cached = image.entries.Alloc();
+		cached.type = entry.type;
+		cached.nameOffset = image.AddData( entry.name, entry.name.Length(), true );
+		cached.sourceTextOffset = entry.sourceTextOffset;
+		cached.sourceTextLength = entry.sourceTextLength;
+		cached.sourceLine = entry.sourceLine;
+		cached.checksum = entry.checksum;
+		cached.textOffset = image.AddData( entry.textSource, entry.compressedLength, false );
+		cached.compressedLength = entry.compressedLength;
+	}
 
-		newDecl->redefinedInReload = true;
+	for( int i = 0; i < scan.warnings.Num(); i++ )
+	{
+		declCacheWarning_t& cached = image.warnings.Alloc();
+		cached.line = scan.warnings[i].line;
+		cached.textOffset = image.AddData( scan.warnings[i].text, scan.warnings[i].text.Length(), true );
+	}
 
-		if( newDecl->textSource )
-		{
-			Mem_Free( newDecl->textSource );
-			newDecl->textSource = NULL;
-		}
+	added.AddFile( file, image.entries.Ptr(), image.warnings.Ptr(), image.data.Ptr() );
+}
 
-		newDecl->SetTextLocal( buffer + startMarker, size );
-		newDecl->sourceFile = this;
-		newDecl->sourceTextOffset = startMarker;
-		newDecl->sourceTextLength = size;
-		newDecl->sourceLine = sourceLine;
-		newDecl->declState = DS_UNPARSED;
+/*
+================
+idDeclCache::Write
 
-		// if it is currently in use, reparse it immedaitely
-		if( reparse )
+Writes the cache if files were scanned that weren't cached yet.
+================
+*/
+void idDeclCache::Write()
+{
+	if( !enabled || added.files.Num() == 0 )
+	{
+		return;
+	}
+
+	// the latest scan of a file replaces the older ones
+	declCacheImage_t image;
+	for( int i = added.files.Num() - 1; i >= 0; i-- )
+	{
+		const declCacheFile_t& file = added.files[i];
+		if( image.FindFile( added.data.Ptr() + file.nameOffset ) == -1 )
 		{
-			newDecl->ParseLocal();
+			image.AddFile( file, added.entries.Ptr(), added.warnings.Ptr(), added.data.Ptr() );
 		}
 	}
-
-	numLines = src.GetLineNum();
-
-	Mem_Free( buffer );
-
-	// any defs that weren't redefinedInReload should now be defaulted
-	for( idDeclLocal* decl = decls ; decl ; decl = decl->nextInFile )
+	for( int i = 0; header != NULL && i < header->numFiles; i++ )
 	{
-		if( decl->redefinedInReload == false )
+		const declCacheFile_t& file = files[i];
+		if( image.FindFile( data + file.nameOffset ) == -1 )
 		{
-			decl->MakeDefault();
-			decl->sourceTextOffset = decl->sourceFile->fileSize;
-			decl->sourceTextLength = 0;
-			decl->sourceLine = decl->sourceFile->numLines;
+			image.AddFile( file, entries, warnings, data );
 		}
 	}
+	added.Clear();
+
+	declCacheHeader_t newHeader;
+	newHeader.magic = DECL_CACHE_MAGIC;
+	newHeader.version = DECL_CACHE_VERSION;
+	newHeader.numFiles = image.files.Num();
+	newHeader.numEntries = image.entries.Num();
+	newHeader.numWarnings = image.warnings.Num();
+	newHeader.dataSize = image.data.Num();
+
+	const int filesSize = image.files.Num() * sizeof( declCacheFile_t );
+	const int entriesSize = image.entries.Num() * sizeof( declCacheEntry_t );
+	const int warningsSize = image.warnings.Num() * sizeof( declCacheWarning_t );
+	const int length = sizeof( declCacheHeader_t ) + filesSize + entriesSize + warningsSize + image.data.Num();
+
+	byte* newBuffer = ( byte* )Mem_Alloc( length, TAG_DECL );
+	byte* ptr = newBuffer;
+	memcpy( ptr, &newHeader, sizeof( declCacheHeader_t ) );
+	ptr += sizeof( declCacheHeader_t );
+	memcpy( ptr, image.files.Ptr(), filesSize );
+	ptr += filesSize;
+	memcpy( ptr, image.entries.Ptr(), entriesSize );
+	ptr += entriesSize;
+	memcpy( ptr, image.warnings.Ptr(), warningsSize );
+	ptr += warningsSize;
+	memcpy( ptr, image.data.Ptr(), image.data.Num() );
+
+	idFileLocal file( fileSystem->OpenFileWrite( DECL_CACHE_FILENAME, "fs_basepath" ) );
+	if( file != NULL )
+	{
+		file->Write( newBuffer, length );
+		common->Printf( "wrote %d decl files to %s\n", newHeader.numFiles, DECL_CACHE_FILENAME );
+	}
+	else
+	{
+		common->Warning( "couldn't write %s", DECL_CACHE_FILENAME );
+	}
 
-	return checksum;
+	// continue with what was written
+	SetImage( newBuffer, length );
 }
 
 /*
@@ -906,6 +1744,13 @@ void idDeclManagerLocal::Init()
 	common->Printf( "----- Initializing Decls -----\n" );
 
 	checksum = 0;
+	memset( typeTimings, 0, sizeof( typeTimings ) );
+	nestedParseTime = 0;
+
+	if( decl_cache.GetBool() )
+	{
+		declCache.Load();
+	}
 
 #ifdef USE_COMPRESSED_DECLS
 	SetupHuffman();
@@ -938,6 +1783,7 @@ void idDeclManagerLocal::Init()
 #if !defined( DMAP )
 	// add console commands
 	cmdSystem->AddCommand( "listDecls", ListDecls_f, CMD_FL_SYSTEM, "lists all decls" );
+	cmdSystem->AddCommand( "listDeclTimings", ListDeclTimings_f, CMD_FL_SYSTEM, "lists the time spent scanning and parsing each decl type" );
 
 	cmdSystem->AddCommand( "reloadDecls", ReloadDecls_f, CMD_FL_SYSTEM, "reloads decls" );
 	cmdSystem->AddCommand( "touch", TouchDecl_f, CMD_FL_SYSTEM, "touches a decl" );
@@ -1071,6 +1917,9 @@ void idDeclManagerLocal::Shutdown()
 	// free decl files
 	loadedFiles.DeleteContents( true );
 
+	declCache.Write();
+	declCache.Free();
+
 	// free the decl types and folders
 	declTypes.DeleteContents( true );
 	declFolders.DeleteContents( true );
@@ -1087,10 +1936,15 @@ idDeclManagerLocal::Reload
 */
 void idDeclManagerLocal::Reload( bool force )
 {
+	idList<idDeclFile*, TAG_IDLIB_LIST_DECL> files;
 	for( int i = 0; i < loadedFiles.Num(); i++ )
 	{
-		loadedFiles[i]->Reload( force );
+		if( loadedFiles[i]->NeedsReload( force ) )
+		{
+			files.Append( loadedFiles[i] );
+		}
 	}
+	LoadAndParseFiles( files.Ptr(), files.Num() );
 }
 
 /*
@@ -1124,6 +1978,9 @@ void idDeclManagerLocal::EndLevelLoad()
 {
 	insideLevelLoad = false;
 
+	// all the decl folders have been registered by now
+	declCache.Write();
+
 	// we don't need to do anything here, but the image manager, model manager,
 	// and sound sample manager will need to free media that was not referenced
 }
@@ -1193,6 +2050,8 @@ void idDeclManagerLocal::RegisterDeclFolder( const char* folder, const char* ext
 	fileList = fileSystem->ListFiles( declFolder->folder, declFolder->extension, true );
 
 	// load and parse decl files
+	idList<idDeclFile*, TAG_IDLIB_LIST_DECL> files;
+	files.SetNum( fileList->GetNumFiles() );
 	for( i = 0; i < fileList->GetNumFiles(); i++ )
 	{
 		fileName = declFolder->folder + "/" + fileList->GetFile( i );
@@ -1214,12 +2073,123 @@ void idDeclManagerLocal::RegisterDeclFolder( const char* folder, const char* ext
 			df = new( TAG_DECL ) idDeclFile( fileName, defaultType );
 			loadedFiles.Append( df );
 		}
-		df->LoadAndParse();
+		files[i] = df;
 	}
 
+	const int start = Sys_Milliseconds();
+	const int numCached = LoadAndParseFiles( files.Ptr(), files.Num() );
+	const int end = Sys_Milliseconds();
+
+	common->Printf( "%5d %s/*%s files loaded in %4d msec, %d from the decl cache\n", files.Num(), declFolder->folder.c_str(), declFolder->extension.c_str(), end - start, numCached );
+
 	fileSystem->FreeFileList( fileList );
 }
 
+/*
+===================
+idDeclManagerLocal::LoadAndParseFiles
+
+Reads the files in parallel and scans them for declarations on the job threads.
+The decls are added in file order so the results are the same as loading one
+file after the other. Returns the number of files restored from the decl cache.
+===================
+*/
+int idDeclManagerLocal::LoadAndParseFiles( idDeclFile* const* files, int numFiles )
+{
+	// limits the number of open files
+	const int MAX_BATCH_FILES = 128;
+
+	bool parallel = decl_parallelScan.GetBool() && numFiles > 1;
+
+#if defined( DMAP ) || defined( GET_HUFFMAN_FREQUENCIES )
+	parallel = false;
+#endif
+
+	const idDeclCache* cache = declCache.IsEnabled() ? &declCache : NULL;
+	const int typesChecksum = GetDeclTypesChecksum();
+	int numCached = 0;
+
+	idList<idDeclFileScan*, TAG_IDLIB_LIST_DECL> scans;
+
+	for( int first = 0; first < numFiles; first += MAX_BATCH_FILES )
+	{
+		const int batchFiles = Min( numFiles - first, MAX_BATCH_FILES );
+
+		scans.SetNum( batchFiles );
+		for( int i = 0; i < batchFiles; i++ )
+		{
+			scans[i] = new( TAG_DECL ) idDeclFileScan( files[first + i], cache, typesChecksum );
+			fileSystem->ReadFileAsync( &scans[i]->request );
+		}
+
+		if( parallel )
+		{
+			idParallelJobList* jobList = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_MEDIUM, batchFiles, 0, NULL );
+			for( int i = 0; i < batchFiles; i++ )
+			{
+				jobList->AddJob( ( jobRun_t )DeclFileScanJob, scans[i] );
+			}
+			jobList->Submit( NULL, JOBLIST_PARALLELISM_MAX_CORES );
+			jobList->Wait();
+			parallelJobManager->FreeJobList( jobList );
+		}
+		else
+		{
+			for( int i = 0; i < batchFiles; i++ )
+			{
+				scans[i]->Scan();
+			}
+		}
+
+		for( int i = 0; i < batchFiles; i++ )
+		{
+			idDeclFileScan* scan = scans[i];
+			if( scan->fromCache )
+			{
+				numCached++;
+			}
+			else if( cache != NULL )
+			{
+				declCache.AddScan( *scan );
+			}
+
+			files[first + i]->MergeScan( *scan );
+
+			for( int j = 0; j < scan->entries.Num(); j++ )
+			{
+				typeTimings[scan->entries[j].type].numScanned++;
+			}
+			for( int j = 0; j < DECL_MAX_TYPES; j++ )
+			{
+				typeTimings[j].scanTime += scan->scanTime[j];
+			}
+			delete scan;
+		}
+	}
+
+	return numCached;
+}
+
+/*
+===================
+idDeclManagerLocal::GetDeclTypesChecksum
+
+The decl types decide how a file is split up into decls.
+===================
+*/
+int idDeclManagerLocal::GetDeclTypesChecksum() const
+{
+	idStr types;
+	for( int i = 0; i < declTypes.Num(); i++ )
+	{
+		if( declTypes[i] != NULL )
+		{
+			types += va( "%d %s\n", declTypes[i]->type, declTypes[i]->typeName.c_str() );
+		}
+	}
+	return MD5_BlockChecksum( types.c_str(), types.Length() );
+}
+
 /*
 ===================
 idDeclManagerLocal::GetChecksum
@@ -1960,6 +2930,34 @@ void idDeclManagerLocal::ListDecls_f( const idCmdArgs& args )
 	common->Printf( "%iKB in text, %iKB in structures\n", totalText >> 10, totalStructs >> 10 );
 }
 
+/*
+================
+idDeclManagerLocal::ListDeclTimings_f
+================
+*/
+void idDeclManagerLocal::ListDeclTimings_f( const idCmdArgs& args )
+{
+	declTypeTiming_t total;
+	memset( &total, 0, sizeof( total ) );
+
+	common->Printf( "scanned  scan msec   parsed parse msec type\n" );
+	for( int i = 0; i < declManagerLocal.declTypes.Num(); i++ )
+	{
+		if( declManagerLocal.declTypes[i] == NULL )
+		{
+			continue;
+		}
+		const declTypeTiming_t& timing = declManagerLocal.typeTimings[i];
+		common->Printf( "%7d %10.1f %8d %10.1f %s\n", timing.numScanned, timing.scanTime * 0.001f, timing.numParsed, timing.parseTime * 0.001f, declManagerLocal.declTypes[i]->typeName.c_str() );
+
+		total.numScanned += timing.numScanned;
+		total.scanTime += timing.scanTime;
+		total.numParsed += timing.numParsed;
+		total.parseTime += timing.parseTime;
+	}
+	common->Printf( "%7d %10.1f %8d %10.1f total\n", total.numScanned, total.scanTime * 0.001f, total.numParsed, total.parseTime * 0.001f );
+}
+
 /*
 ===================
 idDeclManagerLocal::ReloadDecls_f
@@ -4589,31 +5587,27 @@ idDeclLocal::SetTextLocal
 */
 void idDeclLocal::SetTextLocal( const char* text, const int length )
 {
+	int newCompressedLength;
+	char* newText = AllocDeclText( text, length, newCompressedLength );
+	SetCompressedTextLocal( newText, newCompressedLength, length, MD5_BlockChecksum( text, length ) );
+}
 
+/*
+=================
+idDeclLocal::SetCompressedTextLocal
+=================
+*/
+void idDeclLocal::SetCompressedTextLocal( char* text, const int compressedLength, const int length, const int checksum )
+{
 	Mem_Free( textSource );
 
-	checksum = MD5_BlockChecksum( text, length );
-
-#ifdef GET_HUFFMAN_FREQUENCIES
-	for( int i = 0; i < length; i++ )
-	{
-		huffmanFrequencies[( ( const unsigned char* )text )[i]]++;
-	}
-#endif
-
-#ifdef USE_COMPRESSED_DECLS
-	int maxBytesPerCode = ( maxHuffmanBits + 7 ) >> 3;
-	byte* compressed = ( byte* )_alloca( length * maxBytesPerCode );
-	compressedLength = HuffmanCompressText( text, length, compressed, length * maxBytesPerCode );
-	textSource = ( char* )Mem_Alloc( compressedLength, TAG_DECLTEXT );
-	memcpy( textSource, compressed, compressedLength );
-#else
-	compressedLength = length;
-	textSource = ( char* ) Mem_Alloc( length + 1, TAG_DECLTEXT );
-	memcpy( textSource, text, length );
-	textSource[length] = '\0';
-#endif
+	textSource = text;
 	textLength = length;
+	this->compressedLength = compressedLength;
+	this->checksum = checksum;
+
+	totalUncompressedLength += length;
+	totalCompressedLength += compressedLength;
 }
 
 /*
@@ -4905,11 +5899,20 @@ void idDeclLocal::ParseLocal()
 
 	declState = DS_PARSED;
 
+	const uint64 startTime = Sys_Microseconds();
+	const uint64 outerNestedParseTime = declManagerLocal.nestedParseTime;
+	declManagerLocal.nestedParseTime = 0;
+
 	// parse
 	char* declText = ( char* ) _alloca( ( GetTextLength() + 1 ) * sizeof( char ) );
 	GetText( declText );
 	self->Parse( declText, GetTextLength(), true );
 
+	const uint64 parseTime = Sys_Microseconds() - startTime;
+	declManagerLocal.typeTimings[type].numParsed++;
+	declManagerLocal.typeTimings[type].parseTime += parseTime - declManagerLocal.nestedParseTime;
+	declManagerLocal.nestedParseTime = outerNestedParseTime + parseTime;
+
 	// free generated text
 	if( generatedDefaultText )
 	{
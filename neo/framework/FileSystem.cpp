@@ -157,6 +157,9 @@ public:
 	virtual void			CreateOSPath( const char* OSPath );
 	virtual int				ReadFile( const char* relativePath, void** buffer, ID_TIME_T* timestamp );
 	virtual void			FreeFile( void* buffer );
+	virtual void			ReadFileAsync( fileReadRequest_t* request );
+	virtual void			WaitForFileRead( fileReadRequest_t* request );
+	virtual void			FreeFileRead( fileReadRequest_t* request );
 	virtual int				WriteFile( const char* relativePath, const void* buffer, int size, const char* basePath = "fs_savepath" );
 	virtual void			RemoveFile( const char* relativePath );
 	virtual	bool			RemoveDir( const char* relativePath );
@@ -215,6 +218,9 @@ public:
 	virtual void			StopPreload();
 	idFile* 				GetResourceFile( const char* fileName, bool memFile );
 	bool					GetResourceCacheEntry( const char* fileName, idResourceCacheEntry& rc );
+	void					RebuildResourceIndex();
+	int						FindPreload( const char* relativePath );
+	idFile* 				OpenPreloadedFile( const char* relativePath );
 	virtual int				ReadFromBGL( idFile* _resourceFile, void* _buffer, int _offset, int _len );
 	virtual bool			IsBinaryModel( const idStr& resName ) const;
 	virtual bool			IsSoundSample( const idStr& resName ) const;
@@ -258,6 +264,7 @@ public:
 	static void				ExtractResourceFile_f( const idCmdArgs& args );
 	static void				UpdateResourceFile_f( const idCmdArgs& args );
 	static void				GenerateResourceCRCs_f( const idCmdArgs& args );
+	static void				BenchmarkResourceLookup_f( const idCmdArgs& args );
 	static void				CreateCRCsForResourceFileList( const idFileList& list );
 
 	void					BuildOrderedStartupContainer();
@@ -280,6 +287,14 @@ private:
 	idStrList				fileManifest;
 	idPreloadManifest		preloadList;
 
+	// every resource of every container, only the one a search path walk would find first
+	idList< const idResourceCacheEntry*, TAG_RESOURCE >	resourceIndex;
+	idHashIndex				resourceIndexHash;
+
+	// files read in the background between StartPreload and StopPreload
+	idList< fileReadRequest_t*, TAG_IDFILE >	preloadRequests;
+	idHashIndex				preloadHash;
+
 	byte* 	resourceBufferPtr;
 	int		resourceBufferSize;
 	int		resourceBufferAvailable;
@@ -360,13 +375,434 @@ int idFileSystemLocal::ReadFromBGL( idFile* _resourceFile, void* _buffer, int _o
 	return _resourceFile->Read( _buffer, _len );
 }
 
+/*
+================================================================================================
+
+	Asynchronous file reads
+
+================================================================================================
+*/
+
+static const int MAX_FILE_READ_THREADS = 8;
+
+idCVar fs_readThreads( "fs_readThreads", "2", CVAR_SYSTEM | CVAR_INTEGER | CVAR_INIT, "number of threads reading files in the background", 1, MAX_FILE_READ_THREADS );
+
+class idFileReadThread : public idSysThread
+{
+public:
+	virtual int				Run();
+};
+
+class idFileReadQueue
+{
+public:
+	idFileReadQueue();
+
+	void					Init();
+	void					Shutdown();
+
+	void					Add( fileReadRequest_t* request );
+	fileReadRequest_t* 		Get();
+	bool					Remove( fileReadRequest_t* request );
+
+	void					Complete( fileReadRequest_t* request );
+	void					WaitForCallback( fileReadRequest_t* request );
+	void					FinishCallback();
+
+	static void				Read( fileReadRequest_t* request );
+
+private:
+	idSysMutex				mutex;
+	idList< fileReadRequest_t*, TAG_IDFILE >	queued[NUM_FILE_READ_PRIORITIES];
+	int						firstQueued[NUM_FILE_READ_PRIORITIES];
+	idFileReadThread		threads[MAX_FILE_READ_THREADS];
+	int						numThreads;
+	idParallelJobList* 		jobList;			// never submitted, only used to spawn the callbacks
+	idSysInterlockedInteger	numCallbacks;
+};
+
+static idFileReadQueue fileReadQueue;
+
+/*
+========================
+FileReadCallbackJob
+========================
+*/
+static void FileReadCallbackJob( fileReadRequest_t* request )
+{
+	request->callback( request );
+
+	fileReadQueue.FinishCallback();
+}
+
+REGISTER_PARALLEL_JOB( FileReadCallbackJob, "FileReadCallbackJob" );
+
+/*
+========================
+idFileReadThread::Run
+========================
+*/
+int idFileReadThread::Run()
+{
+	while( !IsTerminating() )
+	{
+		fileReadRequest_t* request = fileReadQueue.Get();
+		if( request == NULL )
+		{
+			break;
+		}
+		idFileReadQueue::Read( request );
+		fileReadQueue.Complete( request );
+	}
+	return 0;
+}
+
+/*
+========================
+idFileReadQueue::idFileReadQueue
+========================
+*/
+idFileReadQueue::idFileReadQueue()
+{
+	memset( firstQueued, 0, sizeof( firstQueued ) );
+	numThreads = 0;
+	jobList = NULL;
+}
+
+/*
+========================
+idFileReadQueue::Init
+========================
+*/
+void idFileReadQueue::Init()
+{
+	if( numThreads > 0 )
+	{
+		return;
+	}
+	numThreads = fs_readThreads.GetInteger();
+	for( int i = 0; i < numThreads; i++ )
+	{
+		threads[i].StartWorkerThread( va( "FileRead_%d", i ), CORE_ANY );
+	}
+}
+
+/*
+========================
+idFileReadQueue::Shutdown
+========================
+*/
+void idFileReadQueue::Shutdown()
+{
+	for( int i = 0; i < numThreads; i++ )
+	{
+		threads[i].StopThread();
+	}
+	numThreads = 0;
+
+	if( jobList != NULL )
+	{
+		while( numCallbacks.GetValue() > 0 )
+		{
+			Sys_Yield();
+		}
+		parallelJobManager->FreeJobList( jobList );
+		jobList = NULL;
+	}
+}
+
+/*
+========================
+idFileReadQueue::Add
+========================
+*/
+void idFileReadQueue::Add( fileReadRequest_t* request )
+{
+	// allocated here because the parallel job manager isn't initialized yet when the file system is
+	if( request->callback != NULL && jobList == NULL )
+	{
+		jobList = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_LOW, 1, 0, NULL );
+	}
+
+	request->state = FILE_READ_QUEUED;
+
+	mutex.Lock();
+	queued[request->priority].Append( request );
+	mutex.Unlock();
+
+	for( int i = 0; i < numThreads; i++ )
+	{
+		threads[i].SignalWork();
+	}
+}
+
+/*
+========================
+idFileReadQueue::Get
+
+Returns the oldest request with the highest priority or NULL if the queue is empty.
+========================
+*/
+fileReadRequest_t* idFileReadQueue::Get()
+{
+	idScopedCriticalSection lock( mutex );
+
+	for( int priority = NUM_FILE_READ_PRIORITIES - 1; priority >= 0; priority-- )
+	{
+		idList< fileReadRequest_t*, TAG_IDFILE >& list = queued[priority];
+		while( firstQueued[priority] < list.Num() )
+		{
+			fileReadRequest_t* request = list[firstQueued[priority]++];
+			if( request != NULL )
+			{
+				request->state = FILE_READ_READING;
+				return request;
+			}
+		}
+		list.SetNum( 0 );
+		firstQueued[priority] = 0;
+	}
+	return NULL;
+}
+
+/*
+========================
+idFileReadQueue::Remove
+
+Returns true if the request was still queued.
+========================
+*/
+bool idFileReadQueue::Remove( fileReadRequest_t* request )
+{
+	idScopedCriticalSection lock( mutex );
+
+	if( request->state != FILE_READ_QUEUED )
+	{
+		return false;
+	}
+
+	idList< fileReadRequest_t*, TAG_IDFILE >& list = queued[request->priority];
+	for( int i = firstQueued[request->priority]; i < list.Num(); i++ )
+	{
+		if( list[i] == request )
+		{
+			list[i] = NULL;
+			request->state = FILE_READ_READING;
+			return true;
+		}
+	}
+	return false;
+}
+
+/*
+========================
+idFileReadQueue::Read
+========================
+*/
+void idFileReadQueue::Read( fileReadRequest_t* request )
+{
+	if( request->file == NULL )
+	{
+		return;
+	}
+
+	if( request->buffer != NULL )
+	{
+		// the file stays open and the buffer points into its mapped container,
+		// touch every page so the data is resident once the read is done
+		volatile byte touched = 0;
+		for( int i = 0; i < request->length; i += 4096 )
+		{
+			touched += request->buffer[i];
+		}
+		return;
+	}
+
+	const int length = request->file->Length();
+	request->buffer = ( byte* )Mem_Alloc( length + 1, TAG_IDFILE );
+	request->length = request->file->Read( request->buffer, length );
+	request->buffer[Max( request->length, 0 )] = 0;
+
+	delete request->file;
+	request->file = NULL;
+}
+
+/*
+========================
+idFileReadQueue::Complete
+========================
+*/
+void idFileReadQueue::Complete( fileReadRequest_t* request )
+{
+	if( request->callback == NULL )
+	{
+		SYS_MEMORYBARRIER;
+		request->state = FILE_READ_DONE;
+		return;
+	}
+
+	numCallbacks.Increment();
+
+	// nothing would pick up the job without job threads
+	if( parallelJobManager->GetNumProcessingUnits() == 0 )
+	{
+		request->state = FILE_READ_COMPLETING;
+		FileReadCallbackJob( request );
+
+		SYS_MEMORYBARRIER;
+		request->state = FILE_READ_DONE;
+		return;
+	}
+
+	// the counter is raised before the state changes, so waiters can't see a finished callback early
+	jobList->Spawn( ( jobRun_t )FileReadCallbackJob, request, request->callbackJob );
+
+	SYS_MEMORYBARRIER;
+	request->state = FILE_READ_COMPLETING;
+}
+
+/*
+========================
+idFileReadQueue::WaitForCallback
+
+Runs jobs while waiting for the callback of the request.
+========================
+*/
+void idFileReadQueue::WaitForCallback( fileReadRequest_t* request )
+{
+	jobList->Join( request->callbackJob );
+}
+
+/*
+========================
+idFileReadQueue::FinishCallback
+========================
+*/
+void idFileReadQueue::FinishCallback()
+{
+	numCallbacks.Decrement();
+}
+
+/*
+================
+idFileSystemLocal::ReadFileAsync
+================
+*/
+void idFileSystemLocal::ReadFileAsync( fileReadRequest_t* request )
+{
+	request->file = NULL;
+	request->buffer = NULL;
+	request->length = -1;
+	request->timestamp = FILE_NOT_FOUND_TIMESTAMP;
+
+	// only files that don't share a file handle with this thread can be read in the background
+	idResourceCacheEntry rc;
+	const bool inResourceFile = UsingResourceFiles() && GetResourceCacheEntry( request->fileName, rc );
+	if( !UsingZipFiles() && ( !inResourceFile || rc.owner->IsMapped() ) )
+	{
+		request->file = OpenFileRead( request->fileName, false );
+		if( request->file != NULL )
+		{
+			request->timestamp = request->file->Timestamp();
+			loadCount++;
+			loadStack++;
+
+			// hand out the mapped data instead of a copy
+			idFile_MappedResource* mappedFile = dynamic_cast< idFile_MappedResource* >( request->file );
+			if( mappedFile != NULL && request->allowMappedData )
+			{
+				request->buffer = ( byte* )mappedFile->GetDataPtr();
+				request->length = mappedFile->Length();
+			}
+		}
+		fileReadQueue.Add( request );
+		return;
+	}
+
+	void* buffer = NULL;
+	request->length = ReadFile( request->fileName, &buffer, &request->timestamp );
+	request->buffer = ( byte* )buffer;
+	fileReadQueue.Add( request );
+}
+
+/*
+================
+idFileSystemLocal::WaitForFileRead
+================
+*/
+void idFileSystemLocal::WaitForFileRead( fileReadRequest_t* request )
+{
+	if( fileReadQueue.Remove( request ) )
+	{
+		idFileReadQueue::Read( request );
+		fileReadQueue.Complete( request );
+	}
+
+	while( !request->IsDone() )
+	{
+		if( request->state == FILE_READ_COMPLETING )
+		{
+			fileReadQueue.WaitForCallback( request );
+		}
+		else
+		{
+			Sys_Yield();
+		}
+	}
+}
+
+/*
+================
+idFileSystemLocal::FreeFileRead
+================
+*/
+void idFileSystemLocal::FreeFileRead( fileReadRequest_t* request )
+{
+	assert( request->IsDone() );
+
+	if( request->file != NULL )
+	{
+		// the buffer points into the mapped data of the file
+		delete request->file;
+		loadStack--;
+	}
+	else if( request->buffer != NULL )
+	{
+		// takes the copy off the load stack
+		FreeFile( request->buffer );
+	}
+	request->file = NULL;
+	request->buffer = NULL;
+}
+
 /*
 ================
 idFileSystemLocal::StartPreload
+
+Starts reading the given files in the background, opening any of them
+returns the preloaded data until StopPreload is called.
 ================
 */
 void idFileSystemLocal::StartPreload( const idStrList& _preload )
 {
+	StopPreload();
+
+	for( int i = 0; i < _preload.Num(); i++ )
+	{
+		if( FindPreload( _preload[i] ) != -1 )
+		{
+			continue;
+		}
+
+		fileReadRequest_t* request = new( TAG_IDFILE ) fileReadRequest_t;
+		request->fileName = _preload[i];
+		request->fileName.BackSlashesToSlashes();
+		request->priority = FILE_READ_PRIORITY_LOW;
+		request->allowMappedData = true;
+		ReadFileAsync( request );
+
+		preloadHash.Add( preloadHash.GenerateKey( request->fileName, false ), preloadRequests.Append( request ) );
+	}
 }
 
 /*
@@ -376,6 +812,81 @@ idFileSystemLocal::StopPreload
 */
 void idFileSystemLocal::StopPreload()
 {
+	for( int i = 0; i < preloadRequests.Num(); i++ )
+	{
+		fileReadRequest_t* request = preloadRequests[i];
+		if( request == NULL )
+		{
+			continue;
+		}
+		WaitForFileRead( request );
+		FreeFileRead( request );
+		delete request;
+	}
+	preloadRequests.Clear();
+	preloadHash.Clear();
+}
+
+/*
+================
+idFileSystemLocal::FindPreload
+================
+*/
+int idFileSystemLocal::FindPreload( const char* relativePath )
+{
+	const int key = preloadHash.GenerateKey( relativePath, false );
+	for( int i = preloadHash.GetFirst( key ); i != idHashIndex::NULL_INDEX; i = preloadHash.GetNext( i ) )
+	{
+		if( preloadRequests[i] != NULL && FilenameCompare( preloadRequests[i]->fileName, relativePath ) == false )
+		{
+			return i;
+		}
+	}
+	return -1;
+}
+
+/*
+================
+idFileSystemLocal::OpenPreloadedFile
+
+Hands out the data of a preloaded file, every preload is only used once.
+================
+*/
+idFile* idFileSystemLocal::OpenPreloadedFile( const char* relativePath )
+{
+	const int index = FindPreload( relativePath );
+	if( index == -1 )
+	{
+		return NULL;
+	}
+
+	fileReadRequest_t* request = preloadRequests[index];
+	preloadRequests[index] = NULL;
+
+	WaitForFileRead( request );
+
+	idFile* file = NULL;
+	if( request->length > 0 && request->file != NULL )
+	{
+		// view into a mapped container
+		file = request->file;
+		request->file = NULL;
+		loadStack--;
+	}
+	else if( request->length > 0 )
+	{
+		idFile_Memory* memFile = new( TAG_IDFILE ) idFile_Memory( relativePath, ( const char* )request->buffer, request->length );
+		memFile->TakeDataOwnership();
+		file = memFile;
+		loadStack--;
+	}
+	else
+	{
+		FreeFileRead( request );
+	}
+	delete request;
+
+	return file;
 }
 
 /*
@@ -2078,7 +2589,7 @@ int idFileSystemLocal::ReadFile( const char* relativePath, void** buffer, ID_TIM
 		// RB: moved here
 		if( buffer == NULL && timestamp != NULL && UsingResourceFiles() )
 		{
-			static idResourceCacheEntry rc;
+			idResourceCacheEntry rc;
 			int size = 0;
 			if( GetResourceCacheEntry( relativePath, rc ) )
 			{
@@ -3063,6 +3574,7 @@ idVec2i idFileSystemLocal::AddResourceFile( const char* resourceFileName )
 		{
 			search.resourceFiles.Append( rc );
 			common->Printf( "Loaded resource file %s\n", resourceFile.c_str() );
+			RebuildResourceIndex();
 			return idVec2i( sp, search.resourceFiles.Num() - 1 );
 		}
 		delete rc;
@@ -3108,6 +3620,7 @@ void idFileSystemLocal::RemoveResourceFileByIndex( const idVec2i& idx )
 		{
 			delete search.resourceFiles[ idx.y ];
 			search.resourceFiles.RemoveIndex( idx.y );
+			RebuildResourceIndex();
 		}
 	}
 }
@@ -3331,6 +3844,10 @@ void idFileSystemLocal::Startup()
 		SetupGameDirectories( fs_game.GetString() );
 	}
 
+	RebuildResourceIndex();
+
+	fileReadQueue.Init();
+
 	// add our commands
 	cmdSystem->AddCommand( "dir", Dir_f, CMD_FL_SYSTEM, "lists a folder", idCmdSystem::ArgCompletion_FileName );
 	cmdSystem->AddCommand( "dirtree", DirTree_f, CMD_FL_SYSTEM, "lists a folder with subfolders" );
@@ -3344,6 +3861,7 @@ void idFileSystemLocal::Startup()
 	cmdSystem->AddCommand( "updateResourceFile", UpdateResourceFile_f, CMD_FL_SYSTEM, "updates or appends the supplied files in the supplied resource file" );
 
 	cmdSystem->AddCommand( "generateResourceCRCs", GenerateResourceCRCs_f, CMD_FL_SYSTEM, "Generates CRC checksums for all the resource files." );
+	cmdSystem->AddCommand( "benchmarkResourceLookup", BenchmarkResourceLookup_f, CMD_FL_SYSTEM, "times looking up every resource in the resource index" );
 
 	// print the current search paths
 	Path_f( idCmdArgs() );
@@ -3433,6 +3951,13 @@ Frees all resources and closes all files
 */
 void idFileSystemLocal::Shutdown( bool reloading )
 {
+	// preloaded files may still be reading from the containers
+	StopPreload();
+	if( !reloading )
+	{
+		fileReadQueue.Shutdown();
+	}
+
 	gameFolder.Clear();
 
 	for( int sp = fileSystemLocal.searchPaths.Num() - 1; sp >= 0; sp-- )
@@ -3441,6 +3966,8 @@ void idFileSystemLocal::Shutdown( bool reloading )
 		search.resourceFiles.DeleteContents();
 		search.zipFiles.DeleteContents();
 	}
+	resourceIndex.Clear();
+	resourceIndexHash.Clear();
 
 	cmdSystem->RemoveCommand( "path" );
 	cmdSystem->RemoveCommand( "dir" );
@@ -3467,6 +3994,62 @@ Opening files
 =================================================================================
 */
 
+/*
+========================
+idFileSystemLocal::RebuildResourceIndex
+
+Merges the entries of all resource containers into a single hash, must be called whenever
+a container is added or removed. Containers are visited in the order GetResourceCacheEntry
+used to search them, the first entry found for a file name wins.
+========================
+*/
+void idFileSystemLocal::RebuildResourceIndex()
+{
+	int numEntries = 0;
+	for( int sp = 0; sp < searchPaths.Num(); sp++ )
+	{
+		for( int idx = 0; idx < searchPaths[sp].resourceFiles.Num(); idx++ )
+		{
+			numEntries += searchPaths[sp].resourceFiles[idx]->cacheTable.Num();
+		}
+	}
+
+	resourceIndex.Clear();
+	resourceIndex.Resize( numEntries );
+	resourceIndexHash.Clear( idMath::CeilPowerOfTwo( Max( numEntries, 1024 ) ), Max( numEntries, 1024 ) );
+
+	for( int sp = searchPaths.Num() - 1; sp >= 0; sp-- )
+	{
+		const searchpath_t& search = searchPaths[sp];
+
+		for( int idx = search.resourceFiles.Num() - 1; idx >= 0; idx-- )
+		{
+			const idResourceContainer* container = search.resourceFiles[idx];
+
+			// later duplicates inside a container were found first by the container hash
+			for( int i = container->cacheTable.Num() - 1; i >= 0; i-- )
+			{
+				const idResourceCacheEntry& rt = container->cacheTable[i];
+				const int key = resourceIndexHash.GenerateKey( rt.filename, false );
+
+				bool found = false;
+				for( int index = resourceIndexHash.GetFirst( key ); index != idHashIndex::NULL_INDEX; index = resourceIndexHash.GetNext( index ) )
+				{
+					if( idStr::Icmp( resourceIndex[index]->filename, rt.filename ) == 0 )
+					{
+						found = true;
+						break;
+					}
+				}
+				if( !found )
+				{
+					resourceIndexHash.Add( key, resourceIndex.Append( &rt ) );
+				}
+			}
+		}
+	}
+}
+
 /*
 ========================
 idFileSystemLocal::GetResourceCacheEntry
@@ -3493,32 +4076,65 @@ bool idFileSystemLocal::GetResourceCacheEntry( const char* fileName, idResourceC
 	canonical.BackSlashesToSlashes();
 	canonical.ToLower();
 
-	for( int sp = fileSystemLocal.searchPaths.Num() - 1; sp >= 0; sp-- )
+	const int key = resourceIndexHash.GenerateKey( canonical, false );
+	for( int index = resourceIndexHash.GetFirst( key ); index != idHashIndex::NULL_INDEX; index = resourceIndexHash.GetNext( index ) )
 	{
-		const searchpath_t& search = fileSystemLocal.searchPaths[sp];
+		const idResourceCacheEntry& rt = *resourceIndex[index];
+		if( idStr::Cmp( rt.filename, canonical ) == 0 )
+		{
+			rc.filename = rt.filename;
+			rc.length = rt.length;
+			rc.offset = rt.offset;
+			rc.owner = rt.owner;
 
-		int idx = search.resourceFiles.Num() - 1;
-		while( idx >= 0 )
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/*
+========================
+idFileSystemLocal::BenchmarkResourceLookup_f
+========================
+*/
+void idFileSystemLocal::BenchmarkResourceLookup_f( const idCmdArgs& args )
+{
+	const int numEntries = fileSystemLocal.resourceIndex.Num();
+	if( numEntries == 0 )
+	{
+		common->Printf( "no resource files loaded\n" );
+		return;
+	}
+
+	const int iterations = ( args.Argc() > 1 ) ? Max( 1, atoi( args.Argv( 1 ) ) ) : 10;
+
+	idStrList fileNames;
+	fileNames.SetNum( numEntries );
+	for( int i = 0; i < numEntries; i++ )
+	{
+		fileNames[i] = fileSystemLocal.resourceIndex[i]->filename;
+	}
+
+	int misses = 0;
+	idResourceCacheEntry rc;
+
+	const uint64 start = Sys_Microseconds();
+	for( int j = 0; j < iterations; j++ )
+	{
+		for( int i = 0; i < numEntries; i++ )
 		{
-			const int key = search.resourceFiles[ idx ]->cacheHash.GenerateKey( canonical, false );
-			for( int index = search.resourceFiles[ idx ]->cacheHash.GetFirst( key ); index != idHashIndex::NULL_INDEX; index = search.resourceFiles[ idx ]->cacheHash.GetNext( index ) )
+			if( !fileSystemLocal.GetResourceCacheEntry( fileNames[i], rc ) || rc.owner != fileSystemLocal.resourceIndex[i]->owner )
 			{
-				idResourceCacheEntry& rt = search.resourceFiles[ idx ]->cacheTable[ index ];
-				if( idStr::Icmp( rt.filename, canonical ) == 0 )
-				{
-					rc.filename = rt.filename;
-					rc.length = rt.length;
-					rc.offset = rt.offset;
-					rc.owner = search.resourceFiles[idx];
-
-					return true;
-				}
+				misses++;
 			}
-			idx--;
 		}
 	}
+	const uint64 end = Sys_Microseconds();
 
-	return false;
+	const int numLookups = numEntries * iterations;
+	common->Printf( "%d lookups of %d resources in %1.2f ms, %1.3f us per lookup, %d failed\n", numLookups, numEntries, ( end - start ) * ( 1.0f / 1000.0f ), ( float )( end - start ) / numLookups, misses );
 }
 
 
@@ -3658,7 +4274,7 @@ idFile* idFileSystemLocal::GetResourceFile( const char* fileName, bool memFile )
 		return NULL;
 	}
 
-	static idResourceCacheEntry rc;
+	idResourceCacheEntry rc;
 	if( GetResourceCacheEntry( fileName, rc ) )
 	{
 		if( fs_debugResources.GetBool() )
@@ -3666,6 +4282,13 @@ idFile* idFileSystemLocal::GetResourceFile( const char* fileName, bool memFile )
 			idLib::Printf( "RES: loading file %s\n", rc.filename.c_str() );
 		}
 
+		// read only view straight into the mapped container
+		idFile* mappedFile = rc.owner->OpenMappedFile( rc );
+		if( mappedFile != NULL )
+		{
+			return mappedFile;
+		}
+
 		idFile_InnerResource* file = new idFile_InnerResource( rc.filename, rc.owner->resourceFile, rc.offset, rc.length );
 
 		// DG: add parenthesis to make sure this block is only entered when file != NULL - bug found by clang.
@@ -3760,6 +4383,17 @@ idFile* idFileSystemLocal::OpenFileReadFlags( const char* relativePath, int sear
 		idLib::Printf( "FILE DEBUG: opening %s\n", relativePath );
 	}
 
+	// the preloads were looked up like OpenFileRead does and are only handed out on the
+	// main thread, which starts and stops them
+	if( idLib::IsMainThread() && preloadRequests.Num() > 0 && ( searchFlags & FSFLAG_SEARCH_DIRS ) != 0 && ( gamedir == NULL || gamedir[0] == '\0' ) )
+	{
+		idFile* file = OpenPreloadedFile( relativePath );
+		if( file != NULL )
+		{
+			return file;
+		}
+	}
+
 	// RB: .pk4 files have a higher priority than .resources because they are aimed for modding
 	if( UsingZipFiles() && fs_resourceLoadPriority.GetInteger() == 1 )
 	{
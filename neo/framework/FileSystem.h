@@ -74,6 +74,57 @@ typedef enum
 	FIND_YES
 } findFile_t;
 
+enum fileReadPriority_t
+{
+	FILE_READ_PRIORITY_LOW,
+	FILE_READ_PRIORITY_NORMAL,
+	FILE_READ_PRIORITY_HIGH,
+	NUM_FILE_READ_PRIORITIES
+};
+
+enum fileReadState_t
+{
+	FILE_READ_QUEUED,
+	FILE_READ_READING,
+	FILE_READ_COMPLETING,		// the callback is queued or running
+	FILE_READ_DONE
+};
+
+// an asynchronous read of a complete file, must stay valid until it is done
+struct fileReadRequest_t
+{
+	fileReadRequest_t() :
+		priority( FILE_READ_PRIORITY_NORMAL ),
+		callback( NULL ),
+		userData( NULL ),
+		allowMappedData( false ),
+		file( NULL ),
+		buffer( NULL ),
+		length( -1 ),
+		timestamp( FILE_NOT_FOUND_TIMESTAMP ),
+		state( FILE_READ_DONE ) {}
+
+	idStrStatic< MAX_OSPATH >	fileName;
+	fileReadPriority_t			priority;
+	jobRun_t					callback;	// registered job run on a job thread with the request once the file is read
+	void* 						userData;
+	bool						allowMappedData;	// accept a buffer that points into a memory mapped container
+
+	// set by the file system
+	idFile* 					file;
+	byte* 						buffer;		// 0 terminated like ReadFile unless it is mapped data, free with FreeFileRead
+	int							length;		// -1 if the file wasn't found
+	ID_TIME_T					timestamp;
+	volatile int				state;
+	idParallelJobCounter		callbackJob;
+
+	// the callback job doesn't touch the request anymore once its counter is done
+	bool						IsDone() const
+	{
+		return state == FILE_READ_DONE || ( state == FILE_READ_COMPLETING && callbackJob.IsDone() );
+	}
+};
+
 // file list for directory listings
 class idFileList
 {
@@ -159,6 +210,16 @@ public:
 	// Frees the memory allocated by ReadFile.
 	virtual void			FreeFile( void* buffer ) = 0;
 
+	// Queues a read of a complete file on the file read threads. The file is looked up right
+	// away on the calling thread, so this must be called from the thread that uses the file system.
+	virtual void			ReadFileAsync( fileReadRequest_t* request ) = 0;
+
+	// Returns once the read and its callback are done, a still queued read is done on the calling thread.
+	virtual void			WaitForFileRead( fileReadRequest_t* request ) = 0;
+
+	// Frees the buffer of a finished read.
+	virtual void			FreeFileRead( fileReadRequest_t* request ) = 0;
+
 	// Writes a complete file, will create any needed subdirectories.
 	// Returns the length of the file, or -1 on failure.
 	virtual int				WriteFile( const char* relativePath, const void* buffer, int size, const char* basePath = "fs_savepath" ) = 0;
@@ -238,6 +299,8 @@ public:
 	virtual bool			UsingZipFiles() = 0; // RB
 	virtual void			UnloadMapResources( const char* name ) = 0;
 	virtual void			UnloadResourceContainer( const char* name ) = 0;
+	// Reads the files in the background, OpenFileRead on the main thread returns the
+	// preloaded data until StopPreload. Both must be called from the main thread.
 	virtual void			StartPreload( const idStrList& _preload ) = 0;
 	virtual void			StopPreload() = 0;
 	virtual int				ReadFromBGL( idFile* _resourceFile, void* _buffer, int _offset, int _len ) = 0;
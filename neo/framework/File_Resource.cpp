@@ -33,6 +33,14 @@ If you have questions concerning this license or the applicable additional terms
 #include "../sound/WaveFile.h"
 #include "../renderer/CmdlineProgressbar.h"
 
+#ifndef _WIN32
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <unistd.h>
+#endif
+
+idCVar fs_mapResources( "fs_mapResources", "1", CVAR_SYSTEM | CVAR_BOOL | CVAR_INIT, "memory map .resources files and hand out files that point straight into the mapping, not supported on Windows" );
+
 /*
 ================================================================================================
 
@@ -48,8 +56,159 @@ idResourceContainer::ReOpen
 */
 void idResourceContainer::ReOpen()
 {
+	// the file may have been rewritten
+	const bool mapped = IsMapped();
+	UnmapFile();
+
 	delete resourceFile;
 	resourceFile = fileSystem->OpenFileRead( fileName );
+
+	if( mapped && resourceFile != NULL )
+	{
+		MapFile( false );
+	}
+}
+
+/*
+========================
+idResourceContainer::MapFile
+
+Maps the whole container so resources can be read without allocating and copying.
+========================
+*/
+void idResourceContainer::MapFile( bool prefetch )
+{
+#ifndef _WIN32
+	const int fd = open( resourceFile->GetFullPath(), O_RDONLY );
+	if( fd == -1 )
+	{
+		// not a plain file on disk
+		return;
+	}
+
+	const size_t length = resourceFile->Length();
+	void* data = mmap( NULL, length, PROT_READ, MAP_SHARED, fd, 0 );
+	close( fd );
+
+	if( data == MAP_FAILED )
+	{
+		idLib::Warning( "Unable to map resource file %s", resourceFile->GetFullPath() );
+		return;
+	}
+
+	// the startup container is read front to back right away
+	if( prefetch )
+	{
+		madvise( data, length, MADV_SEQUENTIAL );
+		madvise( data, length, MADV_WILLNEED );
+	}
+
+	mapping = new( TAG_RESOURCE ) idResourceMapping( ( const byte* )data, length );
+#endif
+}
+
+/*
+========================
+idResourceContainer::UnmapFile
+========================
+*/
+void idResourceContainer::UnmapFile()
+{
+	// files that are still open keep the mapping alive
+	if( mapping != NULL )
+	{
+		mapping->Release();
+		mapping = NULL;
+	}
+}
+
+/*
+========================
+idResourceContainer::OpenMappedFile
+========================
+*/
+idFile* idResourceContainer::OpenMappedFile( const idResourceCacheEntry& rc )
+{
+	if( mapping == NULL )
+	{
+		return NULL;
+	}
+	return new( TAG_IDFILE ) idFile_MappedResource( rc.filename, mapping, rc.offset, rc.length );
+}
+
+/*
+================================================================================================
+
+idResourceMapping
+
+================================================================================================
+*/
+
+/*
+========================
+idResourceMapping::idResourceMapping
+========================
+*/
+idResourceMapping::idResourceMapping( const byte* data, size_t length )
+{
+	this->data = data;
+	this->length = length;
+	refCount.SetValue( 1 );
+}
+
+/*
+========================
+idResourceMapping::~idResourceMapping
+========================
+*/
+idResourceMapping::~idResourceMapping()
+{
+#ifndef _WIN32
+	munmap( ( void* )data, length );
+#endif
+}
+
+/*
+========================
+idResourceMapping::Release
+========================
+*/
+void idResourceMapping::Release()
+{
+	if( refCount.Decrement() == 0 )
+	{
+		delete this;
+	}
+}
+
+/*
+================================================================================================
+
+idFile_MappedResource
+
+================================================================================================
+*/
+
+/*
+========================
+idFile_MappedResource::idFile_MappedResource
+========================
+*/
+idFile_MappedResource::idFile_MappedResource( const char* name, idResourceMapping* mapping, int offset, int length ) :
+	idFile_Memory( name, ( const char* )mapping->GetData() + offset, length )
+{
+	mapping->AddRef();
+	this->mapping = mapping;
+}
+
+/*
+========================
+idFile_MappedResource::~idFile_MappedResource
+========================
+*/
+idFile_MappedResource::~idFile_MappedResource()
+{
+	mapping->Release();
 }
 
 /*
@@ -59,7 +218,14 @@ idResourceContainer::Init
 */
 bool idResourceContainer::Init( const char* _fileName )
 {
-	if( idStr::Icmp( _fileName, "_ordered.resources" ) == 0 )
+#ifdef _WIN32
+	const bool mapFile = false;
+#else
+	const bool mapFile = fs_mapResources.GetBool();
+#endif
+
+	const bool orderedStartup = ( idStr::Icmp( _fileName, "_ordered.resources" ) == 0 );
+	if( orderedStartup && !mapFile )
 	{
 		resourceFile = fileSystem->OpenFileReadMemory( _fileName );
 	}
@@ -82,6 +248,11 @@ bool idResourceContainer::Init( const char* _fileName )
 
 	fileName = _fileName;
 
+	if( mapFile )
+	{
+		MapFile( orderedStartup );
+	}
+
 	resourceFile->ReadBig( tableOffset );
 	resourceFile->ReadBig( tableLength );
 	// read this into a memory buffer with a single read
@@ -77,6 +77,57 @@ public:
 	idResourceContainer* owner;
 };
 
+/*
+================================================
+idResourceMapping
+
+A memory mapped container. The container and every file handed out from
+the mapping hold a reference, so files stay valid when the container is
+unmapped or unloaded while they are open.
+================================================
+*/
+class idResourceMapping
+{
+public:
+	idResourceMapping( const byte* data, size_t length );
+
+	void				AddRef()
+	{
+		refCount.Increment();
+	}
+	// unmaps the file and deletes the mapping once the last reference is gone
+	void				Release();
+
+	const byte* 		GetData() const
+	{
+		return data;
+	}
+
+private:
+	~idResourceMapping();
+
+	const byte* 		data;
+	size_t				length;
+	idSysInterlockedInteger	refCount;
+};
+
+/*
+================================================
+idFile_MappedResource
+
+Read only view of a resource in a memory mapped container.
+================================================
+*/
+class idFile_MappedResource : public idFile_Memory
+{
+public:
+	idFile_MappedResource( const char* name, idResourceMapping* mapping, int offset, int length );
+	virtual					~idFile_MappedResource();
+
+private:
+	idResourceMapping* 		mapping;
+};
+
 static const uint32 RESOURCE_FILE_MAGIC = 0xD000000D;
 class idResourceContainer
 {
@@ -90,9 +141,11 @@ public:
 		tableLength = 0;
 		resourceMagic = 0;
 		numFileResources = 0;
+		mapping = NULL;
 	}
 	~idResourceContainer()
 	{
+		UnmapFile();
 		delete resourceFile;
 		cacheTable.Clear();
 	}
@@ -109,11 +162,21 @@ public:
 	}
 	void ReOpen();
 
+	bool IsMapped() const
+	{
+		return mapping != NULL;
+	}
+	// returns NULL if the container isn't memory mapped
+	idFile* OpenMappedFile( const idResourceCacheEntry& rc );
+
 	int GetNumFileResources() const
 	{
 		return numFileResources;
 	}
 private:
+	void		MapFile( bool prefetch );
+	void		UnmapFile();
+
 	idStrStatic< 256 > fileName;
 	idFile* 	resourceFile;			// open file handle
 	// offset should probably be a 64 bit value for development, but 4 gigs won't fit on
@@ -124,6 +187,7 @@ private:
 	int		numFileResources;		// number of file resources in this container
 	idList< idResourceCacheEntry, TAG_RESOURCE>	cacheTable;
 	idHashIndex	cacheHash;
+	idResourceMapping* mapping;			// whole file mapped read only, resources are read straight from here
 };
 
 
@@ -536,6 +536,8 @@ void idCommonLocal::Frame()
 		// This is the only place this is incremented
 		idLib::frameNumber++;
 
+		parallelJobManager->UpdateTrace();
+
 		//OPTICK_TAG( "N", idLib::frameNumber );
 
 		// allow changing SIMD usage on the fly
@@ -37,8 +37,414 @@ If you have questions concerning this license or the applicable additional terms
 //
 //===============================================================
 #include <stdlib.h>
+#ifndef _WIN32
+	#include <sys/mman.h>
+	#include <pthread.h>
+#endif
 #undef new
 
+idCVar mem_slabAllocator( "mem_slabAllocator", "1", CVAR_BOOL | CVAR_SYSTEM | CVAR_INIT, "serve small allocations from per-thread cached slabs instead of the system allocator" );
+
+/*
+================================================================================================
+
+	Small block allocator
+
+	Small allocations are carved out of 64k pages of equally sized blocks inside a single
+	reserved address range, so Mem_Free16 can tell them apart from system allocations with
+	a range check. Every thread caches free blocks of each size class and only takes the
+	lock of a size class to move a batch of blocks between its cache and the shared list.
+
+	Nothing in here may have a constructor, allocations happen during static initialization.
+
+================================================================================================
+*/
+
+static const int SLAB_PAGE_SIZE		= 64 * 1024;
+static const int SLAB_HEADER_SIZE	= 16;
+static const int SLAB_BATCH_SIZE	= 32;		// blocks moved between a thread cache and the shared list at once
+static const int MAX_SLAB_SIZE		= 1024 - SLAB_HEADER_SIZE;
+
+static const int slabBlockSizes[] =
+{
+	32, 48, 64, 80, 96, 112, 128,
+	160, 192, 224, 256,
+	320, 384, 448, 512,
+	640, 768, 896, 1024
+};
+static const int NUM_SLAB_CLASSES = sizeof( slabBlockSizes ) / sizeof( slabBlockSizes[0] );
+
+struct memSlabBlock_t
+{
+	memSlabBlock_t* 	next;		// only valid while the block is free
+	unsigned int		size;
+	unsigned short		tag;
+	unsigned short		slabClass;
+};
+
+struct memSlabClass_t
+{
+	interlockedInt_t	lock;
+	memSlabBlock_t* 	freeBlocks;
+};
+
+struct memThreadCache_t
+{
+	memSlabBlock_t* 	freeBlocks[NUM_SLAB_CLASSES];
+	int					numFreeBlocks[NUM_SLAB_CLASSES];
+	int64				numAllocs[TAG_NUM_TAGS];
+	int64				allocatedBytes[TAG_NUM_TAGS];
+	int64				slabBytes[TAG_NUM_TAGS];	// the sum over all threads is the live size, blocks may be freed on another thread
+	memThreadCache_t* 	next;
+};
+
+static byte* 				slabMemory;
+static byte* 				slabMemoryEnd;
+static interlockedInt_t		numSlabPages;
+static int					maxSlabPages;
+static byte					slabClassForSize[( MAX_SLAB_SIZE + SLAB_HEADER_SIZE ) / 16 + 1];
+static memSlabClass_t		slabClasses[NUM_SLAB_CLASSES];
+
+static interlockedInt_t		threadCachesLock;
+static memThreadCache_t* 	threadCaches;
+static memThreadCache_t		exitedThreadStats;	// statistics of the caches freed when their thread exited
+static thread_local memThreadCache_t* threadCache;	// idSysThreadLocalStorage can't be used before its constructor ran
+
+// only used for the thread exit callback that frees the cache
+static bool					threadCacheKeyValid;
+#ifdef _WIN32
+	static DWORD			threadCacheKey;
+#else
+	static pthread_key_t	threadCacheKey;
+#endif
+
+/*
+==================
+Mem_Lock
+==================
+*/
+static void Mem_Lock( interlockedInt_t& lock )
+{
+	while( Sys_InterlockedCompareExchange( lock, 0, 1 ) != 0 )
+	{
+		Sys_Yield();
+	}
+}
+
+/*
+==================
+Mem_Unlock
+==================
+*/
+static void Mem_Unlock( interlockedInt_t& lock )
+{
+	Sys_InterlockedExchange( lock, 0 );
+}
+
+/*
+==================
+Mem_FreeThreadCache
+
+Gives the cached blocks of an exiting thread back to the shared lists and keeps its statistics.
+==================
+*/
+static void Mem_FreeThreadCache( memThreadCache_t* cache )
+{
+	for( int i = 0; i < NUM_SLAB_CLASSES; i++ )
+	{
+		memSlabBlock_t* first = cache->freeBlocks[i];
+		if( first == NULL )
+		{
+			continue;
+		}
+		memSlabBlock_t* last = first;
+		while( last->next != NULL )
+		{
+			last = last->next;
+		}
+
+		memSlabClass_t& shared = slabClasses[i];
+		Mem_Lock( shared.lock );
+		last->next = shared.freeBlocks;
+		shared.freeBlocks = first;
+		Mem_Unlock( shared.lock );
+	}
+
+	Mem_Lock( threadCachesLock );
+	for( int i = 0; i < TAG_NUM_TAGS; i++ )
+	{
+		exitedThreadStats.numAllocs[i] += cache->numAllocs[i];
+		exitedThreadStats.allocatedBytes[i] += cache->allocatedBytes[i];
+		exitedThreadStats.slabBytes[i] += cache->slabBytes[i];
+	}
+	for( memThreadCache_t** link = &threadCaches; *link != NULL; link = &( *link )->next )
+	{
+		if( *link == cache )
+		{
+			*link = cache->next;
+			break;
+		}
+	}
+	Mem_Unlock( threadCachesLock );
+
+	if( threadCache == cache )
+	{
+		threadCache = NULL;
+	}
+	free( cache );
+}
+
+/*
+==================
+Mem_ThreadExit
+==================
+*/
+#ifdef _WIN32
+	static VOID WINAPI Mem_ThreadExit( PVOID data )
+#else
+	static void Mem_ThreadExit( void* data )
+#endif
+{
+	if( data != NULL )
+	{
+		Mem_FreeThreadCache( ( memThreadCache_t* )data );
+	}
+}
+
+/*
+==================
+Mem_GetThreadCache
+==================
+*/
+static memThreadCache_t* Mem_GetThreadCache()
+{
+	if( threadCache == NULL )
+	{
+		threadCache = ( memThreadCache_t* )calloc( 1, sizeof( memThreadCache_t ) );
+		if( threadCache != NULL )
+		{
+			Mem_Lock( threadCachesLock );
+			threadCache->next = threadCaches;
+			threadCaches = threadCache;
+			if( !threadCacheKeyValid )
+			{
+#ifdef _WIN32
+				threadCacheKey = FlsAlloc( Mem_ThreadExit );
+				threadCacheKeyValid = ( threadCacheKey != FLS_OUT_OF_INDEXES );
+#else
+				threadCacheKeyValid = ( pthread_key_create( &threadCacheKey, Mem_ThreadExit ) == 0 );
+#endif
+			}
+			Mem_Unlock( threadCachesLock );
+
+			// free the cache when the thread exits
+			if( threadCacheKeyValid )
+			{
+#ifdef _WIN32
+				FlsSetValue( threadCacheKey, threadCache );
+#else
+				pthread_setspecific( threadCacheKey, threadCache );
+#endif
+			}
+		}
+	}
+	return threadCache;
+}
+
+/*
+==================
+Mem_AllocSlabPage
+
+Carves a new page into blocks, must be called with the size class locked.
+==================
+*/
+static memSlabBlock_t* Mem_AllocSlabPage( int slabClass )
+{
+	const int page = Sys_InterlockedIncrement( numSlabPages ) - 1;
+	if( page >= maxSlabPages )
+	{
+		return NULL;
+	}
+
+	byte* memory = slabMemory + ( size_t )page * SLAB_PAGE_SIZE;
+#ifdef _WIN32
+	if( VirtualAlloc( memory, SLAB_PAGE_SIZE, MEM_COMMIT, PAGE_READWRITE ) == NULL )
+	{
+		return NULL;
+	}
+#endif
+
+	const int blockSize = slabBlockSizes[slabClass];
+	const int numBlocks = SLAB_PAGE_SIZE / blockSize;
+
+	memSlabBlock_t* first = NULL;
+	for( int i = numBlocks - 1; i >= 0; i-- )
+	{
+		memSlabBlock_t* block = ( memSlabBlock_t* )( memory + i * blockSize );
+		block->slabClass = ( unsigned short )slabClass;
+		block->next = first;
+		first = block;
+	}
+	return first;
+}
+
+/*
+==================
+Mem_RefillThreadCache
+==================
+*/
+static void Mem_RefillThreadCache( memThreadCache_t* cache, int slabClass )
+{
+	memSlabClass_t& shared = slabClasses[slabClass];
+
+	Mem_Lock( shared.lock );
+	if( shared.freeBlocks == NULL )
+	{
+		shared.freeBlocks = Mem_AllocSlabPage( slabClass );
+	}
+	memSlabBlock_t* first = shared.freeBlocks;
+	memSlabBlock_t* last = first;
+	int count = 0;
+	if( first != NULL )
+	{
+		count = 1;
+		while( count < SLAB_BATCH_SIZE && last->next != NULL )
+		{
+			last = last->next;
+			count++;
+		}
+		shared.freeBlocks = last->next;
+		last->next = NULL;
+	}
+	Mem_Unlock( shared.lock );
+
+	cache->freeBlocks[slabClass] = first;
+	cache->numFreeBlocks[slabClass] = count;
+}
+
+/*
+==================
+Mem_SlabAlloc
+==================
+*/
+static void* Mem_SlabAlloc( memThreadCache_t* cache, const size_t size, const memTag_t tag )
+{
+	const int slabClass = slabClassForSize[( size + SLAB_HEADER_SIZE + 15 ) >> 4];
+
+	if( cache->freeBlocks[slabClass] == NULL )
+	{
+		Mem_RefillThreadCache( cache, slabClass );
+		if( cache->freeBlocks[slabClass] == NULL )
+		{
+			// out of address space for slabs
+			return NULL;
+		}
+	}
+
+	memSlabBlock_t* block = cache->freeBlocks[slabClass];
+	cache->freeBlocks[slabClass] = block->next;
+	cache->numFreeBlocks[slabClass]--;
+
+	block->size = ( unsigned int )size;
+	block->tag = ( unsigned short )tag;
+	cache->slabBytes[tag] += size;
+
+	return ( byte* )block + SLAB_HEADER_SIZE;
+}
+
+/*
+==================
+Mem_SlabFree
+==================
+*/
+static void Mem_SlabFree( void* ptr )
+{
+	memSlabBlock_t* block = ( memSlabBlock_t* )( ( byte* )ptr - SLAB_HEADER_SIZE );
+	const int slabClass = block->slabClass;
+	memSlabClass_t& shared = slabClasses[slabClass];
+
+	memThreadCache_t* cache = Mem_GetThreadCache();
+	if( cache == NULL )
+	{
+		Mem_Lock( shared.lock );
+		block->next = shared.freeBlocks;
+		shared.freeBlocks = block;
+		Mem_Unlock( shared.lock );
+		return;
+	}
+
+	cache->slabBytes[block->tag] -= block->size;
+
+	block->next = cache->freeBlocks[slabClass];
+	cache->freeBlocks[slabClass] = block;
+	if( ++cache->numFreeBlocks[slabClass] < SLAB_BATCH_SIZE * 2 )
+	{
+		return;
+	}
+
+	// give a batch back so blocks freed by another thread than the one that allocated them don't pile up
+	memSlabBlock_t* first = cache->freeBlocks[slabClass];
+	memSlabBlock_t* last = first;
+	for( int i = 1; i < SLAB_BATCH_SIZE; i++ )
+	{
+		last = last->next;
+	}
+	cache->freeBlocks[slabClass] = last->next;
+	cache->numFreeBlocks[slabClass] -= SLAB_BATCH_SIZE;
+
+	Mem_Lock( shared.lock );
+	last->next = shared.freeBlocks;
+	shared.freeBlocks = first;
+	Mem_Unlock( shared.lock );
+}
+
+/*
+==================
+Mem_Init
+
+Reserves the address range for the small block allocator. Allocations made before this
+keep going through the system allocator when they are freed.
+==================
+*/
+void Mem_Init()
+{
+	if( slabMemory != NULL || !mem_slabAllocator.GetBool() )
+	{
+		return;
+	}
+
+	const size_t reserveSize = ( sizeof( void* ) == 8 ) ? ( size_t )1024 * 1024 * 1024 : ( size_t )128 * 1024 * 1024;
+
+#ifdef _WIN32
+	byte* memory = ( byte* )VirtualAlloc( NULL, reserveSize, MEM_RESERVE, PAGE_NOACCESS );
+#else
+	byte* memory = ( byte* )mmap( NULL, reserveSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0 );
+	if( memory == MAP_FAILED )
+	{
+		memory = NULL;
+	}
+#endif
+	if( memory == NULL )
+	{
+		idLib::Warning( "couldn't reserve %zu MB for the small block allocator", reserveSize >> 20 );
+		return;
+	}
+
+	int slabClass = 0;
+	for( int i = 0; i < ( int )sizeof( slabClassForSize ); i++ )
+	{
+		while( slabBlockSizes[slabClass] < i * 16 )
+		{
+			slabClass++;
+		}
+		slabClassForSize[i] = ( byte )slabClass;
+	}
+
+	maxSlabPages = ( int )( reserveSize / SLAB_PAGE_SIZE );
+	slabMemoryEnd = memory + reserveSize;
+	slabMemory = memory;
+}
+
 /*
 ==================
 Mem_Alloc16
@@ -52,6 +458,26 @@ void* Mem_Alloc16( const size_t size, const memTag_t tag )
 	{
 		return NULL;
 	}
+
+	assert( tag >= 0 && tag < TAG_NUM_TAGS );
+
+	memThreadCache_t* cache = Mem_GetThreadCache();
+	if( cache != NULL )
+	{
+		cache->numAllocs[tag]++;
+		cache->allocatedBytes[tag] += size;
+
+		// untagged global new can end up freed by a runtime library that doesn't know about slabs
+		if( slabMemory != NULL && size <= MAX_SLAB_SIZE && tag != TAG_NEW )
+		{
+			void* ptr = Mem_SlabAlloc( cache, size, tag );
+			if( ptr != NULL )
+			{
+				return ptr;
+			}
+		}
+	}
+
 	const size_t paddedSize = ( size + 15 ) & ~15;
 #ifdef _WIN32
 	// this should work with MSVC and mingw, as long as __MSVCRT_VERSION__ >= 0x0700
@@ -76,6 +502,11 @@ void Mem_Free16( void* ptr )
 	{
 		return;
 	}
+	if( ( byte* )ptr >= slabMemory && ( byte* )ptr < slabMemoryEnd )
+	{
+		Mem_SlabFree( ptr );
+		return;
+	}
 #ifdef _WIN32
 	_aligned_free( ptr );
 #else // not _WIN32
@@ -110,3 +541,57 @@ char* Mem_CopyString( const char* in )
 	return out;
 }
 
+/*
+==================
+mem_tagStats
+==================
+*/
+static const char* memTagNames[] =
+{
+#define MEM_TAG( x )	#x,
+#include "sys/sys_alloc_tags.h"
+};
+
+CONSOLE_COMMAND( mem_tagStats, "lists live small block memory and allocation rates since the last call per memory tag", 0 )
+{
+	static int64	lastNumAllocs[TAG_NUM_TAGS];
+	static int64	lastAllocatedBytes[TAG_NUM_TAGS];
+	static int		lastTime;
+
+	int64 numAllocs[TAG_NUM_TAGS];
+	int64 allocatedBytes[TAG_NUM_TAGS];
+	int64 slabBytes[TAG_NUM_TAGS];
+
+	Mem_Lock( threadCachesLock );
+	memcpy( numAllocs, exitedThreadStats.numAllocs, sizeof( numAllocs ) );
+	memcpy( allocatedBytes, exitedThreadStats.allocatedBytes, sizeof( allocatedBytes ) );
+	memcpy( slabBytes, exitedThreadStats.slabBytes, sizeof( slabBytes ) );
+	for( memThreadCache_t* cache = threadCaches; cache != NULL; cache = cache->next )
+	{
+		for( int i = 0; i < TAG_NUM_TAGS; i++ )
+		{
+			numAllocs[i] += cache->numAllocs[i];
+			allocatedBytes[i] += cache->allocatedBytes[i];
+			slabBytes[i] += cache->slabBytes[i];
+		}
+	}
+	Mem_Unlock( threadCachesLock );
+
+	const int time = Sys_Milliseconds();
+	const float seconds = Max( time - lastTime, 1 ) * 0.001f;
+	lastTime = time;
+
+	idLib::Printf( "%-24s %10s %12s %12s %14s\n", "tag", "small KB", "allocs/sec", "KB/sec", "total allocs" );
+	for( int i = 0; i < TAG_NUM_TAGS; i++ )
+	{
+		if( numAllocs[i] == 0 )
+		{
+			continue;
+		}
+		idLib::Printf( "%-24s %10lld %12.0f %12.1f %14lld\n", memTagNames[i], ( long long )( slabBytes[i] >> 10 ),
+					   ( numAllocs[i] - lastNumAllocs[i] ) / seconds, ( ( allocatedBytes[i] - lastAllocatedBytes[i] ) >> 10 ) / seconds, ( long long )numAllocs[i] );
+		lastNumAllocs[i] = numAllocs[i];
+		lastAllocatedBytes[i] = allocatedBytes[i];
+	}
+	idLib::Printf( "%d of %d small block pages used\n", Min( ( int )numSlabPages, maxSlabPages ), maxSlabPages );
+}
@@ -49,6 +49,8 @@ static const int MAX_TAGS = 256;
 
 
 
+void		Mem_Init();
+
 // RB: 64 bit fixes, changed int to size_t
 void* 		Mem_Alloc16( const size_t size, const memTag_t tag );
 void		Mem_Free16( void* ptr );
@@ -91,6 +93,17 @@ ID_INLINE void operator delete[]( void* p ) noexcept
 {
 	Mem_Free( p );
 }
+
+// the compiler calls the sized versions for complete types, they must not end up in the C runtime
+ID_INLINE void operator delete( void* p, size_t s ) noexcept
+{
+	Mem_Free( p );
+}
+
+ID_INLINE void operator delete[]( void* p, size_t s ) noexcept
+{
+	Mem_Free( p );
+}
 #ifdef _MSC_VER
 	#pragma warning( pop )
 #endif
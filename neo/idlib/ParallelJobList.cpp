@@ -145,6 +145,129 @@ static idCVar jobs_longJobMicroSec( "jobs_longJobMicroSec", "10000", CVAR_INTEGE
 
 const static int		MAX_THREADS	= 32;
 
+/*
+================================================================================================
+
+	Job tracing
+
+================================================================================================
+*/
+
+static ID_TLS jobThreadNum;	// thread number + 1 on job threads, 0 on any other thread
+
+enum jobTraceEventType_t
+{
+	TRACE_JOB,
+	TRACE_WAIT,
+	TRACE_FRAME
+};
+
+struct jobTraceEvent_t
+{
+	jobRun_t		function;		// NULL for waits and frames
+	uint64			startTime;
+	uint64			endTime;
+	uintptr_t		threadId;
+	int				frameNumber;
+	short			listId;
+	short			type;
+};
+
+static const int MAX_TRACE_EVENTS = 1 << 18;	// must be a power of two
+
+static jobTraceEvent_t* 		traceEvents;
+static idSysInterlockedInteger	traceNextEvent;
+static volatile int				traceFramesLeft;
+static char						traceFileName[MAX_OSPATH];
+
+/*
+========================
+JobTraceActive
+========================
+*/
+static ID_INLINE bool JobTraceActive()
+{
+	return traceFramesLeft > 0;
+}
+
+/*
+========================
+JobTraceEvent
+
+Events are written to a ring buffer without any locking, when more events are recorded
+than fit in the buffer the oldest events are overwritten.
+========================
+*/
+static void JobTraceEvent( jobTraceEventType_t type, jobRun_t function, jobListId_t listId, uint64 startTime, uint64 endTime )
+{
+	const int index = traceNextEvent.Increment() - 1;
+	jobTraceEvent_t& event = traceEvents[index & ( MAX_TRACE_EVENTS - 1 )];
+	event.function = function;
+	event.startTime = startTime;
+	event.endTime = endTime;
+	event.threadId = ( jobThreadNum != 0 ) ? ( uintptr_t )jobThreadNum : Sys_GetCurrentThreadID();
+	event.frameNumber = idLib::frameNumber;
+	event.listId = ( short )listId;
+	event.type = ( short )type;
+}
+
+/*
+========================
+WriteJobTrace
+
+Writes the recorded events in the Chrome trace event format which can be loaded
+in chrome://tracing or the Perfetto UI.
+========================
+*/
+static void WriteJobTrace()
+{
+	idFile* file = idLib::fileSystem->OpenFileWrite( traceFileName );
+	if( file == NULL )
+	{
+		idLib::Warning( "couldn't open %s for writing", traceFileName );
+		return;
+	}
+
+	const int numRecorded = traceNextEvent.GetValue();
+	const int numEvents = Min( numRecorded, MAX_TRACE_EVENTS );
+	const uint64 baseTime = ( numEvents > 0 ) ? traceEvents[( numRecorded - numEvents ) & ( MAX_TRACE_EVENTS - 1 )].startTime : 0;
+
+	file->Printf( "{\"traceEvents\":[\n" );
+	for( int i = 0; i < MAX_THREADS; i++ )
+	{
+		const char* separator = ( i < MAX_THREADS - 1 || numEvents > 0 ) ? "," : "";
+		file->Printf( "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"job thread %d\"}}%s\n", i + 1, i, separator );
+	}
+	for( int i = numRecorded - numEvents; i < numRecorded; i++ )
+	{
+		const jobTraceEvent_t& event = traceEvents[i & ( MAX_TRACE_EVENTS - 1 )];
+		const double start = ( double )( int64 )( event.startTime - baseTime );
+		const double duration = ( double )( event.endTime - event.startTime );
+		const char* separator = ( i < numRecorded - 1 ) ? "," : "";
+
+		switch( event.type )
+		{
+			case TRACE_JOB:
+				file->Printf( "{\"name\":\"%s\",\"cat\":\"job\",\"ph\":\"X\",\"pid\":1,\"tid\":%llu,\"ts\":%.0f,\"dur\":%.0f,\"args\":{\"list\":\"%s\",\"frame\":%d}}%s\n",
+							  GetJobName( event.function ), ( unsigned long long )event.threadId, start, duration, GetJobListName( ( jobListId_t )event.listId ), event.frameNumber, separator );
+				break;
+			case TRACE_WAIT:
+				file->Printf( "{\"name\":\"wait %s\",\"cat\":\"wait\",\"ph\":\"X\",\"pid\":1,\"tid\":%llu,\"ts\":%.0f,\"dur\":%.0f}%s\n",
+							  GetJobListName( ( jobListId_t )event.listId ), ( unsigned long long )event.threadId, start, duration, separator );
+				break;
+			case TRACE_FRAME:
+				file->Printf( "{\"name\":\"frame %d\",\"cat\":\"frame\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":%llu,\"ts\":%.0f}%s\n",
+							  event.frameNumber, ( unsigned long long )event.threadId, start, separator );
+				break;
+		}
+	}
+	file->Printf( "]}\n" );
+
+	idLib::Printf( "wrote %d job trace events (%d dropped) to %s\n", numEvents, numRecorded - numEvents, file->GetFullPath() );
+
+	idLib::fileSystem->CloseFile( file );
+}
+
 struct threadJobListState_t
 {
 	threadJobListState_t() :
@@ -178,6 +301,34 @@ struct threadStats_t
 	uint64			threadTotalTime[MAX_THREADS];
 };
 
+// a range of jobs between two synchronization points that can be run in any order,
+// or a single job spawned from inside a running job
+struct jobRange_t
+{
+	idParallelJobList_Threads* 	jobList;
+	int							version;
+	int							priority;
+	int							firstJob;
+	int							lastJob;
+	jobRun_t					function;		// only set for spawned jobs
+	void* 						data;
+	idParallelJobCounter* 		counter;
+};
+
+struct stealSegment_t
+{
+	int							firstJob;		// index into the steal jobs, not the job list
+	int							lastJob;
+	bool						releaseNext;	// the signal this segment ends with has no jobs
+};
+
+// the work stealing and fork/join entry points of the job manager
+static void SubmitJobRange( const jobRange_t& range, int threadNum );
+static void FinishStealJobList( idParallelJobList_Threads* jobList );
+static bool RunStealJobs( unsigned int threadNum );
+static void SpawnJob( const jobRange_t& job );
+static void JoinJobs( idParallelJobCounter& counter );
+
 class idParallelJobList_Threads
 {
 public:
@@ -190,6 +341,7 @@ public:
 	ID_INLINE void			AddJob( jobRun_t function, void* data );
 	ID_INLINE void			InsertSyncPoint( jobSyncType_t syncType );
 	void					Submit( idParallelJobList_Threads* waitForJobList_, int parallelism );
+	void					Spawn( jobRun_t function, void* data, idParallelJobCounter& counter );
 	void					Wait();
 	bool					TryWait();
 	bool					IsSubmitted() const;
@@ -238,6 +390,16 @@ public:
 
 	bool					WaitForOtherJobList();
 
+	//------------------------
+	// Work stealing mode, called by the job manager when the list is submitted.
+	//------------------------
+	void					PrepareStealing( int numThreads );
+	void					StartStealing( int threadNum );
+	int						GetNumStealThreads() const
+	{
+		return stealThreads;
+	}
+
 	//------------------------
 	// This is thread safe and called from the job threads.
 	//------------------------
@@ -250,6 +412,8 @@ public:
 	};
 
 	int						RunJobs( unsigned int threadNum, threadJobListState_t& state, bool singleJob );
+	void					RunJobRange( unsigned int threadNum, const jobRange_t& range );
+	void					RunSpawnedJob( unsigned int threadNum, const jobRange_t& job );
 
 private:
 	static const int		NUM_DONE_GUARDS = 4;	// cycle through 4 guards so we can cyclicly chain job lists
@@ -257,6 +421,8 @@ private:
 	bool					threaded;
 	bool					done;
 	bool					hasSignal;
+	bool					stealing;
+	int						stealThreads;
 	jobListId_t				listId;
 	jobListPriority_t		listPriority;
 	unsigned int			maxJobs;
@@ -272,6 +438,7 @@ private:
 		jobRun_t	function;
 		void* 		data;
 		int			executed;
+		int			signalIndex;	// only used in work stealing mode
 	};
 	idList< job_t, TAG_JOBLIST >		jobList;
 	idList< idSysInterlockedInteger, TAG_JOBLIST >	signalJobCount;
@@ -279,10 +446,30 @@ private:
 	idSysInterlockedInteger				fetchLock;
 	idSysInterlockedInteger				numThreadsExecuting;
 
+	idList< int, TAG_JOBLIST >			stealJobs;			// indices of the real jobs without the sync points
+	idList< stealSegment_t, TAG_JOBLIST >	stealSegments;		// ranges of steal jobs separated by SYNC_SYNCHRONIZE
+	idList< int, TAG_JOBLIST >			signalSegment;		// segment released when a signal count reaches zero
+	idSysInterlockedInteger				pendingJobs;		// jobs not yet executed in work stealing mode
+	idSysInterlockedInteger				spawnedJobs;		// spawned jobs not yet executed
+
 	threadStats_t						deferredThreadStats;
 	threadStats_t						threadStats;
 
 	int						RunJobsInternal( unsigned int threadNum, threadJobListState_t& state, bool singleJob );
+	ID_INLINE void			ExecuteJob( unsigned int threadNum, int jobIndex );
+	void					ReleaseSegment( int segment, int threadNum );
+	bool					JobsPending()
+	{
+		if( spawnedJobs.GetValue() > 0 )
+		{
+			return true;
+		}
+		if( stealing )
+		{
+			return ( pendingJobs.GetValue() > 0 );
+		}
+		return ( signalJobCount[signalJobCount.Num() - 1].GetValue() > 0 );
+	}
 
 	static void				Nop( void* data ) {}
 
@@ -304,6 +491,8 @@ idParallelJobList_Threads::idParallelJobList_Threads( jobListId_t id, jobListPri
 	threaded( true ),
 	done( true ),
 	hasSignal( false ),
+	stealing( false ),
+	stealThreads( 0 ),
 	listId( id ),
 	listPriority( priority ),
 	numSyncs( 0 ),
@@ -321,6 +510,12 @@ idParallelJobList_Threads::idParallelJobList_Threads( jobListId_t id, jobListPri
 	jobList.SetNum( 0 );
 	signalJobCount.AssureSize( maxSyncs + 1 );			// need one extra for submit
 	signalJobCount.SetNum( 0 );
+	stealJobs.AssureSize( maxJobs );
+	stealJobs.SetNum( 0 );
+	stealSegments.AssureSize( maxSyncs + 1 );
+	stealSegments.SetNum( 0 );
+	signalSegment.AssureSize( maxSyncs + 1 );
+	signalSegment.SetNum( 0 );
 
 	memset( &deferredThreadStats, 0, sizeof( threadStats_t ) );
 	memset( &threadStats, 0, sizeof( threadStats_t ) );
@@ -445,6 +640,7 @@ void idParallelJobList_Threads::Submit( idParallelJobList_Threads* waitForJobLis
 	assert( fetchLock.GetValue() == 0 );
 
 	done = false;
+	stealing = false;
 	currentJob.SetValue( 0 );
 
 	memset( &deferredThreadStats, 0, sizeof( deferredThreadStats ) );
@@ -511,7 +707,7 @@ void idParallelJobList_Threads::Wait()
 		bool waited = false;
 		uint64 waitStart = Sys_Microseconds();
 
-		while( signalJobCount[signalJobCount.Num() - 1].GetValue() > 0 )
+		while( JobsPending() )
 		{
 			Sys_Yield();
 			waited = true;
@@ -530,6 +726,11 @@ void idParallelJobList_Threads::Wait()
 
 		uint64 waitEnd = Sys_Microseconds();
 		deferredThreadStats.waitTime = waited ? ( waitEnd - waitStart ) : 0;
+
+		if( waited && JobTraceActive() )
+		{
+			JobTraceEvent( TRACE_WAIT, NULL, GetId(), waitStart, waitEnd );
+		}
 	}
 	memcpy( & threadStats, & deferredThreadStats, sizeof( threadStats ) );
 	done = true;
@@ -542,7 +743,7 @@ idParallelJobList_Threads::TryWait
 */
 bool idParallelJobList_Threads::TryWait()
 {
-	if( jobList.Num() == 0 || signalJobCount[signalJobCount.Num() - 1].GetValue() <= 0 )
+	if( jobList.Num() == 0 || !JobsPending() )
 	{
 		Wait();
 		return true;
@@ -624,6 +825,43 @@ uint64 idParallelJobList_Threads::GetUnitWastedTimeMicroSec( int unit ) const
 	volatile void* longJobData;
 #endif
 
+/*
+========================
+idParallelJobList_Threads::ExecuteJob
+========================
+*/
+ID_INLINE void idParallelJobList_Threads::ExecuteJob( unsigned int threadNum, int jobIndex )
+{
+	uint64 jobStart = Sys_Microseconds();
+
+	jobList[jobIndex].function( jobList[jobIndex].data );
+	jobList[jobIndex].executed = 1;
+
+	uint64 jobEnd = Sys_Microseconds();
+	deferredThreadStats.threadExecTime[threadNum] += jobEnd - jobStart;
+
+	if( JobTraceActive() )
+	{
+		JobTraceEvent( TRACE_JOB, jobList[jobIndex].function, GetId(), jobStart, jobEnd );
+	}
+
+#ifndef _DEBUG
+	if( jobs_longJobMicroSec.GetInteger() > 0 )
+	{
+		if( jobEnd - jobStart > jobs_longJobMicroSec.GetInteger()
+				&& GetId() != JOBLIST_UTILITY )
+		{
+			longJobTime = ( jobEnd - jobStart ) * ( 1.0f / 1000.0f );
+			longJobFunc = jobList[jobIndex].function;
+			longJobData = jobList[jobIndex].data;
+			const char* jobName = GetJobName( jobList[jobIndex].function );
+			const char* jobListName = GetJobListName( GetId() );
+			idLib::Printf( "%1.1f milliseconds for a single '%s' job from job list %s on thread %d\n", longJobTime, jobName, jobListName, threadNum );
+		}
+	}
+#endif
+}
+
 /*
 ========================
 idParallelJobList_Threads::RunJobsInternal
@@ -738,31 +976,7 @@ int idParallelJobList_Threads::RunJobsInternal( unsigned int threadNum, threadJo
 		}
 
 		// execute the next job
-		{
-			uint64 jobStart = Sys_Microseconds();
-
-			jobList[state.nextJobIndex].function( jobList[state.nextJobIndex].data );
-			jobList[state.nextJobIndex].executed = 1;
-
-			uint64 jobEnd = Sys_Microseconds();
-			deferredThreadStats.threadExecTime[threadNum] += jobEnd - jobStart;
-
-#ifndef _DEBUG
-			if( jobs_longJobMicroSec.GetInteger() > 0 )
-			{
-				if( jobEnd - jobStart > jobs_longJobMicroSec.GetInteger()
-						&& GetId() != JOBLIST_UTILITY )
-				{
-					longJobTime = ( jobEnd - jobStart ) * ( 1.0f / 1000.0f );
-					longJobFunc = jobList[state.nextJobIndex].function;
-					longJobData = jobList[state.nextJobIndex].data;
-					const char* jobName = GetJobName( jobList[state.nextJobIndex].function );
-					const char* jobListName = GetJobListName( GetId() );
-					idLib::Printf( "%1.1f milliseconds for a single '%s' job from job list %s on thread %d\n", longJobTime, jobName, jobListName, threadNum );
-				}
-			}
-#endif
-		}
+		ExecuteJob( threadNum, state.nextJobIndex );
 
 		result |= RUN_PROGRESS;
 
@@ -820,6 +1034,235 @@ bool idParallelJobList_Threads::WaitForOtherJobList()
 	return false;
 }
 
+/*
+========================
+idParallelJobList_Threads::PrepareStealing
+
+Splits the job list into segments at every synchronization point and counts the
+real jobs per signal. Sync points don't show up as jobs in work stealing mode,
+instead a segment is released when the signal it waits on drops to zero. A signal
+without jobs never counts down, the segment waiting on it is released together
+with the segment the signal is in.
+========================
+*/
+void idParallelJobList_Threads::PrepareStealing( int numThreads )
+{
+	stealing = true;
+	stealThreads = numThreads;
+
+	stealJobs.SetNum( 0 );
+	stealSegments.SetNum( 0 );
+	signalSegment.SetNum( signalJobCount.Num() );
+	for( int i = 0; i < signalJobCount.Num(); i++ )
+	{
+		signalJobCount[i].SetValue( 0 );
+		signalSegment[i] = -1;
+	}
+
+	int signalIndex = 0;
+	stealSegment_t* segment = &stealSegments.Alloc();
+	segment->firstJob = 0;
+	segment->releaseNext = false;
+
+	for( int i = 0; i < jobList.Num(); i++ )
+	{
+		job_t& job = jobList[i];
+		if( job.data == & JOB_SIGNAL )
+		{
+			signalIndex++;
+		}
+		else if( job.data == & JOB_SYNCHRONIZE )
+		{
+			assert( signalIndex > 0 );
+			segment->lastJob = stealJobs.Num();
+			signalSegment[signalIndex - 1] = stealSegments.Num();
+			segment = &stealSegments.Alloc();
+			segment->firstJob = stealJobs.Num();
+			segment->releaseNext = false;
+		}
+		else if( job.data != & JOB_LIST_DONE )
+		{
+			job.signalIndex = signalIndex;
+			signalJobCount[signalIndex].Increment();
+			stealJobs.Append( i );
+		}
+	}
+	segment->lastJob = stealJobs.Num();
+
+	for( int i = 0; i < signalJobCount.Num(); i++ )
+	{
+		if( signalJobCount[i].GetValue() == 0 && signalSegment[i] > 0 )
+		{
+			stealSegments[signalSegment[i] - 1].releaseNext = true;
+		}
+	}
+
+	pendingJobs.SetValue( stealJobs.Num() );
+}
+
+/*
+========================
+idParallelJobList_Threads::StartStealing
+
+Called once the job list no longer waits for another job list.
+========================
+*/
+void idParallelJobList_Threads::StartStealing( int threadNum )
+{
+	if( deferredThreadStats.startTime == 0 )
+	{
+		deferredThreadStats.startTime = Sys_Microseconds();
+	}
+
+	if( pendingJobs.GetValue() == 0 )
+	{
+		deferredThreadStats.endTime = Sys_Microseconds();
+		doneGuards[currentDoneGuard].Decrement();
+		FinishStealJobList( this );
+		return;
+	}
+
+	ReleaseSegment( 0, threadNum );
+}
+
+/*
+========================
+idParallelJobList_Threads::ReleaseSegment
+========================
+*/
+void idParallelJobList_Threads::ReleaseSegment( int segment, int threadNum )
+{
+	// the list may be done and submitted again once the jobs of a segment are submitted,
+	// ranges of an old version are skipped when they run
+	const int listVersion = version.GetValue();
+	for( ;; segment++ )
+	{
+		const stealSegment_t s = stealSegments[segment];
+		if( s.firstJob < s.lastJob )
+		{
+			jobRange_t range;
+			range.jobList = this;
+			range.version = listVersion;
+			range.priority = listPriority;
+			range.firstJob = s.firstJob;
+			range.lastJob = s.lastJob;
+			range.function = NULL;
+			range.data = NULL;
+			range.counter = NULL;
+
+			SubmitJobRange( range, threadNum );
+		}
+
+		// the next segment waits on a signal without jobs, so it's released with this one
+		if( !s.releaseNext )
+		{
+			break;
+		}
+	}
+}
+
+/*
+========================
+idParallelJobList_Threads::RunJobRange
+
+Runs all jobs in the range. The job manager already split the range so this
+usually is a single job.
+========================
+*/
+void idParallelJobList_Threads::RunJobRange( unsigned int threadNum, const jobRange_t& range )
+{
+	assert( threadNum < MAX_THREADS );
+
+	uint64 start = Sys_Microseconds();
+
+	numThreadsExecuting.Increment();
+
+	if( range.version != version.GetValue() )
+	{
+		// trying to run an old version of this list that is already done
+		numThreadsExecuting.Decrement();
+		return;
+	}
+
+	for( int i = range.firstJob; i < range.lastJob; i++ )
+	{
+		const int jobIndex = stealJobs[i];
+
+		ExecuteJob( threadNum, jobIndex );
+
+		const int signalIndex = jobList[jobIndex].signalIndex;
+		if( signalJobCount[signalIndex].Decrement() == 0 && signalSegment[signalIndex] >= 0 )
+		{
+			ReleaseSegment( signalSegment[signalIndex], threadNum );
+		}
+
+		if( pendingJobs.Decrement() == 0 )
+		{
+			// this was the very last job of the job list
+			deferredThreadStats.endTime = Sys_Microseconds();
+			doneGuards[currentDoneGuard].Decrement();
+			FinishStealJobList( this );
+		}
+	}
+
+	numThreadsExecuting.Decrement();
+
+	deferredThreadStats.threadTotalTime[threadNum] += Sys_Microseconds() - start;
+}
+
+/*
+========================
+idParallelJobList_Threads::Spawn
+========================
+*/
+void idParallelJobList_Threads::Spawn( jobRun_t function, void* data, idParallelJobCounter& counter )
+{
+	Sys_InterlockedIncrement( counter.pending );
+	spawnedJobs.Increment();
+
+	jobRange_t job;
+	job.jobList = this;
+	job.version = version.GetValue();
+	job.priority = listPriority;
+	job.firstJob = 0;
+	job.lastJob = 0;
+	job.function = function;
+	job.data = data;
+	job.counter = &counter;
+
+	SpawnJob( job );
+}
+
+/*
+========================
+idParallelJobList_Threads::RunSpawnedJob
+========================
+*/
+void idParallelJobList_Threads::RunSpawnedJob( unsigned int threadNum, const jobRange_t& job )
+{
+	assert( threadNum < MAX_THREADS );
+
+	numThreadsExecuting.Increment();
+
+	uint64 jobStart = Sys_Microseconds();
+
+	job.function( job.data );
+
+	uint64 jobEnd = Sys_Microseconds();
+	deferredThreadStats.threadExecTime[threadNum] += jobEnd - jobStart;
+	deferredThreadStats.threadTotalTime[threadNum] += jobEnd - jobStart;
+
+	if( JobTraceActive() )
+	{
+		JobTraceEvent( TRACE_JOB, job.function, GetId(), jobStart, jobEnd );
+	}
+
+	Sys_InterlockedDecrement( job.counter->pending );
+	spawnedJobs.Decrement();
+
+	numThreadsExecuting.Decrement();
+}
+
 /*
 ================================================================================================
 
@@ -909,6 +1352,27 @@ bool idParallelJobList::TryWait()
 	return done;
 }
 
+/*
+========================
+idParallelJobList::Spawn
+========================
+*/
+void idParallelJobList::Spawn( jobRun_t function, void* data, idParallelJobCounter& counter )
+{
+	assert( IsRegisteredJob( function ) );
+	jobListThreads->Spawn( function, data, counter );
+}
+
+/*
+========================
+idParallelJobList::Join
+========================
+*/
+void idParallelJobList::Join( idParallelJobCounter& counter )
+{
+	JoinJobs( counter );
+}
+
 /*
 ========================
 idParallelJobList::Submit
@@ -1057,26 +1521,138 @@ struct threadJobList_t
 };
 
 static idCVar jobs_prioritize( "jobs_prioritize", "1", CVAR_BOOL | CVAR_NOCHEAT, "prioritize job lists" );
+static idCVar jobs_workStealing( "jobs_workStealing", "0", CVAR_BOOL | CVAR_NOCHEAT, "run job lists from per-thread work stealing deques instead of fetching jobs from the shared list" );
 
-class idJobThread : public idSysThread
+const int NUM_STEAL_PRIORITIES		= JOBLIST_PRIORITY_HIGH + 1;
+
+/*
+================================================
+idJobStealDeque
+
+Fixed size Chase-Lev deque. Only the owning job thread pushes and pops
+at the bottom while any other thread may steal from the top. Ranges are
+split in half before a job is run, so the oldest entry that gets stolen
+holds about half of the remaining work of the victim.
+================================================
+*/
+class idJobStealDeque
 {
 public:
-	idJobThread();
-	~idJobThread();
-
-	void						Start( core_t core, unsigned int threadNum );
-
-	void						AddJobList( idParallelJobList_Threads* jobList );
+	idJobStealDeque() :
+		top( 0 ),
+		bottom( 0 ) {}
+
+	bool						Push( const jobRange_t& range );
+	bool						Pop( jobRange_t& range );
+	bool						Steal( jobRange_t& range );
+	bool						IsEmpty() const
+	{
+		return ( bottom - top ) <= 0;
+	}
 
 private:
-	threadJobList_t				jobLists[MAX_JOBLISTS];	// cyclic buffer with job lists
-	unsigned int				firstJobList;			// index of the last job list the thread grabbed
-	unsigned int				lastJobList;			// index where the next job list to work on will be added
-	idSysMutex					addJobMutex;
+	static const int			MAX_RANGES = 256;	// must be a power of two
 
-	unsigned int				threadNum;
+	volatile interlockedInt_t	top;
+	volatile interlockedInt_t	bottom;
+	jobRange_t					ranges[MAX_RANGES];
+};
+
+/*
+========================
+idJobStealDeque::Push
+========================
+*/
+bool idJobStealDeque::Push( const jobRange_t& range )
+{
+	const interlockedInt_t b = bottom;
+	const interlockedInt_t t = top;
+	if( b - t >= MAX_RANGES )
+	{
+		return false;
+	}
+	ranges[b & ( MAX_RANGES - 1 )] = range;
+	SYS_MEMORYBARRIER;
+	bottom = b + 1;
+	return true;
+}
+
+/*
+========================
+idJobStealDeque::Pop
+========================
+*/
+bool idJobStealDeque::Pop( jobRange_t& range )
+{
+	const interlockedInt_t b = bottom - 1;
+	bottom = b;
+	SYS_MEMORYBARRIER;
+	const interlockedInt_t t = top;
+	if( t > b )
+	{
+		bottom = b + 1;
+		return false;
+	}
+	range = ranges[b & ( MAX_RANGES - 1 )];
+	if( t != b )
+	{
+		return true;
+	}
+	// last range, race against the thieves for it
+	const bool taken = ( Sys_InterlockedCompareExchange( ( interlockedInt_t& ) top, t, t + 1 ) == t );
+	bottom = b + 1;
+	return taken;
+}
+
+/*
+========================
+idJobStealDeque::Steal
+========================
+*/
+bool idJobStealDeque::Steal( jobRange_t& range )
+{
+	const interlockedInt_t t = top;
+	SYS_MEMORYBARRIER;
+	const interlockedInt_t b = bottom;
+	if( t >= b )
+	{
+		return false;
+	}
+	range = ranges[t & ( MAX_RANGES - 1 )];
+	return ( Sys_InterlockedCompareExchange( ( interlockedInt_t& ) top, t, t + 1 ) == t );
+}
+
+class idJobThread : public idSysThread
+{
+public:
+	idJobThread();
+	~idJobThread();
+
+	void						Start( core_t core, unsigned int threadNum );
+
+	void						AddJobList( idParallelJobList_Threads* jobList );
+	bool						HasNewJobLists() const
+	{
+		return ( firstJobList < lastJobList );
+	}
+
+	idJobStealDeque& 			GetStealDeque( int priority )
+	{
+		return stealDeques[priority];
+	}
+
+private:
+	threadJobList_t				jobLists[MAX_JOBLISTS];	// cyclic buffer with job lists
+	unsigned int				firstJobList;			// index of the last job list the thread grabbed
+	unsigned int				lastJobList;			// index where the next job list to work on will be added
+	idSysMutex					addJobMutex;
+
+	idJobStealDeque				stealDeques[NUM_STEAL_PRIORITIES];
+
+	unsigned int				threadNum;
 
 	virtual int					Run();
+	void						RunJobLists();
 };
 
 /*
@@ -1144,6 +1720,28 @@ idJobThread::Run
 ========================
 */
 int idJobThread::Run()
+{
+	jobThreadNum = threadNum + 1;
+
+	while( !IsTerminating() )
+	{
+		RunJobLists();
+
+		// returns true when new job lists were added while stealing jobs
+		if( !RunStealJobs( threadNum ) )
+		{
+			break;
+		}
+	}
+	return 0;
+}
+
+/*
+========================
+idJobThread::RunJobLists
+========================
+*/
+void idJobThread::RunJobLists()
 {
 	threadJobListState_t threadJobListState[MAX_JOBLISTS];
 	int numJobLists = 0;
@@ -1231,7 +1829,6 @@ int idJobThread::Run()
 			lastStalledJobList = -1;
 		}
 	}
-	return 0;
 }
 
 /*
@@ -1303,15 +1900,50 @@ public:
 
 	virtual void				WaitForAllJobLists();
 
+	virtual void				UpdateTrace();
+
 	void						Submit( idParallelJobList_Threads* jobList, int parallelism );
 
+	// work stealing
+	void						SubmitRange( const jobRange_t& range, int threadNum );
+	void						FinishStealJobList( idParallelJobList_Threads* jobList );
+	bool						RunStealJobs( unsigned int threadNum );
+
+	// fork/join
+	void						SpawnJob( const jobRange_t& job );
+	void						JoinJobs( idParallelJobCounter& counter );
+
 private:
+	static const int				MAX_INJECTED_RANGES = 256;	// must be a power of two
+
 	idJobThread						threads[MAX_JOB_THREADS];
 	unsigned int					maxThreads;
 	int								numPhysicalCpuCores;
 	int								numLogicalCpuCores;
 	int								numCpuPackages;
 	idStaticList< idParallelJobList*, MAX_JOBLISTS >	jobLists;
+
+	// ranges submitted from threads that don't own a steal deque
+	jobRange_t						injectedRanges[NUM_STEAL_PRIORITIES][MAX_INJECTED_RANGES];
+	unsigned int					firstInjectedRange[NUM_STEAL_PRIORITIES];
+	unsigned int					lastInjectedRange[NUM_STEAL_PRIORITIES];
+	idSysInterlockedInteger			numInjectedRanges;
+	idSysMutex						injectMutex;
+
+	// work stealing job lists that still wait for another job list
+	idStaticList< idParallelJobList_Threads*, MAX_JOBLISTS >	waitingStealLists;
+	idSysInterlockedInteger			numWaitingStealLists;
+	idSysMutex						waitingMutex;
+
+	idSysInterlockedInteger			numActiveStealLists;
+	idSysInterlockedInteger			numSpawnedJobs;
+
+	void						InjectRange( const jobRange_t& range );
+	bool						TryInjectRange( const jobRange_t& range );
+	bool						GetInjectedRange( int priority, jobRange_t& range );
+	bool						GetJobRange( int threadNum, jobRange_t& range );
+	void						RunJobRange( int threadNum, jobRange_t& range );
+	void						StartWaitingJobLists( unsigned int threadNum );
 };
 
 idParallelJobManagerLocal parallelJobManagerLocal;
@@ -1327,6 +1959,56 @@ void SubmitJobList( idParallelJobList_Threads* jobList, int parallelism )
 	parallelJobManagerLocal.Submit( jobList, parallelism );
 }
 
+/*
+========================
+SubmitJobRange
+========================
+*/
+static void SubmitJobRange( const jobRange_t& range, int threadNum )
+{
+	parallelJobManagerLocal.SubmitRange( range, threadNum );
+}
+
+/*
+========================
+FinishStealJobList
+========================
+*/
+static void FinishStealJobList( idParallelJobList_Threads* jobList )
+{
+	parallelJobManagerLocal.FinishStealJobList( jobList );
+}
+
+/*
+========================
+RunStealJobs
+========================
+*/
+static bool RunStealJobs( unsigned int threadNum )
+{
+	return parallelJobManagerLocal.RunStealJobs( threadNum );
+}
+
+/*
+========================
+SpawnJob
+========================
+*/
+static void SpawnJob( const jobRange_t& job )
+{
+	parallelJobManagerLocal.SpawnJob( job );
+}
+
+/*
+========================
+JoinJobs
+========================
+*/
+static void JoinJobs( idParallelJobCounter& counter )
+{
+	parallelJobManagerLocal.JoinJobs( counter );
+}
+
 /*
 ========================
 idParallelJobManagerLocal::Init
@@ -1338,6 +2020,12 @@ void idParallelJobManagerLocal::Init()
 	core_t cores[] = JOB_THREAD_CORES;
 	assert( sizeof( cores ) / sizeof( cores[0] ) >= MAX_JOB_THREADS );
 
+	for( int i = 0; i < NUM_STEAL_PRIORITIES; i++ )
+	{
+		firstInjectedRange[i] = 0;
+		lastInjectedRange[i] = 0;
+	}
+
 	for( int i = 0; i < MAX_JOB_THREADS; i++ )
 	{
 		threads[i].Start( cores[i], i );
@@ -1358,6 +2046,10 @@ void idParallelJobManagerLocal::Shutdown()
 	{
 		threads[i].StopThread();
 	}
+
+	traceFramesLeft = 0;
+	Mem_Free( traceEvents );
+	traceEvents = NULL;
 }
 
 /*
@@ -1456,6 +2148,48 @@ void idParallelJobManagerLocal::WaitForAllJobLists()
 	}
 }
 
+/*
+========================
+idParallelJobManagerLocal::UpdateTrace
+========================
+*/
+void idParallelJobManagerLocal::UpdateTrace()
+{
+	if( !JobTraceActive() )
+	{
+		return;
+	}
+
+	const uint64 time = Sys_Microseconds();
+	JobTraceEvent( TRACE_FRAME, NULL, JOBLIST_UTILITY, time, time );
+
+	if( --traceFramesLeft == 0 )
+	{
+		WriteJobTrace();
+	}
+}
+
+CONSOLE_COMMAND( jobs_trace, "records all jobs and job list waits for a number of frames and writes them as a Chrome trace, usage: jobs_trace [numFrames] [fileName]", 0 )
+{
+	if( JobTraceActive() )
+	{
+		idLib::Printf( "already recording a job trace\n" );
+		return;
+	}
+
+	const int numFrames = ( args.Argc() > 1 ) ? Max( 1, atoi( args.Argv( 1 ) ) ) : 10;
+	idStr::Copynz( traceFileName, ( args.Argc() > 2 ) ? args.Argv( 2 ) : "jobs_trace.json", sizeof( traceFileName ) );
+
+	if( traceEvents == NULL )
+	{
+		traceEvents = ( jobTraceEvent_t* )Mem_Alloc( MAX_TRACE_EVENTS * sizeof( jobTraceEvent_t ), TAG_JOBLIST );
+	}
+	traceNextEvent.SetValue( 0 );
+	traceFramesLeft = numFrames;
+
+	idLib::Printf( "recording jobs for %d frames\n", numFrames );
+}
+
 /*
 ========================
 idParallelJobManagerLocal::Submit
@@ -1505,9 +2239,505 @@ void idParallelJobManagerLocal::Submit( idParallelJobList_Threads* jobList, int
 		return;
 	}
 
+	if( jobs_workStealing.GetBool() )
+	{
+		jobList->PrepareStealing( numThreads );
+		numActiveStealLists.Increment();
+
+		if( jobList->WaitForOtherJobList() )
+		{
+			// the job threads will start this list once the other list is done
+			waitingMutex.Lock();
+			waitingStealLists.Append( jobList );
+			numWaitingStealLists.Increment();
+			waitingMutex.Unlock();
+
+			for( int i = 0; i < numThreads; i++ )
+			{
+				threads[i].SignalWork();
+			}
+		}
+		else
+		{
+			jobList->StartStealing( -1 );
+		}
+		return;
+	}
+
 	for( int i = 0; i < numThreads; i++ )
 	{
 		threads[i].AddJobList( jobList );
 		threads[i].SignalWork();
 	}
 }
+
+/*
+========================
+idParallelJobManagerLocal::SubmitRange
+
+Job threads push onto their own deque, any other thread goes through the shared
+injection queue.
+========================
+*/
+void idParallelJobManagerLocal::SubmitRange( const jobRange_t& range, int threadNum )
+{
+	if( threadNum < 0 || !threads[threadNum].GetStealDeque( range.priority ).Push( range ) )
+	{
+		InjectRange( range );
+	}
+
+	// wake up the threads that are allowed to steal from this job list
+	const int numThreads = range.jobList->GetNumStealThreads();
+	for( int i = 0; i < numThreads; i++ )
+	{
+		if( i != threadNum )
+		{
+			threads[i].SignalWork();
+		}
+	}
+}
+
+/*
+========================
+idParallelJobManagerLocal::FinishStealJobList
+========================
+*/
+void idParallelJobManagerLocal::FinishStealJobList( idParallelJobList_Threads* jobList )
+{
+	numActiveStealLists.Decrement();
+}
+
+/*
+========================
+idParallelJobManagerLocal::InjectRange
+========================
+*/
+void idParallelJobManagerLocal::InjectRange( const jobRange_t& range )
+{
+	while( !TryInjectRange( range ) )
+	{
+		// wait until the job threads picked up some of the ranges
+		Sys_Yield();
+	}
+}
+
+/*
+========================
+idParallelJobManagerLocal::TryInjectRange
+========================
+*/
+bool idParallelJobManagerLocal::TryInjectRange( const jobRange_t& range )
+{
+	const int priority = range.priority;
+	bool added = false;
+	injectMutex.Lock();
+	if( lastInjectedRange[priority] - firstInjectedRange[priority] < MAX_INJECTED_RANGES )
+	{
+		injectedRanges[priority][lastInjectedRange[priority] & ( MAX_INJECTED_RANGES - 1 )] = range;
+		lastInjectedRange[priority]++;
+		numInjectedRanges.Increment();
+		added = true;
+	}
+	injectMutex.Unlock();
+	return added;
+}
+
+/*
+========================
+idParallelJobManagerLocal::GetInjectedRange
+========================
+*/
+bool idParallelJobManagerLocal::GetInjectedRange( int priority, jobRange_t& range )
+{
+	bool found = false;
+	injectMutex.Lock();
+	if( firstInjectedRange[priority] < lastInjectedRange[priority] )
+	{
+		range = injectedRanges[priority][firstInjectedRange[priority] & ( MAX_INJECTED_RANGES - 1 )];
+		firstInjectedRange[priority]++;
+		numInjectedRanges.Decrement();
+		found = true;
+	}
+	injectMutex.Unlock();
+	return found;
+}
+
+/*
+========================
+idParallelJobManagerLocal::GetJobRange
+
+Takes work from the highest priority first: the own deque, then the injection
+queue and finally the deques of the other threads. A negative thread number is
+any thread that isn't a job thread and has no deque.
+========================
+*/
+bool idParallelJobManagerLocal::GetJobRange( int threadNum, jobRange_t& range )
+{
+	for( int priority = JOBLIST_PRIORITY_HIGH; priority > JOBLIST_PRIORITY_NONE; priority-- )
+	{
+		if( threadNum >= 0 && threads[threadNum].GetStealDeque( priority ).Pop( range ) )
+		{
+			return true;
+		}
+		if( numInjectedRanges.GetValue() > 0 && GetInjectedRange( priority, range ) )
+		{
+			return true;
+		}
+		// start with the next thread so the thieves don't all hit the same victim
+		for( int i = 1; i <= MAX_JOB_THREADS; i++ )
+		{
+			const int victim = ( threadNum + i ) % MAX_JOB_THREADS;
+			if( victim == threadNum )
+			{
+				continue;
+			}
+			idJobStealDeque& deque = threads[victim].GetStealDeque( priority );
+			if( !deque.IsEmpty() && deque.Steal( range ) )
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+/*
+========================
+idParallelJobManagerLocal::StartWaitingJobLists
+========================
+*/
+void idParallelJobManagerLocal::StartWaitingJobLists( unsigned int threadNum )
+{
+	if( !waitingMutex.Lock( false ) )
+	{
+		return;
+	}
+	for( int i = 0; i < waitingStealLists.Num(); i++ )
+	{
+		idParallelJobList_Threads* jobList = waitingStealLists[i];
+		if( !jobList->WaitForOtherJobList() )
+		{
+			waitingStealLists.RemoveIndex( i );
+			numWaitingStealLists.Decrement();
+			i--;
+			jobList->StartStealing( threadNum );
+		}
+	}
+	waitingMutex.Unlock();
+}
+
+/*
+========================
+idParallelJobManagerLocal::RunJobRange
+========================
+*/
+void idParallelJobManagerLocal::RunJobRange( int threadNum, jobRange_t& range )
+{
+	// other threads share the stats with the first job thread, like a job list that runs in place
+	const unsigned int statsThreadNum = Max( threadNum, 0 );
+
+	if( range.function != NULL )
+	{
+		range.jobList->RunSpawnedJob( statsThreadNum, range );
+		numSpawnedJobs.Decrement();
+		return;
+	}
+
+	// keep the lower half and leave the upper half for other threads to steal
+	if( threadNum >= 0 )
+	{
+		idJobStealDeque& deque = threads[threadNum].GetStealDeque( range.priority );
+		while( range.lastJob - range.firstJob > 1 )
+		{
+			jobRange_t upper = range;
+			upper.firstJob = ( range.firstJob + range.lastJob ) >> 1;
+			if( !deque.Push( upper ) )
+			{
+				break;
+			}
+			range.lastJob = upper.firstJob;
+		}
+	}
+	range.jobList->RunJobRange( statsThreadNum, range );
+}
+
+/*
+========================
+idParallelJobManagerLocal::SpawnJob
+
+Spawned jobs go on the deque of the spawning job thread so the spawning thread
+runs them itself unless an idle thread steals them first. When there is no room
+left the job runs right away, waiting for room could deadlock the spawning thread.
+========================
+*/
+void idParallelJobManagerLocal::SpawnJob( const jobRange_t& job )
+{
+	numSpawnedJobs.Increment();
+
+	const int threadNum = ( int )jobThreadNum - 1;
+	if( threadNum < 0 || !threads[threadNum].GetStealDeque( job.priority ).Push( job ) )
+	{
+		if( !TryInjectRange( job ) )
+		{
+			jobRange_t inlineJob = job;
+			RunJobRange( threadNum, inlineJob );
+			return;
+		}
+	}
+
+	// wake up the idle threads so they can steal the job, like a submitted job list does
+	for( unsigned int i = 0; i < maxThreads; i++ )
+	{
+		if( ( int )i != threadNum && threads[i].IsWorkDone() )
+		{
+			threads[i].SignalWork();
+		}
+	}
+}
+
+/*
+========================
+idParallelJobManagerLocal::JoinJobs
+
+Runs other jobs while waiting instead of spinning. This also works on a thread
+that isn't a job thread, for instance when a job list runs in place with
+jobs_numThreads 0.
+========================
+*/
+void idParallelJobManagerLocal::JoinJobs( idParallelJobCounter& counter )
+{
+	const int threadNum = ( int )jobThreadNum - 1;
+
+	while( !counter.IsDone() )
+	{
+		jobRange_t range;
+		if( GetJobRange( threadNum, range ) )
+		{
+			RunJobRange( threadNum, range );
+			continue;
+		}
+		Sys_Yield();
+	}
+}
+
+/*
+========================
+idParallelJobManagerLocal::RunStealJobs
+
+Keeps the job thread busy as long as there are work stealing job lists in flight.
+Returns true if the thread should go back to run newly added job lists.
+========================
+*/
+bool idParallelJobManagerLocal::RunStealJobs( unsigned int threadNum )
+{
+	idJobThread& thread = threads[threadNum];
+	bool newJobLists = false;
+
+	while( !thread.IsTerminating() && ( numActiveStealLists.GetValue() > 0 || numSpawnedJobs.GetValue() > 0 ) )
+	{
+		if( thread.HasNewJobLists() )
+		{
+			newJobLists = true;
+			break;
+		}
+
+		jobRange_t range;
+		if( GetJobRange( threadNum, range ) )
+		{
+			RunJobRange( threadNum, range );
+			continue;
+		}
+
+		if( numWaitingStealLists.GetValue() > 0 )
+		{
+			StartWaitingJobLists( threadNum );
+		}
+
+		// nothing to steal right now but jobs still running may release another segment
+		Sys_Yield();
+	}
+
+	return newJobLists;
+}
+
+/*
+================================================================================================
+
+	Job throughput benchmark
+
+================================================================================================
+*/
+
+struct benchmarkJob_t
+{
+	int			iterations;
+	float		result;
+	byte		pad[56];	// keep every job on its own cache line
+};
+
+/*
+========================
+BenchmarkJob
+========================
+*/
+static void BenchmarkJob( benchmarkJob_t* job )
+{
+	float x = 0.0f;
+	for( int i = 0; i < job->iterations; i++ )
+	{
+		x = x * 0.999f + idMath::Sqrt( ( float ) i );
+	}
+	job->result = x;
+}
+
+REGISTER_PARALLEL_JOB( BenchmarkJob, "BenchmarkJob" );
+
+CONSOLE_COMMAND( jobs_benchmark, "reports jobs/sec for an increasing number of job threads, usage: jobs_benchmark [numJobs] [iterations]", 0 )
+{
+	const int numJobs = ( args.Argc() > 1 ) ? idMath::ClampInt( 1, 65536, atoi( args.Argv( 1 ) ) ) : 8192;
+	const int iterations = ( args.Argc() > 2 ) ? Max( 1, atoi( args.Argv( 2 ) ) ) : 2000;
+	const int numSyncs = 3;
+	const int numRuns = 5;
+	const int jobsPerSync = Max( 1, numJobs / ( numSyncs + 1 ) );
+	const int maxThreads = Min( Max( parallelJobManager->GetLogicalCpuCores(), jobs_numThreads.GetInteger() ), MAX_JOB_THREADS );
+	const bool workStealing = jobs_workStealing.GetBool();
+
+	benchmarkJob_t* jobs = ( benchmarkJob_t* )Mem_ClearedAlloc( numJobs * sizeof( benchmarkJob_t ), TAG_JOBLIST );
+	idParallelJobList* jobList = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_MEDIUM, numJobs, numSyncs, NULL );
+
+	idLib::Printf( "%d jobs with %d iterations and %d sync points, best of %d runs\n", numJobs, iterations, numSyncs, numRuns );
+	idLib::Printf( "threads     shared jobs/sec   stealing jobs/sec\n" );
+
+	for( int numThreads = 1; ; numThreads = Min( numThreads * 2, maxThreads ) )
+	{
+		float jobsPerSec[2];
+		for( int mode = 0; mode < 2; mode++ )
+		{
+			jobs_workStealing.SetBool( mode != 0 );
+
+			uint64 bestTime = 0;
+			for( int run = 0; run < numRuns; run++ )
+			{
+				int syncs = 0;
+				for( int i = 0; i < numJobs; i++ )
+				{
+					if( i > 0 && ( i % jobsPerSync ) == 0 && syncs < numSyncs )
+					{
+						jobList->InsertSyncPoint( SYNC_SIGNAL );
+						jobList->InsertSyncPoint( SYNC_SYNCHRONIZE );
+						syncs++;
+					}
+					jobs[i].iterations = iterations;
+					jobList->AddJob( ( jobRun_t )BenchmarkJob, &jobs[i] );
+				}
+
+				const uint64 start = Sys_Microseconds();
+				jobList->Submit( NULL, numThreads );
+				jobList->Wait();
+				const uint64 time = Sys_Microseconds() - start;
+
+				if( run == 0 || time < bestTime )
+				{
+					bestTime = time;
+				}
+			}
+			jobsPerSec[mode] = numJobs * 1000000.0f / Max( bestTime, ( uint64 )1 );
+		}
+
+		idLib::Printf( "%7d %19.0f %19.0f\n", numThreads, jobsPerSec[0], jobsPerSec[1] );
+
+		if( numThreads >= maxThreads )
+		{
+			break;
+		}
+	}
+
+	jobs_workStealing.SetBool( workStealing );
+
+	parallelJobManager->FreeJobList( jobList );
+	Mem_Free( jobs );
+}
+
+/*
+================================================================================================
+
+	Fork/join test
+
+================================================================================================
+*/
+
+struct forkJoinSum_t
+{
+	idParallelJobList* 	jobList;
+	const int* 			values;
+	int					firstValue;
+	int					lastValue;
+	int64				sum;
+};
+
+/*
+========================
+ForkJoinSumJob
+========================
+*/
+static void ForkJoinSumJob( forkJoinSum_t* parms )
+{
+	if( parms->lastValue - parms->firstValue <= 4096 )
+	{
+		parms->sum = 0;
+		for( int i = parms->firstValue; i < parms->lastValue; i++ )
+		{
+			parms->sum += parms->values[i];
+		}
+		return;
+	}
+
+	const int middle = ( parms->firstValue + parms->lastValue ) >> 1;
+
+	forkJoinSum_t left = *parms;
+	left.lastValue = middle;
+	forkJoinSum_t right = *parms;
+	right.firstValue = middle;
+
+	idParallelJobCounter counter;
+	parms->jobList->Spawn( ( jobRun_t )ForkJoinSumJob, &left, counter );
+	ForkJoinSumJob( &right );
+	parms->jobList->Join( counter );
+
+	parms->sum = left.sum + right.sum;
+}
+
+REGISTER_PARALLEL_JOB( ForkJoinSumJob, "ForkJoinSumJob" );
+
+CONSOLE_COMMAND( jobs_testForkJoin, "recursively splits a sum into spawned jobs and checks the result, usage: jobs_testForkJoin [numValues]", 0 )
+{
+	const int numValues = ( args.Argc() > 1 ) ? Max( 1, atoi( args.Argv( 1 ) ) ) : ( 1 << 22 );
+
+	int* values = ( int* )Mem_Alloc( numValues * sizeof( int ), TAG_JOBLIST );
+	int64 expected = 0;
+	for( int i = 0; i < numValues; i++ )
+	{
+		values[i] = ( i * 7 ) & 255;
+		expected += values[i];
+	}
+
+	idParallelJobList* jobList = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_MEDIUM, 1, 0, NULL );
+
+	forkJoinSum_t parms;
+	parms.jobList = jobList;
+	parms.values = values;
+	parms.firstValue = 0;
+	parms.lastValue = numValues;
+	parms.sum = 0;
+
+	const uint64 start = Sys_Microseconds();
+	jobList->AddJob( ( jobRun_t )ForkJoinSumJob, &parms );
+	jobList->Submit();
+	jobList->Wait();
+	const uint64 end = Sys_Microseconds();
+
+	idLib::Printf( "fork/join sum of %d values %s in %1.2f ms\n", numValues, ( parms.sum == expected ) ? "OK" : "FAILED", ( end - start ) * ( 1.0f / 1000.0f ) );
+
+	parallelJobManager->FreeJobList( jobList );
+	Mem_Free( values );
+}
@@ -75,6 +75,30 @@ enum jobListParallelism_t
 	#undef AddJob
 #endif
 
+/*
+================================================
+idParallelJobCounter
+
+Counts the jobs spawned with idParallelJobList::Spawn that
+have not finished yet.
+================================================
+*/
+class idParallelJobCounter
+{
+	friend class idParallelJobList_Threads;
+public:
+	idParallelJobCounter() : pending( 0 ) {}
+
+	// atomic read, this is polled while other threads decrement the counter
+	bool					IsDone() const
+	{
+		return ( Sys_InterlockedAdd( pending, 0 ) <= 0 );
+	}
+
+private:
+	mutable interlockedInt_t	pending;	// only accessed with Sys_Interlocked*, Thread.h is not available here
+};
+
 /*
 ================================================
 idParallelJobList
@@ -104,6 +128,17 @@ public:
 	// Try to wait for the jobs in this list to finish but either way return immediately. Returns true if all jobs are done.
 	bool					TryWait();
 
+	// Fork/join from inside a running job of this list. The spawned job may be stolen by any
+	// job thread and may spawn more jobs itself. The job list is not done before all spawned
+	// jobs are done but the data of a spawned job usually lives on the stack of the parent,
+	// so the parent should Join before it returns.
+	// A list that is never submitted can also spawn jobs from any thread, the counter is
+	// then the only way to wait for them.
+	void					Spawn( jobRun_t function, void* data, idParallelJobCounter& counter );
+
+	// Wait for all jobs spawned with the counter. A job thread runs other jobs while waiting.
+	void					Join( idParallelJobCounter& counter );
+
 	// returns true if the job list has been submitted.
 	bool					IsSubmitted() const;
 
@@ -180,6 +215,9 @@ public:
 	virtual int					GetLogicalCpuCores() const = 0;	// RB
 
 	virtual void				WaitForAllJobLists() = 0;
+
+	// called once per frame, writes the job trace started with jobs_trace once all frames are recorded
+	virtual void				UpdateTrace() = 0;
 };
 
 extern idParallelJobManager* 	parallelJobManager;
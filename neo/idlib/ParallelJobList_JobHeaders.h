@@ -79,6 +79,7 @@ If you have questions concerning this license or the applicable additional terms
 #include "sys/sys_types.h"
 #include "sys/sys_intrinsics.h"
 #include "math/Math.h"
+#include "sys/sys_threading.h"
 #include "ParallelJobList.h"
 
 #if _MSC_VER >= 1600
@@ -37,6 +37,10 @@ If you have questions concerning this license or the applicable additional terms
 #include "../bv/Bounds.h"
 #include "RenderMatrix.h"
 
+#if defined(USE_INTRINSICS_SSE) && defined(__AVX2__)
+	#include <immintrin.h>
+#endif
+
 // FIXME:	it would be nice if all render matrices were 16-byte aligned
 //			so there is no need for unaligned loads and stores everywhere
 
@@ -1971,6 +1975,209 @@ bool idRenderMatrix::CullBoundsToMVPbits( const idRenderMatrix& mvp, const idBou
 #endif
 }
 
+/*
+========================
+idRenderMatrix::CullBoundsToMVPBatch
+
+Same test as CullBoundsToMVP for many bounds with a single call, one bounds per SIMD lane.
+
+The bounds are a structure of arrays: six rows of 'stride' floats holding the min X, min Y,
+min Z, max X, max Y and max Z of every bounds. The stride must be a multiple of
+CULL_BOUNDS_BATCH_SIZE and the padding must hold valid floats, because whole batches are read.
+
+culled[i] is set to 1 if bounds i is culled and 0 otherwise. Returns the number of culled bounds.
+========================
+*/
+int idRenderMatrix::CullBoundsToMVPBatch( const idRenderMatrix& mvp, const float* boundsSoA, int stride, int numBounds, byte* culled, bool zeroToOne )
+{
+	assert( stride % CULL_BOUNDS_BATCH_SIZE == 0 );
+	assert( numBounds <= stride );
+
+	const float* rows[6];
+	for( int i = 0; i < 6; i++ )
+	{
+		rows[i] = boundsSoA + i * stride;
+	}
+
+	int numCulled = 0;
+
+#if defined(USE_INTRINSICS_SSE) && defined(__AVX2__)
+
+	__m256 m[4][4];
+	for( int r = 0; r < 4; r++ )
+	{
+		for( int c = 0; c < 4; c++ )
+		{
+			m[r][c] = _mm256_set1_ps( mvp[r][c] );
+		}
+	}
+
+	const __m256 minMul = _mm256_set1_ps( zeroToOne ? 0.0f : -1.0f );
+	const __m256 zero = _mm256_setzero_ps();
+
+	for( int i = 0; i < numBounds; i += 8 )
+	{
+		// partial products of the min / max extents with every matrix row,
+		// the translation is folded into the Z products
+		__m256 px[2][4];
+		__m256 py[2][4];
+		__m256 pz[2][4];
+		for( int e = 0; e < 2; e++ )
+		{
+			const __m256 bx = _mm256_loadu_ps( rows[e * 3 + 0] + i );
+			const __m256 by = _mm256_loadu_ps( rows[e * 3 + 1] + i );
+			const __m256 bz = _mm256_loadu_ps( rows[e * 3 + 2] + i );
+			for( int r = 0; r < 4; r++ )
+			{
+				px[e][r] = _mm256_mul_ps( bx, m[r][0] );
+				py[e][r] = _mm256_mul_ps( by, m[r][1] );
+				pz[e][r] = _mm256_add_ps( _mm256_mul_ps( bz, m[r][2] ), m[r][3] );
+			}
+		}
+
+		// a bit is set for every side that has at least one corner on the inside
+		__m256 inside[6];
+		for( int s = 0; s < 6; s++ )
+		{
+			inside[s] = zero;
+		}
+
+		for( int corner = 0; corner < 8; corner++ )
+		{
+			const int ex = corner & 1;
+			const int ey = ( corner >> 1 ) & 1;
+			const int ez = corner >> 2;
+
+			__m256 v[4];
+			for( int r = 0; r < 4; r++ )
+			{
+				v[r] = _mm256_add_ps( _mm256_add_ps( px[ex][r], py[ey][r] ), pz[ez][r] );
+			}
+
+			const __m256 maxW = v[3];
+			const __m256 minW = _mm256_mul_ps( v[3], minMul );
+#if defined( CLIP_SPACE_D3D )
+			const __m256 minZ = zero;
+#else
+			const __m256 minZ = minW;
+#endif
+
+			inside[0] = _mm256_or_ps( inside[0], _mm256_cmp_ps( v[0], minW, _CMP_GT_OQ ) );
+			inside[1] = _mm256_or_ps( inside[1], _mm256_cmp_ps( maxW, v[0], _CMP_GT_OQ ) );
+			inside[2] = _mm256_or_ps( inside[2], _mm256_cmp_ps( v[1], minW, _CMP_GT_OQ ) );
+			inside[3] = _mm256_or_ps( inside[3], _mm256_cmp_ps( maxW, v[1], _CMP_GT_OQ ) );
+			inside[4] = _mm256_or_ps( inside[4], _mm256_cmp_ps( v[2], minZ, _CMP_GT_OQ ) );
+			inside[5] = _mm256_or_ps( inside[5], _mm256_cmp_ps( maxW, v[2], _CMP_GT_OQ ) );
+		}
+
+		__m256 visible = _mm256_and_ps( inside[0], inside[1] );
+		visible = _mm256_and_ps( visible, _mm256_and_ps( inside[2], inside[3] ) );
+		visible = _mm256_and_ps( visible, _mm256_and_ps( inside[4], inside[5] ) );
+
+		const int culledBits = ~_mm256_movemask_ps( visible );
+		const int numLanes = Min( 8, numBounds - i );
+		for( int j = 0; j < numLanes; j++ )
+		{
+			culled[i + j] = ( byte )( ( culledBits >> j ) & 1 );
+			numCulled += culled[i + j];
+		}
+	}
+
+#elif defined(USE_INTRINSICS_SSE)
+
+	__m128 m[4][4];
+	for( int r = 0; r < 4; r++ )
+	{
+		for( int c = 0; c < 4; c++ )
+		{
+			m[r][c] = _mm_set1_ps( mvp[r][c] );
+		}
+	}
+
+	const __m128 minMul = zeroToOne ? vector_float_zero : vector_float_neg_one;
+
+	for( int i = 0; i < numBounds; i += 4 )
+	{
+		// partial products of the min / max extents with every matrix row,
+		// the translation is folded into the Z products
+		__m128 px[2][4];
+		__m128 py[2][4];
+		__m128 pz[2][4];
+		for( int e = 0; e < 2; e++ )
+		{
+			const __m128 bx = _mm_loadu_ps( rows[e * 3 + 0] + i );
+			const __m128 by = _mm_loadu_ps( rows[e * 3 + 1] + i );
+			const __m128 bz = _mm_loadu_ps( rows[e * 3 + 2] + i );
+			for( int r = 0; r < 4; r++ )
+			{
+				px[e][r] = _mm_mul_ps( bx, m[r][0] );
+				py[e][r] = _mm_mul_ps( by, m[r][1] );
+				pz[e][r] = _mm_madd_ps( bz, m[r][2], m[r][3] );
+			}
+		}
+
+		// a bit is set for every side that has at least one corner on the inside
+		__m128 inside[6];
+		for( int s = 0; s < 6; s++ )
+		{
+			inside[s] = vector_float_zero;
+		}
+
+		for( int corner = 0; corner < 8; corner++ )
+		{
+			const int ex = corner & 1;
+			const int ey = ( corner >> 1 ) & 1;
+			const int ez = corner >> 2;
+
+			__m128 v[4];
+			for( int r = 0; r < 4; r++ )
+			{
+				v[r] = _mm_add_ps( _mm_add_ps( px[ex][r], py[ey][r] ), pz[ez][r] );
+			}
+
+			const __m128 maxW = v[3];
+			const __m128 minW = _mm_mul_ps( v[3], minMul );
+#if defined( CLIP_SPACE_D3D )
+			const __m128 minZ = vector_float_zero;
+#else
+			const __m128 minZ = minW;
+#endif
+
+			inside[0] = _mm_or_ps( inside[0], _mm_cmpgt_ps( v[0], minW ) );
+			inside[1] = _mm_or_ps( inside[1], _mm_cmpgt_ps( maxW, v[0] ) );
+			inside[2] = _mm_or_ps( inside[2], _mm_cmpgt_ps( v[1], minW ) );
+			inside[3] = _mm_or_ps( inside[3], _mm_cmpgt_ps( maxW, v[1] ) );
+			inside[4] = _mm_or_ps( inside[4], _mm_cmpgt_ps( v[2], minZ ) );
+			inside[5] = _mm_or_ps( inside[5], _mm_cmpgt_ps( maxW, v[2] ) );
+		}
+
+		__m128 visible = _mm_and_ps( inside[0], inside[1] );
+		visible = _mm_and_ps( visible, _mm_and_ps( inside[2], inside[3] ) );
+		visible = _mm_and_ps( visible, _mm_and_ps( inside[4], inside[5] ) );
+
+		const int culledBits = ~_mm_movemask_ps( visible );
+		const int numLanes = Min( 4, numBounds - i );
+		for( int j = 0; j < numLanes; j++ )
+		{
+			culled[i + j] = ( byte )( ( culledBits >> j ) & 1 );
+			numCulled += culled[i + j];
+		}
+	}
+
+#else
+
+	for( int i = 0; i < numBounds; i++ )
+	{
+		const idBounds bounds( idVec3( rows[0][i], rows[1][i], rows[2][i] ), idVec3( rows[3][i], rows[4][i], rows[5][i] ) );
+		culled[i] = CullBoundsToMVP( mvp, bounds, zeroToOne ) ? 1 : 0;
+		numCulled += culled[i];
+	}
+
+#endif
+
+	return numCulled;
+}
+
 /*
 ========================
 idRenderMatrix::CullExtrudedBoundsToMVPbits
@@ -31,6 +31,9 @@ If you have questions concerning this license or the applicable additional terms
 
 static const int NUM_FRUSTUM_CORNERS	= 8;
 
+// the rows of structure-of-arrays bounds passed to CullBoundsToMVPBatch must be padded to this many floats
+static const int CULL_BOUNDS_BATCH_SIZE	= 8;
+
 struct frustumCorners_t
 {
 	float	x[NUM_FRUSTUM_CORNERS];
@@ -145,6 +148,7 @@ public:
 	static bool				CullPointToMVPbits( const idRenderMatrix& mvp, const idVec3& point, byte* outBits, bool zeroToOne = false );
 	static bool				CullBoundsToMVP( const idRenderMatrix& mvp, const idBounds& bounds, bool zeroToOne = false );
 	static bool				CullBoundsToMVPbits( const idRenderMatrix& mvp, const idBounds& bounds, byte* outBits, bool zeroToOne = false );
+	static int				CullBoundsToMVPBatch( const idRenderMatrix& mvp, const float* boundsSoA, int stride, int numBounds, byte* culled, bool zeroToOne = false );
 	static bool				CullExtrudedBoundsToMVP( const idRenderMatrix& mvp, const idBounds& bounds, const idVec3& extrudeDirection, const idPlane& clipPlane, bool zeroToOne = false );
 	static bool				CullExtrudedBoundsToMVPbits( const idRenderMatrix& mvp, const idBounds& bounds, const idVec3& extrudeDirection, const idPlane& clipPlane, byte* outBits, bool zeroToOne = false );
 
@@ -865,18 +865,24 @@ void idImageManager::Preload( const idPreloadManifest& manifest, const bool& map
 		int	start = Sys_Milliseconds();
 		int numLoaded = 0;
 
-		//fileSystem->StartPreload( preloadImageFiles );
-
-		// count
-		int numPreload = 0;
+		// count and start reading the generated images in the background
+		idStrList preloadImageFiles;
 		for( int i = 0; i < manifest.NumResources(); i++ )
 		{
 			const preloadEntry_s& p = manifest.GetPreloadByIndex( i );
 			if( p.resType == PRELOAD_IMAGE && !ExcludePreloadImage( p.resourceName ) )
 			{
-				numPreload++;
+				idStr name = p.resourceName;
+				idImage::GetGeneratedName( name, ( textureUsage_t )p.imgData.usage, ( cubeFiles_t )p.imgData.cubeMap );
+
+				idStr generatedFileName;
+				idBinaryImage::GetGeneratedFileName( generatedFileName, name );
+				preloadImageFiles.Append( generatedFileName );
 			}
 		}
+		const int numPreload = preloadImageFiles.Num();
+
+		fileSystem->StartPreload( preloadImageFiles );
 
 		common->LoadPacifierInfo( "Preloading images" );
 		common->LoadPacifierProgressTotal( numPreload );
@@ -892,7 +898,7 @@ void idImageManager::Preload( const idPreloadManifest& manifest, const bool& map
 				common->LoadPacifierProgressIncrement( 1 );
 			}
 		}
-		//fileSystem->StopPreload();
+		fileSystem->StopPreload();
 		int	end = Sys_Milliseconds();
 		common->Printf( "%05d images preloaded ( or were already loaded ) in %5.1f seconds\n", numLoaded, ( end - start ) * 0.001 );
 		common->Printf( "----------------------------------------\n" );
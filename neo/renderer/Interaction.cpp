@@ -417,14 +417,13 @@ idInteraction* idInteraction::AllocAndLink( idRenderEntityLocal* edef, idRenderL
 	}
 
 	// update the interaction table
-	if( renderWorld->interactionTable != NULL )
+	if( renderWorld->HasInteractionTable() )
 	{
-		int index = ldef->index * renderWorld->interactionTableWidth + edef->index;
-		if( renderWorld->interactionTable[index] != NULL )
+		if( renderWorld->GetInteraction( ldef->index, edef->index ) != NULL )
 		{
 			common->Error( "idInteraction::AllocAndLink: non NULL table entry" );
 		}
-		renderWorld->interactionTable[ index ] = interaction;
+		renderWorld->SetInteraction( ldef->index, edef->index, interaction );
 	}
 
 	return interaction;
@@ -511,14 +510,14 @@ void idInteraction::UnlinkAndFree()
 	idRenderWorldLocal* renderWorld = this->lightDef->world;
 
 	// RB: added check for NULL
-	if( renderWorld->interactionTable != NULL )
+	if( renderWorld->HasInteractionTable() )
 	{
-		int index = this->lightDef->index * renderWorld->interactionTableWidth + this->entityDef->index;
-		if( renderWorld->interactionTable[index] != this && renderWorld->interactionTable[index] != INTERACTION_EMPTY )
+		const idInteraction* inter = renderWorld->GetInteraction( this->lightDef->index, this->entityDef->index );
+		if( inter != this && inter != INTERACTION_EMPTY )
 		{
 			common->Error( "idInteraction::UnlinkAndFree: interactionTable wasn't set" );
 		}
-		renderWorld->interactionTable[index] = NULL;
+		renderWorld->SetInteraction( this->lightDef->index, this->entityDef->index, NULL );
 	}
 	// RB end
 
@@ -575,9 +574,8 @@ void idInteraction::MakeEmpty()
 	}
 
 	// store the special marker in the interaction table
-	const int interactionIndex = lightDef->index * entityDef->world->interactionTableWidth + entityDef->index;
-	assert( entityDef->world->interactionTable[ interactionIndex ] == this );
-	entityDef->world->interactionTable[ interactionIndex ] = INTERACTION_EMPTY;
+	assert( entityDef->world->GetInteraction( lightDef->index, entityDef->index ) == this );
+	entityDef->world->SetInteraction( lightDef->index, entityDef->index, INTERACTION_EMPTY );
 }
 
 /*
@@ -677,6 +675,193 @@ void idInteraction::CreateStaticInteraction( nvrhi::ICommandList* commandList )
 	}
 }
 
+/*
+===========================================================================
+
+idInteractionTable
+
+===========================================================================
+*/
+
+#define INTERACTION_TABLE_MIN_SIZE	1024
+
+/*
+===================
+idInteractionTable::idInteractionTable
+===================
+*/
+idInteractionTable::idInteractionTable()
+{
+	entries = NULL;
+	mask = -1;
+	numEntries = 0;
+}
+
+/*
+===================
+idInteractionTable::~idInteractionTable
+===================
+*/
+idInteractionTable::~idInteractionTable()
+{
+	Clear();
+}
+
+/*
+===================
+idInteractionTable::Clear
+===================
+*/
+void idInteractionTable::Clear()
+{
+	if( entries != NULL )
+	{
+		R_StaticFree( entries );
+		entries = NULL;
+	}
+	mask = -1;
+	numEntries = 0;
+}
+
+/*
+===================
+idInteractionTable::Get
+===================
+*/
+idInteraction* idInteractionTable::Get( int lightIndex, int entityIndex ) const
+{
+	if( entries == NULL )
+	{
+		return NULL;
+	}
+
+	for( int slot = Hash( lightIndex, entityIndex ) & mask; ; slot = ( slot + 1 ) & mask )
+	{
+		const entry_t& entry = entries[ slot ];
+		if( entry.interaction == NULL )
+		{
+			return NULL;
+		}
+		if( entry.lightIndex == lightIndex && entry.entityIndex == entityIndex )
+		{
+			return entry.interaction;
+		}
+	}
+}
+
+/*
+===================
+idInteractionTable::Set
+
+A NULL interaction removes the pair.
+===================
+*/
+void idInteractionTable::Set( int lightIndex, int entityIndex, idInteraction* interaction )
+{
+	if( interaction != NULL && ( numEntries + 1 ) * 2 > mask + 1 )
+	{
+		Grow();
+	}
+
+	if( entries == NULL )
+	{
+		return;
+	}
+
+	for( int slot = Hash( lightIndex, entityIndex ) & mask; ; slot = ( slot + 1 ) & mask )
+	{
+		entry_t& entry = entries[ slot ];
+		if( entry.interaction == NULL )
+		{
+			if( interaction != NULL )
+			{
+				entry.lightIndex = lightIndex;
+				entry.entityIndex = entityIndex;
+				entry.interaction = interaction;
+				numEntries++;
+			}
+			return;
+		}
+		if( entry.lightIndex == lightIndex && entry.entityIndex == entityIndex )
+		{
+			if( interaction != NULL )
+			{
+				entry.interaction = interaction;
+			}
+			else
+			{
+				Remove( slot );
+			}
+			return;
+		}
+	}
+}
+
+/*
+===================
+idInteractionTable::Remove
+
+Shifts the following entries of the probe sequence back so no tombstones are needed.
+===================
+*/
+void idInteractionTable::Remove( int slot )
+{
+	entries[ slot ].interaction = NULL;
+	numEntries--;
+
+	for( int next = ( slot + 1 ) & mask; entries[ next ].interaction != NULL; next = ( next + 1 ) & mask )
+	{
+		const int ideal = Hash( entries[ next ].lightIndex, entries[ next ].entityIndex ) & mask;
+
+		// move the entry into the hole unless its ideal slot lies between the hole and the entry
+		if( ( ( next - ideal ) & mask ) >= ( ( next - slot ) & mask ) )
+		{
+			entries[ slot ] = entries[ next ];
+			entries[ next ].interaction = NULL;
+			slot = next;
+		}
+	}
+}
+
+/*
+===================
+idInteractionTable::Grow
+===================
+*/
+void idInteractionTable::Grow()
+{
+	entry_t* oldEntries = entries;
+	const int oldSize = mask + 1;
+
+	const int newSize = Max( INTERACTION_TABLE_MIN_SIZE, oldSize * 2 );
+	entries = ( entry_t* )R_ClearedStaticAlloc( newSize * sizeof( entry_t ) );
+	mask = newSize - 1;
+	numEntries = 0;
+
+	if( oldEntries == NULL )
+	{
+		return;
+	}
+
+	for( int i = 0; i < oldSize; i++ )
+	{
+		const entry_t& entry = oldEntries[ i ];
+		if( entry.interaction == NULL )
+		{
+			continue;
+		}
+		int slot = Hash( entry.lightIndex, entry.entityIndex ) & mask;
+		while( entries[ slot ].interaction != NULL )
+		{
+			slot = ( slot + 1 ) & mask;
+		}
+		entries[ slot ] = entry;
+		numEntries++;
+	}
+
+	R_StaticFree( oldEntries );
+}
+
 /*
 ===================
 R_ShowInteractionMemory_f
@@ -773,4 +958,16 @@ void R_ShowInteractionMemory_f( const idCmdArgs& args )
 	common->Printf( "%5i indexes in %5i shadow tris\n", shadowTriIndexes, shadowTris );
 	common->Printf( "%i maxInteractionsForEntity\n", maxInteractionsForEntity );
 	common->Printf( "%i maxInteractionsForLight\n", maxInteractionsForLight );
+
+	const idRenderWorldLocal* world = tr.primaryWorld;
+	if( world->sparseInteractions )
+	{
+		common->Printf( "sparse interaction table: %i pairs in %i slots, %i KB\n", world->interactionHash.Num(), world->interactionHash.Capacity(),
+						( int )( world->interactionHash.MemoryUsed() >> 10 ) );
+	}
+	else if( world->interactionTable != NULL )
+	{
+		common->Printf( "dense interaction table: %i x %i, %i KB\n", world->interactionTableHeight, world->interactionTableWidth,
+						( int )( ( ( size_t )world->interactionTableWidth * world->interactionTableHeight * sizeof( *world->interactionTable ) ) >> 10 ) );
+	}
 }
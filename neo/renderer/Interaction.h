@@ -146,6 +146,63 @@ private:
 	void					Unlink();
 };
 
+/*
+===============================================================================
+
+idInteractionTable
+
+Sparse store for the light / entity interaction pointers, an open addressed hash
+table with linear probing keyed on the light and entity index.  Only pairs that
+have an interaction use memory, and growing the number of lights or entities
+never copies anything.
+
+===============================================================================
+*/
+
+class idInteractionTable
+{
+public:
+	idInteractionTable();
+	~idInteractionTable();
+
+	void					Clear();
+
+	idInteraction* 			Get( int lightIndex, int entityIndex ) const;
+	void					Set( int lightIndex, int entityIndex, idInteraction* interaction );
+
+	int						Num() const
+	{
+		return numEntries;
+	}
+	int						Capacity() const
+	{
+		return mask + 1;
+	}
+	size_t					MemoryUsed() const
+	{
+		return ( entries != NULL ) ? ( mask + 1 ) * sizeof( entry_t ) : 0;
+	}
+
+private:
+	struct entry_t
+	{
+		int					lightIndex;
+		int					entityIndex;
+		idInteraction* 		interaction;			// NULL for a free entry
+	};
+
+	entry_t* 				entries;
+	int						mask;
+	int						numEntries;
+
+	static unsigned int		Hash( int lightIndex, int entityIndex )
+	{
+		return ( ( unsigned int )lightIndex * 73856093u ) ^ ( ( unsigned int )entityIndex * 19349663u );
+	}
+	void					Remove( int slot );
+	void					Grow();
+};
+
 void R_ShowInteractionMemory_f( const idCmdArgs& args );
 
 #endif /* !__INTERACTION_H__ */
@@ -853,6 +853,8 @@ void idRenderModelManagerLocal::Preload( const idPreloadManifest& manifest )
 		int numLoaded = 0;
 		idList< preloadSort_t > preloadSort;
 		preloadSort.Resize( manifest.NumResources() );
+		idStrList generatedFiles;
+		generatedFiles.SetNum( manifest.NumResources() );
 		for( int i = 0; i < manifest.NumResources(); i++ )
 		{
 			const preloadEntry_s& p = manifest.GetPreloadByIndex( i );
@@ -880,12 +882,22 @@ void idRenderModelManagerLocal::Preload( const idPreloadManifest& manifest )
 					ps.idx = i;
 					ps.ofs = rc.offset;
 					preloadSort.Append( ps );
+					generatedFiles[i] = filename;
 				}
 			}
 		}
 
 		preloadSort.SortWithTemplate( idSort_Preload() );
 
+		// start reading the generated files in the background in resource file order
+		idStrList preloadFiles;
+		preloadFiles.Resize( preloadSort.Num() );
+		for( int i = 0; i < preloadSort.Num(); i++ )
+		{
+			preloadFiles.Append( generatedFiles[ preloadSort[ i ].idx ] );
+		}
+		fileSystem->StartPreload( preloadFiles );
+
 		for( int i = 0; i < preloadSort.Num(); i++ )
 		{
 			const preloadSort_t& ps = preloadSort[ i ];
@@ -904,6 +916,7 @@ void idRenderModelManagerLocal::Preload( const idPreloadManifest& manifest )
 			}
 			numLoaded++;
 		}
+		fileSystem->StopPreload();
 
 		int	end = Sys_Milliseconds();
 		common->Printf( "%05d models preloaded ( or were already loaded ) in %5.1f seconds\n", numLoaded, ( end - start ) * 0.001 );
@@ -413,6 +413,10 @@ struct viewEntity_t
 	bool					weaponDepthHack;
 	float					modelDepthHack;
 
+	// R_AddModels found the world space bounds outside the view frustum,
+	// so the entity is only considered for shadows
+	bool					boundsCulled;
+
 	float					modelMatrix[16];		// local coords to global coords
 	float					modelViewMatrix[16];	// local coords to eye coords
 
@@ -739,6 +743,19 @@ enum frameAllocType_t
 	FRAME_ALLOC_MAX
 };
 
+// every thread allocating frame memory bumps a pointer in its own chunk of
+// the frame memory instead of contending on frameMemoryAllocated
+const int MAX_FRAME_ARENAS =		32;
+
+struct frameArena_t
+{
+	byte* 					memory;
+	int						used;
+	int						size;
+	int						allocated;	// total for this frame, including allocations too large for a chunk
+	byte					padding[CACHE_LINE_SIZE - sizeof( byte* ) - 3 * sizeof( int )];
+};
+
 // all of the information needed by the back end must be
 // contained in a idFrameData.  This entire structure is
 // duplicated so the front and back end can run in parallel
@@ -753,6 +770,8 @@ public:
 	int						highWaterAllocated;	// max used on any frame
 	int						highWaterUsed;
 
+	ALIGNTYPE128 frameArena_t	arenas[MAX_FRAME_ARENAS];
+
 	// the currently building command list commands can be inserted
 	// at the front if needed, as required for dynamically generated textures
 	emptyCommand_t* 		cmdHead;	// may be of other command type based on commandId
@@ -1513,6 +1532,7 @@ void R_ShutdownFrameData();
 void R_ToggleSmpFrame();
 void* R_FrameAlloc( int bytes, frameAllocType_t type = FRAME_ALLOC_UNKNOWN );
 void* R_ClearedFrameAlloc( int bytes, frameAllocType_t type = FRAME_ALLOC_UNKNOWN );
+void R_PrintFrameArenas();
 
 void* R_StaticAlloc( int bytes, const memTag_t tag = TAG_RENDER_STATIC );		// just malloc with error checking
 void* R_ClearedStaticAlloc( int bytes );	// with memset
@@ -1568,6 +1588,7 @@ TR_FRONTEND_MASKED_OCCLUSION_CULLING
 */
 
 void R_FillMaskedOcclusionBufferWithModels( viewDef_t* viewDef );
+void R_FreeMaskedOcclusionBins();
 
 /*
 =============================================================
@@ -87,6 +87,7 @@ void idRenderSystemLocal::PrintPerformanceCounters()
 						pc.c_entityDefCallbacks, pc.c_createInteractions, pc.c_createShadowVolumes );
 		common->Printf( "viewEntities:%i  shadowEntities:%i  viewLights:%i\n", pc.c_visibleViewEntities,
 						pc.c_shadowViewEntities, pc.c_viewLights );
+		common->Printf( "sortedDrawSurfs:%i  sortMicroSec:%i\n", pc.c_sortedDrawSurfs, ( int )pc.sortMicroSec );
 	}
 	if( r_showUpdates.GetBool() )
 	{
@@ -97,6 +98,7 @@ void idRenderSystemLocal::PrintPerformanceCounters()
 	if( r_showMemory.GetBool() )
 	{
 		common->Printf( "frameData: %i (%i)\n", frameData->frameMemoryAllocated.GetValue(), frameData->highWaterAllocated );
+		R_PrintFrameArenas();
 	}
 
 	memset( &pc, 0, sizeof( pc ) );
@@ -136,8 +136,15 @@ struct performanceCounters_t
 	int		c_mocTests;
 	int		c_mocCulledSurfaces;
 	int		c_mocCulledLights;
+	int		c_mocOccluders;			// surfaces rasterized into the masked occlusion buffer
+	int		c_mocSkippedOccluders;	// surfaces below r_mocOccluderMinScreenSize
+	int		c_mocBinnedTris;		// triangles rasterized by the tile jobs, counted once per tile
+	int		c_mocBinningRounds;
+
+	int		c_sortedDrawSurfs;	// R_SortDrawSurfs, summed over all views
 
 	uint64	mocMicroSec;
+	uint64	sortMicroSec;
 	uint64	frontEndMicroSec;	// sum of time in all RE_RenderScene's in a frame
 };
 
@@ -1698,6 +1698,7 @@ void R_InitCommands()
 	cmdSystem->AddCommand( "testVideo", R_TestVideo_f, CMD_FL_RENDERER | CMD_FL_CHEAT, "displays the given cinematic", idCmdSystem::ArgCompletion_VideoName );
 	cmdSystem->AddCommand( "reportSurfaceAreas", R_ReportSurfaceAreas_f, CMD_FL_RENDERER, "lists all used materials sorted by surface area" );
 	cmdSystem->AddCommand( "showInteractionMemory", R_ShowInteractionMemory_f, CMD_FL_RENDERER, "shows memory used by interactions" );
+	cmdSystem->AddCommand( "cullBenchmark", R_CullBenchmark_f, CMD_FL_RENDERER, "compares per-object and batch bounds culling of all entities and lights, usage: cullBenchmark [iterations]" );
 	cmdSystem->AddCommand( "vid_restart", R_VidRestart_f, CMD_FL_RENDERER, "restarts renderSystem" );
 	cmdSystem->AddCommand( "listRenderEntityDefs", R_ListRenderEntityDefs_f, CMD_FL_RENDERER, "lists the entity defs" );
 	cmdSystem->AddCommand( "listRenderLightDefs", R_ListRenderLightDefs_f, CMD_FL_RENDERER, "lists the light defs" );
@@ -1785,6 +1786,7 @@ void idRenderSystemLocal::Clear()
 		delete maskedOcclusionThreaded;
 		maskedOcclusionThreaded = NULL;
 #endif
+		R_FreeMaskedOcclusionBins();
 		MaskedOcclusionCulling::Destroy( maskedOcclusionCulling );
 
 		maskedOcclusionCulling = NULL;
@@ -35,6 +35,8 @@ If you have questions concerning this license or the applicable additional terms
 #include <sys/DeviceManager.h>
 extern DeviceManager* deviceManager;
 
+idCVar r_useSparseInteractionTable( "r_useSparseInteractionTable", "0", CVAR_RENDERER | CVAR_BOOL, "store light / entity interactions in a hash table instead of a lights x entities array, takes effect on the next map load" );
+
 /*
 ===================
 R_ListRenderLightDefs_f
@@ -135,6 +137,210 @@ void R_ListRenderEntityDefs_f( const idCmdArgs& args )
 	common->Printf( "total active: %i\n", active );
 }
 
+/*
+===================
+R_CullBenchmarkBounds
+===================
+*/
+static void R_CullBenchmarkBounds( const char* name, const idRenderMatrix& mvp, const idCullBoundsArray& cullBounds, const idBounds* const* bounds, int iterations )
+{
+	const int num = cullBounds.Num();
+	if( num == 0 )
+	{
+		return;
+	}
+
+	byte* scalarCulled = ( byte* )Mem_ClearedAlloc( num, TAG_RENDER );
+	byte* batchCulled = ( byte* )Mem_ClearedAlloc( num, TAG_RENDER );
+
+	int scalarNumCulled = 0;
+	const uint64 scalarStart = Sys_Microseconds();
+	for( int i = 0; i < iterations; i++ )
+	{
+		scalarNumCulled = 0;
+		for( int j = 0; j < num; j++ )
+		{
+			if( bounds[j] != NULL && idRenderMatrix::CullBoundsToMVP( mvp, *bounds[j] ) )
+			{
+				scalarCulled[j] = 1;
+				scalarNumCulled++;
+			}
+		}
+	}
+	const uint64 scalarEnd = Sys_Microseconds();
+
+	const uint64 batchStart = Sys_Microseconds();
+	for( int i = 0; i < iterations; i++ )
+	{
+		cullBounds.CullToMVP( mvp, batchCulled );
+	}
+	const uint64 batchEnd = Sys_Microseconds();
+
+	int batchNumCulled = 0;
+	int mismatches = 0;
+	for( int j = 0; j < num; j++ )
+	{
+		if( bounds[j] == NULL )
+		{
+			continue;
+		}
+		batchNumCulled += batchCulled[j];
+		if( batchCulled[j] != scalarCulled[j] )
+		{
+			mismatches++;
+		}
+	}
+
+	const float scalarMicroSec = ( float )( scalarEnd - scalarStart ) / iterations;
+	const float batchMicroSec = ( float )( batchEnd - batchStart ) / iterations;
+
+	common->Printf( "%5i %s: scalar %7.2f us (%i culled), batch %7.2f us (%i culled), %.1fx, %i mismatches\n",
+					num, name, scalarMicroSec, scalarNumCulled, batchMicroSec, batchNumCulled,
+					( batchMicroSec > 0.0f ) ? scalarMicroSec / batchMicroSec : 0.0f, mismatches );
+
+	Mem_Free( scalarCulled );
+	Mem_Free( batchCulled );
+}
+
+/*
+===================
+R_CullBenchmark_f
+
+Compares the per-object bounds culling with the batch culling of the
+structure-of-arrays bounds for all entities and lights of the primary world.
+===================
+*/
+void R_CullBenchmark_f( const idCmdArgs& args )
+{
+	const idRenderWorldLocal* world = tr.primaryWorld;
+	if( world == NULL )
+	{
+		common->Printf( "no primary world\n" );
+		return;
+	}
+
+	const int iterations = ( args.Argc() > 1 ) ? Max( 1, atoi( args.Argv( 1 ) ) ) : 1000;
+
+	// the projection of the last primary view
+	const renderView_t& renderView = tr.primaryRenderView;
+
+	idRenderMatrix viewMatrix;
+	idRenderMatrix inverseViewMatrix;
+	idRenderMatrix::CreateFromOriginAxis( renderView.vieworg, renderView.viewaxis, viewMatrix );
+	idRenderMatrix::Inverse( viewMatrix, inverseViewMatrix );
+
+	idRenderMatrix eyeMatrix;
+	idRenderMatrix::Multiply( renderMatrix_flipToOpenGL, inverseViewMatrix, eyeMatrix );
+
+	idRenderMatrix projectionMatrix;
+	idRenderMatrix::CreateProjectionMatrixFov( renderView.fov_x, renderView.fov_y, r_znear.GetFloat(), 0.0f, 0.0f, 0.0f, projectionMatrix );
+
+	idRenderMatrix mvp;
+	idRenderMatrix::Multiply( projectionMatrix, eyeMatrix, mvp );
+
+#if defined(USE_INTRINSICS_SSE) && defined(__AVX2__)
+	const char* kernel = "AVX2";
+#elif defined(USE_INTRINSICS_SSE)
+	const char* kernel = "SSE";
+#else
+	const char* kernel = "generic";
+#endif
+	common->Printf( "%s batch culling, %i iterations\n", kernel, iterations );
+
+	idList<const idBounds*> bounds;
+
+	bounds.AssureSize( world->entityCullBounds.Num(), NULL );
+	for( int i = 0; i < world->entityDefs.Num() && i < bounds.Num(); i++ )
+	{
+		const idRenderEntityLocal* def = world->entityDefs[i];
+		bounds[i] = ( def != NULL && def->entityRefs != NULL ) ? &def->globalReferenceBounds : NULL;
+	}
+	R_CullBenchmarkBounds( "entities", mvp, world->entityCullBounds, bounds.Ptr(), iterations );
+
+	bounds.SetNum( 0 );
+	bounds.AssureSize( world->lightCullBounds.Num(), NULL );
+	for( int i = 0; i < world->lightDefs.Num() && i < bounds.Num(); i++ )
+	{
+		const idRenderLightLocal* def = world->lightDefs[i];
+		bounds[i] = ( def != NULL && def->references != NULL ) ? &def->globalLightBounds : NULL;
+	}
+	R_CullBenchmarkBounds( "lights", mvp, world->lightCullBounds, bounds.Ptr(), iterations );
+}
+
+/*
+===================
+idCullBoundsArray::idCullBoundsArray
+===================
+*/
+idCullBoundsArray::idCullBoundsArray()
+{
+	data = NULL;
+	num = 0;
+	stride = 0;
+}
+
+/*
+===================
+idCullBoundsArray::~idCullBoundsArray
+===================
+*/
+idCullBoundsArray::~idCullBoundsArray()
+{
+	Clear();
+}
+
+/*
+===================
+idCullBoundsArray::Clear
+===================
+*/
+void idCullBoundsArray::Clear()
+{
+	if( data != NULL )
+	{
+		Mem_Free( data );
+		data = NULL;
+	}
+	num = 0;
+	stride = 0;
+}
+
+/*
+===================
+idCullBoundsArray::Set
+===================
+*/
+void idCullBoundsArray::Set( int index, const idBounds& bounds )
+{
+	assert( index >= 0 );
+
+	if( index >= stride )
+	{
+		// grow every row, the padding stays zero so whole batches can always be read
+		const int newStride = ( Max( index + 1 + ( index >> 1 ), 64 ) + CULL_BOUNDS_BATCH_SIZE - 1 ) & ~( CULL_BOUNDS_BATCH_SIZE - 1 );
+		float* newData = ( float* )Mem_ClearedAlloc( 6 * newStride * sizeof( float ), TAG_RENDER );
+		if( data != NULL )
+		{
+			for( int row = 0; row < 6; row++ )
+			{
+				memcpy( newData + row * newStride, data + row * stride, num * sizeof( float ) );
+			}
+			Mem_Free( data );
+		}
+		data = newData;
+		stride = newStride;
+	}
+
+	data[0 * stride + index] = bounds[0][0];
+	data[1 * stride + index] = bounds[0][1];
+	data[2 * stride + index] = bounds[0][2];
+	data[3 * stride + index] = bounds[1][0];
+	data[4 * stride + index] = bounds[1][1];
+	data[5 * stride + index] = bounds[1][2];
+
+	num = Max( num, index + 1 );
+}
+
 /*
 ===================
 idRenderWorldLocal::idRenderWorldLocal
@@ -159,6 +365,9 @@ idRenderWorldLocal::idRenderWorldLocal()
 	interactionTable = 0;
 	interactionTableWidth = 0;
 	interactionTableHeight = 0;
+	sparseInteractions = false;
+
+	deferViewCulling = false;
 
 	for( int i = 0; i < decals.Num(); i++ )
 	{
@@ -1930,10 +2139,15 @@ void idRenderWorldLocal::GenerateAllInteractions()
 
 	// build the interaction table
 	// this will be dynamically resized if the entity / light counts grow too much
-	interactionTableWidth = entityDefs.Num() + 100;
-	interactionTableHeight = lightDefs.Num() + 100;
-	int	size =  interactionTableWidth * interactionTableHeight * sizeof( *interactionTable );
-	interactionTable = ( idInteraction** )R_ClearedStaticAlloc( size );
+	sparseInteractions = r_useSparseInteractionTable.GetBool();
+	int size = 0;
+	if( !sparseInteractions )
+	{
+		interactionTableWidth = entityDefs.Num() + 100;
+		interactionTableHeight = lightDefs.Num() + 100;
+		size = interactionTableWidth * interactionTableHeight * sizeof( *interactionTable );
+		interactionTable = ( idInteraction** )R_ClearedStaticAlloc( size );
+	}
 
 	tr.commandList->open();
 
@@ -1997,7 +2211,14 @@ void idRenderWorldLocal::GenerateAllInteractions()
 	int	msec = end - start;
 
 	common->Printf( "idRenderWorld::GenerateAllInteractions, msec = %i\n", msec );
-	common->Printf( "interactionTable size: %i bytes\n", size );
+	if( sparseInteractions )
+	{
+		common->Printf( "sparse interactionTable size: %i bytes for %i pairs\n", ( int )interactionHash.MemoryUsed(), interactionHash.Num() );
+	}
+	else
+	{
+		common->Printf( "interactionTable size: %i bytes\n", size );
+	}
 	common->Printf( "%i interactions take %i bytes\n", count, count * sizeof( idInteraction ) );
 
 	// entities flagged as noDynamicInteractions will no longer make any
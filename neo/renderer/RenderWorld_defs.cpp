@@ -186,6 +186,7 @@ void R_CreateEntityRefs( idRenderEntityLocal* entity )
 
 	// derive entity data
 	R_DeriveEntityData( entity );
+	entity->world->entityCullBounds.Set( entity->index, entity->globalReferenceBounds );
 
 	// bump the view count so we can tell if an
 	// area already has a reference
@@ -694,6 +695,7 @@ void R_CreateLightRefs( idRenderLightLocal* light )
 {
 	// derive light data
 	R_DeriveLightData( light );
+	light->world->lightCullBounds.Set( light->index, light->globalLightBounds );
 
 	// determine the areaNum for the light origin, which may let us
 	// cull the light if it is behind a closed door
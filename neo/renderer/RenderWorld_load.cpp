@@ -673,6 +673,11 @@ void idRenderWorldLocal::FreeDefs()
 		R_StaticFree( interactionTable );
 		interactionTable = NULL;
 	}
+	interactionHash.Clear();
+	sparseInteractions = false;
+
+	entityCullBounds.Clear();
+	lightCullBounds.Clear();
 
 	// free all lightDefs
 	for( int i = 0; i < lightDefs.Num(); i++ )
@@ -1045,6 +1050,7 @@ void idRenderWorldLocal::AddWorldModelEntities()
 		def->parms.shaderParms[3] = 1.0f;
 
 		R_DeriveEntityData( def );
+		entityCullBounds.Set( def->index, def->globalReferenceBounds );
 
 		portalArea_t* area = &portalAreas[i];
 		AddEntityRefToArea( def, area );
@@ -154,6 +154,43 @@ struct reusableOverlay_t
 
 struct portalStack_t;
 
+/*
+===============================================================================
+
+idCullBoundsArray
+
+Structure-of-arrays copy of world space bounds, indexed like entityDefs or lightDefs,
+so all of them can be culled with a single idRenderMatrix::CullBoundsToMVPBatch call.
+Entries of freed defs are left stale, callers only look at the entries of valid defs.
+
+===============================================================================
+*/
+class idCullBoundsArray
+{
+public:
+	idCullBoundsArray();
+	~idCullBoundsArray();
+
+	void					Clear();
+	void					Set( int index, const idBounds& bounds );
+
+	int						Num() const
+	{
+		return num;
+	}
+
+	// sets culled[i] for all Num() bounds and returns the number of culled bounds
+	int						CullToMVP( const idRenderMatrix& mvp, byte* culled, bool zeroToOne = false ) const
+	{
+		return idRenderMatrix::CullBoundsToMVPBatch( mvp, data, stride, num, culled, zeroToOne );
+	}
+
+private:
+	float* 					data;		// six rows of stride floats: min x, min y, min z, max x, max y, max z
+	int						num;
+	int						stride;
+};
+
 class idRenderWorldLocal : public idRenderWorld
 {
 public:
@@ -245,6 +282,10 @@ public:
 	idList<idRenderLightLocal*, TAG_LIGHT>			lightDefs;
 	idList<RenderEnvprobeLocal*, TAG_ENVPROBE>		envprobeDefs; // RB
 
+	// globalReferenceBounds and globalLightBounds, updated whenever the references are created
+	idCullBoundsArray		entityCullBounds;
+	idCullBoundsArray		lightCullBounds;
+
 	idBlockAlloc<areaReference_t, 1024> areaReferenceAllocator;
 	idBlockAlloc<idInteraction, 256>	interactionAllocator;
 
@@ -265,6 +306,41 @@ public:
 	int						interactionTableWidth;		// entityDefs
 	int						interactionTableHeight;		// lightDefs
 
+	// with r_useSparseInteractionTable the pairs are kept in a hash table instead,
+	// which only grows with the number of actual interactions
+	bool					sparseInteractions;
+	idInteractionTable		interactionHash;
+
+	bool					HasInteractionTable() const
+	{
+		return sparseInteractions || interactionTable != NULL;
+	}
+
+	idInteraction* 			GetInteraction( int lightIndex, int entityIndex ) const
+	{
+		if( sparseInteractions )
+		{
+			return interactionHash.Get( lightIndex, entityIndex );
+		}
+		if( interactionTable == NULL )
+		{
+			return NULL;
+		}
+		return interactionTable[ lightIndex * interactionTableWidth + entityIndex ];
+	}
+
+	void					SetInteraction( int lightIndex, int entityIndex, idInteraction* interaction )
+	{
+		if( sparseInteractions )
+		{
+			interactionHash.Set( lightIndex, entityIndex, interaction );
+		}
+		else
+		{
+			interactionTable[ lightIndex * interactionTableWidth + entityIndex ] = interaction;
+		}
+	}
+
 	bool					generateAllInteractionsCalled;
 
 	//-----------------------
@@ -314,6 +390,24 @@ public:
 	// RB end
 
 	void					AddAreaToView( int areaNum, const portalStack_t* ps );
+
+	// with r_useParallelPortalCulling the portal flood only records every portal chain
+	// into an area together with the entities and lights of that area, and the much more
+	// expensive culling against the chain planes runs on the job threads afterwards
+	struct viewCullTest_t
+	{
+		void* 					def;		// idRenderEntityLocal or idRenderLightLocal
+		int						chain;		// index into viewCullChains
+		bool					culled;
+	};
+
+	bool					deferViewCulling;
+	idList<portalStack_t, TAG_RENDER>	viewCullChains;		// copies of the portal stacks, next and p are not valid
+	idList<viewCullTest_t, TAG_RENDER>	entityCullTests;
+	idList<viewCullTest_t, TAG_RENDER>	lightCullTests;
+
+	void					CullViewEntitiesAndLights();
+
 	idScreenRect			ScreenRectFromWinding( const idWinding* w, const viewEntity_t* space );
 	bool					PortalIsFoggedOut( const portal_t* p );
 	void					FloodViewThroughArea_r( const idVec3& origin, int areaNum, const portalStack_t* ps );
@@ -390,5 +484,6 @@ static idInteraction* const INTERACTION_EMPTY = ( idInteraction* )1;
 
 void R_ListRenderLightDefs_f( const idCmdArgs& args );
 void R_ListRenderEntityDefs_f( const idCmdArgs& args );
+void R_CullBenchmark_f( const idCmdArgs& args );
 
 #endif /* !__RENDERWORLDLOCAL_H__ */
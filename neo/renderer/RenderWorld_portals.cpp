@@ -32,6 +32,8 @@ If you have questions concerning this license or the applicable additional terms
 
 #include "RenderCommon.h"
 
+idCVar r_useParallelPortalCulling( "r_useParallelPortalCulling", "1", CVAR_RENDERER | CVAR_BOOL, "cull the entities and lights of the visible areas against the portal chains with jobs" );
+
 // if we hit this many planes, we will just stop cropping the
 // view down, which is still correct, just conservative
 const int MAX_PORTAL_PLANES	= 20;
@@ -251,6 +253,16 @@ void idRenderWorldLocal::AddAreaViewEntities( int areaNum, const portalStack_t*
 			}
 		}
 
+		// the portal chain was recorded by AddAreaToView, test it later on the job threads
+		if( deferViewCulling )
+		{
+			viewCullTest_t& test = entityCullTests.Alloc();
+			test.def = entity;
+			test.chain = viewCullChains.Num() - 1;
+			test.culled = false;
+			continue;
+		}
+
 		// cull reference bounds
 		if( CullEntityByPortals( entity, ps ) )
 		{
@@ -386,6 +398,15 @@ void idRenderWorldLocal::AddAreaViewLights( int areaNum, const portalStack_t* ps
 			continue;
 		}
 
+		if( deferViewCulling )
+		{
+			viewCullTest_t& test = lightCullTests.Alloc();
+			test.def = light;
+			test.chain = viewCullChains.Num() - 1;
+			test.culled = false;
+			continue;
+		}
+
 		// cull frustum
 		if( CullLightByPortals( light, ps ) )
 		{
@@ -414,12 +435,134 @@ void idRenderWorldLocal::AddAreaToView( int areaNum, const portalStack_t* ps )
 	// mark the viewCount, so r_showPortals can display the considered portals
 	portalAreas[ areaNum ].viewCount = tr.viewCount;
 
+	if( deferViewCulling )
+	{
+		portalStack_t& chain = viewCullChains.Alloc();
+		chain = *ps;
+		chain.p = NULL;
+		chain.next = NULL;
+	}
+
 	// add the models and lights, using more precise culling to the planes
 	AddAreaViewEntities( areaNum, ps );
 	AddAreaViewLights( areaNum, ps );
 	AddAreaViewEnvprobes( areaNum, ps ); // RB
 }
 
+/*
+===================
+R_CullViewDefsByPortals
+===================
+*/
+static const int VIEW_CULL_MIN_TESTS_PER_JOB	= 32;
+static const int VIEW_CULL_MAX_JOBS				= 256;
+
+struct viewCullJob_t
+{
+	idRenderWorldLocal* 	world;
+	bool					lights;
+	int						first;
+	int						count;
+};
+
+static void R_CullViewDefsByPortals( viewCullJob_t* job )
+{
+	idRenderWorldLocal* world = job->world;
+	idList<idRenderWorldLocal::viewCullTest_t, TAG_RENDER>& tests = job->lights ? world->lightCullTests : world->entityCullTests;
+
+	for( int i = job->first; i < job->first + job->count; i++ )
+	{
+		idRenderWorldLocal::viewCullTest_t& test = tests[i];
+		const idRenderWorldLocal::portalStack_t* ps = &world->viewCullChains[test.chain];
+
+		if( job->lights )
+		{
+			test.culled = world->CullLightByPortals( static_cast<const idRenderLightLocal*>( test.def ), ps );
+		}
+		else
+		{
+			test.culled = world->CullEntityByPortals( static_cast<const idRenderEntityLocal*>( test.def ), ps );
+		}
+	}
+}
+
+REGISTER_PARALLEL_JOB( R_CullViewDefsByPortals, "R_CullViewDefsByPortals" );
+
+/*
+===================
+idRenderWorldLocal::CullViewEntitiesAndLights
+
+Runs the entity and light tests recorded during the portal flood, then creates the
+viewEntities and viewLights in the same order the serial flood would have.
+===================
+*/
+void idRenderWorldLocal::CullViewEntitiesAndLights()
+{
+	SCOPED_PROFILE_EVENT( "CullViewEntitiesAndLights" );
+
+	const int numTests = entityCullTests.Num() + lightCullTests.Num();
+	const int testsPerJob = Max( VIEW_CULL_MIN_TESTS_PER_JOB, ( numTests + VIEW_CULL_MAX_JOBS - 1 ) / VIEW_CULL_MAX_JOBS );
+
+	const int numEntityJobs = ( entityCullTests.Num() + testsPerJob - 1 ) / testsPerJob;
+	const int numLightJobs = ( lightCullTests.Num() + testsPerJob - 1 ) / testsPerJob;
+	const int numJobs = numEntityJobs + numLightJobs;
+
+	if( numJobs > 0 )
+	{
+		viewCullJob_t* jobs = ( viewCullJob_t* )R_FrameAlloc( numJobs * sizeof( jobs[0] ) );
+		for( int i = 0; i < numJobs; i++ )
+		{
+			const bool lights = ( i >= numEntityJobs );
+			const int numKindTests = lights ? lightCullTests.Num() : entityCullTests.Num();
+
+			jobs[i].world = this;
+			jobs[i].lights = lights;
+			jobs[i].first = ( lights ? i - numEntityJobs : i ) * testsPerJob;
+			jobs[i].count = Min( testsPerJob, numKindTests - jobs[i].first );
+		}
+
+		if( numJobs == 1 )
+		{
+			R_CullViewDefsByPortals( &jobs[0] );
+		}
+		else
+		{
+			for( int i = 0; i < numJobs; i++ )
+			{
+				tr.frontEndJobList->AddJob( ( jobRun_t )R_CullViewDefsByPortals, &jobs[i] );
+			}
+			tr.frontEndJobList->Submit();
+			tr.frontEndJobList->Wait();
+		}
+	}
+
+	for( int i = 0; i < entityCullTests.Num(); i++ )
+	{
+		const viewCullTest_t& test = entityCullTests[i];
+		if( test.culled )
+		{
+			continue;
+		}
+		viewEntity_t* vEnt = R_SetEntityDefViewEntity( static_cast<idRenderEntityLocal*>( test.def ) );
+		vEnt->scissorRect.Union( viewCullChains[test.chain].rect );
+	}
+
+	for( int i = 0; i < lightCullTests.Num(); i++ )
+	{
+		const viewCullTest_t& test = lightCullTests[i];
+		if( test.culled )
+		{
+			continue;
+		}
+		viewLight_t* vLight = R_SetLightDefViewLight( static_cast<idRenderLightLocal*>( test.def ) );
+		vLight->scissorRect.Union( viewCullChains[test.chain].rect );
+	}
+
+	viewCullChains.SetNum( 0 );
+	entityCullTests.SetNum( 0 );
+	lightCullTests.SetNum( 0 );
+}
+
 /*
 ===================
 idRenderWorldLocal::ScreenRectForWinding
@@ -787,6 +930,9 @@ void idRenderWorldLocal::FindViewLightsAndEntities()
 	// light-behind-door culling
 	BuildConnectedAreas();
 
+	// the flood below only records the portal chains, see CullViewEntitiesAndLights
+	deferViewCulling = r_useParallelPortalCulling.GetBool();
+
 	// flow through all the portals and add models / lights
 	if( r_singleArea.GetBool() )
 	{
@@ -819,6 +965,12 @@ void idRenderWorldLocal::FindViewLightsAndEntities()
 		// may have the viewOrigin in a solid/invalid area
 		FlowViewThroughPortals( tr.viewDef->renderView.vieworg, 5, tr.viewDef->frustums[FRUSTUM_PRIMARY] );
 	}
+
+	if( deferViewCulling )
+	{
+		CullViewEntitiesAndLights();
+		deferViewCulling = false;
+	}
 }
 
 /*
@@ -46,6 +46,8 @@ extern idCVar r_forceShadowCaps;
 extern idCVar r_useShadowPreciseInsideTest;
 
 idCVar r_useAreasConnectedForShadowCulling( "r_useAreasConnectedForShadowCulling", "2", CVAR_RENDERER | CVAR_INTEGER, "cull entities cut off by doors" );
+extern idCVar r_useBatchBoundsCulling;
+
 idCVar r_useParallelAddLights( "r_useParallelAddLights", "1", CVAR_RENDERER | CVAR_BOOL | CVAR_NOCHEAT, "aadd all lights in parallel with jobs" );
 
 /*
@@ -472,8 +474,6 @@ static void R_AddSingleLight( viewLight_t* vLight )
 	// this bool array will be set true whenever the entity will visibly interact with the light
 	vLight->entityInteractionState = ( byte* )R_ClearedFrameAlloc( light->world->entityDefs.Num() * sizeof( vLight->entityInteractionState[0] ), FRAME_ALLOC_INTERACTION_STATE );
 
-	idInteraction** const interactionTableRow = light->world->interactionTable + light->index * light->world->interactionTableWidth;
-
 	for( areaReference_t* lref = light->references; lref != NULL; lref = lref->ownerNext )
 	{
 		portalArea_t* area = lref->area;
@@ -503,8 +503,8 @@ static void R_AddSingleLight( viewLight_t* vLight )
 
 			// The table is updated at interaction::AllocAndLink() and interaction::UnlinkAndFree()
 
-			// TODO(Stephen): interactionTableRow is null if renderDef is used in a gui.sub
-			const idInteraction* inter = interactionTableRow[ edef->index ];
+			// TODO(Stephen): there is no interaction table if renderDef is used in a gui.sub
+			const idInteraction* inter = light->world->GetInteraction( light->index, edef->index );
 
 			const renderEntity_t& eParms = edef->parms;
 			const idRenderModel* eModel = eParms.hModel;
@@ -626,6 +626,26 @@ static void R_AddSingleLight( viewLight_t* vLight )
 
 REGISTER_PARALLEL_JOB( R_AddSingleLight, "R_AddSingleLight" );
 
+/*
+=================
+R_LightBoundsCulled
+
+Marks the light for removal without running R_AddSingleLight if the batch culling rejected it.
+=================
+*/
+static bool R_LightBoundsCulled( viewLight_t* vLight, const idRenderWorldLocal* world, const byte* culled )
+{
+	const idRenderLightLocal* light = vLight->lightDef;
+	if( culled == NULL || light->world != world || light->index >= world->lightCullBounds.Num() || !culled[light->index] )
+	{
+		return false;
+	}
+
+	vLight->removeFromList = true;
+	vLight->shadowOnlyViewEntities = NULL;
+	return true;
+}
+
 /*
 =================
 R_AddLights
@@ -635,6 +655,20 @@ void R_AddLights()
 {
 	SCOPED_PROFILE_EVENT( "R_AddLights" );
 
+	//-------------------------------------------------
+	// lights with their world bounds outside the view frustum would be culled by the
+	// light scissor in R_AddSingleLight, so drop them with one batch test up front
+	//-------------------------------------------------
+
+	const byte* culled = NULL;
+	const idRenderWorldLocal* world = static_cast<const idRenderWorldLocal*>( tr.viewDef->renderWorld );
+	if( r_useBatchBoundsCulling.GetBool() && r_useLightScissors.GetInteger() != 0 && world != NULL )
+	{
+		byte* lightCulled = ( byte* )R_FrameAlloc( world->lightCullBounds.Num() + 1 );
+		world->lightCullBounds.CullToMVP( tr.viewDef->worldSpace.mvp, lightCulled );
+		culled = lightCulled;
+	}
+
 	//-------------------------------------------------
 	// check each light individually, possibly in parallel
 	//-------------------------------------------------
@@ -643,6 +677,10 @@ void R_AddLights()
 	{
 		for( viewLight_t* vLight = tr.viewDef->viewLights; vLight != NULL; vLight = vLight->next )
 		{
+			if( R_LightBoundsCulled( vLight, world, culled ) )
+			{
+				continue;
+			}
 			tr.frontEndJobList->AddJob( ( jobRun_t )R_AddSingleLight, vLight );
 		}
 		tr.frontEndJobList->Submit();
@@ -652,6 +690,10 @@ void R_AddLights()
 	{
 		for( viewLight_t* vLight = tr.viewDef->viewLights; vLight != NULL; vLight = vLight->next )
 		{
+			if( R_LightBoundsCulled( vLight, world, culled ) )
+			{
+				continue;
+			}
 			R_AddSingleLight( vLight );
 		}
 	}
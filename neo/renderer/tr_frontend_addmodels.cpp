@@ -44,6 +44,7 @@ If you have questions concerning this license or the applicable additional terms
 idCVar r_skipStaticShadows( "r_skipStaticShadows", "0", CVAR_RENDERER | CVAR_BOOL, "skip static shadows" );
 idCVar r_skipDynamicShadows( "r_skipDynamicShadows", "0", CVAR_RENDERER | CVAR_BOOL, "skip dynamic shadows" );
 idCVar r_useParallelAddModels( "r_useParallelAddModels", "1", CVAR_RENDERER | CVAR_BOOL | CVAR_NOCHEAT, "add all models in parallel with jobs" );
+idCVar r_useBatchBoundsCulling( "r_useBatchBoundsCulling", "1", CVAR_RENDERER | CVAR_BOOL, "cull the world bounds of all entities and lights to the view frustum with one SIMD batch before adding them" );
 idCVar r_useParallelAddShadows( "r_useParallelAddShadows", "1", CVAR_RENDERER | CVAR_INTEGER | CVAR_NOCHEAT, "0 = off, 1 = threaded", 0, 1 );
 idCVar r_forceShadowCaps( "r_forceShadowCaps", "0", CVAR_RENDERER | CVAR_BOOL, "0 = skip rendering shadow caps if view is outside shadow volume, 1 = always render shadow caps" );
 // RB begin
@@ -337,7 +338,7 @@ void R_AddSingleModel( viewEntity_t* vEntity )
 	const float znear = ( viewDef->renderView.cramZNear ) ? ( r_znear.GetFloat() * 0.25f ) : r_znear.GetFloat();
 
 	// if the entity wasn't seen through a portal chain, it was added just for light shadows
-	const bool modelIsVisible = !vEntity->scissorRect.IsEmpty();
+	const bool modelIsVisible = !vEntity->scissorRect.IsEmpty() && !vEntity->boundsCulled;
 	const bool addInteractions = modelIsVisible && ( !viewDef->isXraySubview || entityDef->parms.xrayIndex == 2 );
 	const int entityIndex = entityDef->index;
 
@@ -371,7 +372,7 @@ void R_AddSingleModel( viewEntity_t* vEntity )
 				if( vLight->entityInteractionState[entityIndex] == viewLight_t::INTERACTION_YES )
 				{
 					contactedLights[numContactedLights] = vLight;
-					staticInteractions[numContactedLights] = world->interactionTable[vLight->lightDef->index * world->interactionTableWidth + entityIndex];
+					staticInteractions[numContactedLights] = world->GetInteraction( vLight->lightDef->index, entityIndex );
 					if( ++numContactedLights == MAX_CONTACTED_LIGHTS )
 					{
 						break;
@@ -427,7 +428,7 @@ void R_AddSingleModel( viewEntity_t* vEntity )
 				}
 			}
 			contactedLights[numContactedLights] = vLight;
-			staticInteractions[numContactedLights] = world->interactionTable[vLight->lightDef->index * world->interactionTableWidth + entityIndex];
+			staticInteractions[numContactedLights] = world->GetInteraction( vLight->lightDef->index, entityIndex );
 			if( ++numContactedLights == MAX_CONTACTED_LIGHTS )
 			{
 				break;
@@ -1208,6 +1209,33 @@ void R_AddModels()
 	// RB: already done in R_FillMaskedOcclusionBufferWithModels
 	// tr.viewDef->viewEntitys = R_SortViewEntities( tr.viewDef->viewEntitys );
 
+	//-------------------------------------------------
+	// An entity with its world bounds outside the view frustum can't have
+	// any visible surfaces, so it only needs to be considered for shadows.
+	//-------------------------------------------------
+
+	if( r_useBatchBoundsCulling.GetBool() && tr.viewDef->renderWorld != NULL )
+	{
+		const idRenderWorldLocal* world = static_cast<const idRenderWorldLocal*>( tr.viewDef->renderWorld );
+		const idCullBoundsArray& cullBounds = world->entityCullBounds;
+
+		byte* culled = ( byte* )R_FrameAlloc( cullBounds.Num() + 1 );
+		cullBounds.CullToMVP( tr.viewDef->worldSpace.mvp, culled );
+
+		for( viewEntity_t* vEntity = tr.viewDef->viewEntitys; vEntity != NULL; vEntity = vEntity->next )
+		{
+			const idRenderEntityLocal* def = vEntity->entityDef;
+
+			// depth hacked entities are drawn with a different projection
+			if( def->world != world || def->index >= cullBounds.Num() || def->parms.weaponDepthHack || def->parms.modelDepthHack != 0.0f
+					|| ( def->parms.hModel != NULL && def->parms.hModel->DepthHack() != 0.0f ) )
+			{
+				continue;
+			}
+			vEntity->boundsCulled = ( culled[def->index] != 0 );
+		}
+	}
+
 	//-------------------------------------------------
 	// Go through each view entity that is either visible to the view, or to
 	// any light that intersects the view (for shadows).
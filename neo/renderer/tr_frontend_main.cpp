@@ -42,6 +42,7 @@ FRAME MEMORY ALLOCATION
 
 static const unsigned int FRAME_ALLOC_ALIGNMENT = 128;
 static const unsigned int MAX_FRAME_MEMORY = 64 * 1024 * 1024;	// larger so that we can noclip on PC for dev purposes
+static const int FRAME_ARENA_CHUNK_SIZE = 64 * 1024;
 
 idFrameData		smpFrameData[NUM_FRAME_DATA];
 idFrameData* 	frameData;
@@ -54,6 +55,12 @@ unsigned int	smpFrame;
 	int frameHighWaterTypeCount[FRAME_ALLOC_MAX];
 #endif
 
+static ID_TLS					frameArenaThread;		// arena index + 1, 0 until the thread first allocates
+static idSysInterlockedInteger	numFrameArenaThreads;
+static uintptr_t				frameArenaThreadIds[MAX_FRAME_ARENAS];
+static int						frameArenaLastAllocated[MAX_FRAME_ARENAS];
+static int						frameArenaHighWater[MAX_FRAME_ARENAS];
+
 /*
 ====================
 R_ToggleSmpFrame
@@ -74,6 +81,13 @@ void R_ToggleSmpFrame()
 #endif
 	}
 
+	// update the per thread highwater marks
+	for( int i = 0; i < MAX_FRAME_ARENAS; i++ )
+	{
+		frameArenaLastAllocated[i] = frameData->arenas[i].allocated;
+		frameArenaHighWater[i] = Max( frameArenaHighWater[i], frameData->arenas[i].allocated );
+	}
+
 	// switch to the next frame
 	smpFrame++;
 	frameData = &smpFrameData[smpFrame % NUM_FRAME_DATA];
@@ -87,6 +101,9 @@ void R_ToggleSmpFrame()
 	frameData->frameMemoryAllocated.SetValue( bytesNeededForAlignment );
 	frameData->frameMemoryUsed.SetValue( 0 );
 
+	// every thread will grab a new chunk on its next allocation
+	memset( frameData->arenas, 0, sizeof( frameData->arenas ) );
+
 #if defined( TRACK_FRAME_ALLOCS )
 	for( int i = 0; i < FRAME_ALLOC_MAX; i++ )
 	{
@@ -135,6 +152,47 @@ void R_InitFrameData()
 	R_ToggleSmpFrame();
 }
 
+/*
+================
+R_FrameArenaIndex
+
+Returns the arena of the calling thread, or -1 when all arenas are taken.
+================
+*/
+static int R_FrameArenaIndex()
+{
+	int index = ( int )frameArenaThread - 1;
+	if( index < 0 )
+	{
+		index = numFrameArenaThreads.Increment() - 1;
+		if( index < MAX_FRAME_ARENAS )
+		{
+			frameArenaThreadIds[index] = Sys_GetCurrentThreadID();
+		}
+		frameArenaThread = index + 1;
+	}
+	return ( index < MAX_FRAME_ARENAS ) ? index : -1;
+}
+
+/*
+================
+R_FrameAllocShared
+
+Allocates from the frame memory shared by all threads.
+================
+*/
+static byte* R_FrameAllocShared( int bytes )
+{
+	// thread safe add
+	int	end = frameData->frameMemoryAllocated.Add( bytes );
+	if( end > MAX_FRAME_MEMORY )
+	{
+		idLib::Error( "R_FrameAlloc ran out of memory. bytes = %d, end = %d, highWaterAllocated = %d\n", bytes, end, frameData->highWaterAllocated );
+	}
+
+	return frameData->frameMemory + end - bytes;
+}
+
 /*
 ================
 R_FrameAlloc
@@ -149,6 +207,10 @@ All temporary data, like dynamic tesselations
 and local spaces are allocated here.
 
 All memory is cache-line-cleared for the best performance.
+
+Small allocations come from a chunk owned by the calling
+thread so the parallel front end jobs don't all hammer the
+same interlocked counter.
 ================
 */
 void* R_FrameAlloc( int bytes, frameAllocType_t type )
@@ -160,14 +222,32 @@ void* R_FrameAlloc( int bytes, frameAllocType_t type )
 
 	bytes = ( bytes + FRAME_ALLOC_ALIGNMENT - 1 ) & ~( FRAME_ALLOC_ALIGNMENT - 1 );
 
-	// thread safe add
-	int	end = frameData->frameMemoryAllocated.Add( bytes );
-	if( end > MAX_FRAME_MEMORY )
+	byte* ptr;
+	const int arenaIndex = R_FrameArenaIndex();
+	if( arenaIndex >= 0 )
 	{
-		idLib::Error( "R_FrameAlloc ran out of memory. bytes = %d, end = %d, highWaterAllocated = %d\n", bytes, end, frameData->highWaterAllocated );
+		frameArena_t& arena = frameData->arenas[arenaIndex];
+		if( bytes <= FRAME_ARENA_CHUNK_SIZE / 4 )
+		{
+			if( arena.used + bytes > arena.size )
+			{
+				arena.memory = R_FrameAllocShared( FRAME_ARENA_CHUNK_SIZE );
+				arena.used = 0;
+				arena.size = FRAME_ARENA_CHUNK_SIZE;
+			}
+			ptr = arena.memory + arena.used;
+			arena.used += bytes;
+		}
+		else
+		{
+			ptr = R_FrameAllocShared( bytes );
+		}
+		arena.allocated += bytes;
+	}
+	else
+	{
+		ptr = R_FrameAllocShared( bytes );
 	}
-
-	byte* ptr = frameData->frameMemory + end - bytes;
 
 	// cache line clear the memory
 	for( int offset = 0; offset < bytes; offset += CACHE_LINE_SIZE )
@@ -189,6 +269,24 @@ void* R_ClearedFrameAlloc( int bytes, frameAllocType_t type )
 	return R_FrameAlloc( bytes, type );
 }
 
+/*
+==================
+R_PrintFrameArenas
+==================
+*/
+void R_PrintFrameArenas()
+{
+	const int numArenas = Min( numFrameArenaThreads.GetValue(), MAX_FRAME_ARENAS );
+	for( int i = 0; i < numArenas; i++ )
+	{
+		common->Printf( "  thread %llx: %i (%i)\n", ( unsigned long long )frameArenaThreadIds[i], frameArenaLastAllocated[i], frameArenaHighWater[i] );
+	}
+	if( numFrameArenaThreads.GetValue() > MAX_FRAME_ARENAS )
+	{
+		common->Printf( "  %i threads without an arena\n", numFrameArenaThreads.GetValue() - MAX_FRAME_ARENAS );
+	}
+}
+
 /*
 ==========================================================================================
 
@@ -247,116 +345,248 @@ FONT-END RENDERING
 ==========================================================================================
 */
 
+idCVar r_sortDrawSurfsParallel( "r_sortDrawSurfsParallel", "4096", CVAR_RENDERER | CVAR_INTEGER, "radix sort draw surface lists of at least this many surfaces on the job threads, 0 = never" );
+
+static const int SORT_RADIX_BITS		= 8;
+static const int SORT_RADIX_SIZE		= 1 << SORT_RADIX_BITS;
+static const int SORT_KEY_BITS			= 48;		// 32 bits sort value, 16 bits depth
+static const int SORT_NUM_PASSES		= SORT_KEY_BITS / SORT_RADIX_BITS;
+static const int SORT_MIN_CHUNK_SIZE	= 1024;
+static const int SORT_MAX_CHUNKS		= 64;
+
+compile_time_assert( SORT_KEY_BITS % SORT_RADIX_BITS == 0 );
+
+struct drawSurfSortKey_t
+{
+	uint64					key;
+	drawSurf_t* 			surf;
+};
+
+struct drawSurfSortJob_t
+{
+	drawSurf_t** 			drawSurfs;
+	const drawSurfSortKey_t* src;
+	drawSurfSortKey_t* 		dst;
+	int						first;
+	int						count;
+	int						shift;
+	int* 					passCounts;		// SORT_NUM_PASSES * SORT_RADIX_SIZE digit counts of the chunk when the keys are built
+	int* 					offsets;		// SORT_RADIX_SIZE digit counts, turned into output offsets before scattering
+};
+
 /*
 =================
-R_SortDrawSurfs
+R_BuildDrawSurfSortKeys
+
+Sort the draw surfs based on:
+1. sort value (smallest first)
+2. depth (largest first)
+3. the order they were added in
+
+The keys are inverted, so the radix sort runs ascending and its stability takes care of 3.
 =================
 */
-static void R_SortDrawSurfs( drawSurf_t** drawSurfs, const int numDrawSurfs )
+static void R_BuildDrawSurfSortKeys( drawSurfSortJob_t* job )
 {
-#if 1
+	memset( job->passCounts, 0, SORT_NUM_PASSES * SORT_RADIX_SIZE * sizeof( job->passCounts[0] ) );
 
-	uint64* indices = ( uint64* ) _alloca16( numDrawSurfs * sizeof( indices[0] ) );
-
-	// sort the draw surfs based on:
-	// 1. sort value (largest first)
-	// 2. depth (smallest first)
-	// 3. index (largest first)
-	assert( numDrawSurfs <= 0xFFFF );
-	for( int i = 0; i < numDrawSurfs; i++ )
+	for( int i = job->first; i < job->first + job->count; i++ )
 	{
-		float sort = SS_POST_PROCESS - drawSurfs[i]->sort;
+		drawSurf_t* surf = job->drawSurfs[i];
+
+		float sort = SS_POST_PROCESS - surf->sort;
 		assert( sort >= 0.0f );
 
 		uint64 dist = 0;
-		if( drawSurfs[i]->frontEndGeo != NULL )
+		if( surf->frontEndGeo != NULL )
 		{
 			float min = 0.0f;
 			float max = 1.0f;
-			idRenderMatrix::DepthBoundsForBounds( min, max, drawSurfs[i]->space->mvp, drawSurfs[i]->frontEndGeo->bounds );
+			idRenderMatrix::DepthBoundsForBounds( min, max, surf->space->mvp, surf->frontEndGeo->bounds );
 			dist = idMath::Ftoui16( min * 0xFFFF );
 		}
 
-		indices[i] = ( ( numDrawSurfs - i ) & 0xFFFF ) | ( dist << 16 ) | ( ( uint64 )( *( uint32* )&sort ) << 32 );
+		const uint64 key = ( ~( dist | ( ( uint64 )( *( uint32* )&sort ) << 16 ) ) ) & ( ( 1ULL << SORT_KEY_BITS ) - 1 );
+
+		job->dst[i].key = key;
+		job->dst[i].surf = surf;
+
+		for( int pass = 0; pass < SORT_NUM_PASSES; pass++ )
+		{
+			job->passCounts[pass * SORT_RADIX_SIZE + ( ( key >> ( pass * SORT_RADIX_BITS ) ) & ( SORT_RADIX_SIZE - 1 ) )]++;
+		}
+	}
+}
+
+REGISTER_PARALLEL_JOB( R_BuildDrawSurfSortKeys, "R_BuildDrawSurfSortKeys" );
+
+/*
+=================
+R_CountDrawSurfSortKeys
+=================
+*/
+static void R_CountDrawSurfSortKeys( drawSurfSortJob_t* job )
+{
+	memset( job->offsets, 0, SORT_RADIX_SIZE * sizeof( job->offsets[0] ) );
+
+	for( int i = job->first; i < job->first + job->count; i++ )
+	{
+		job->offsets[( job->src[i].key >> job->shift ) & ( SORT_RADIX_SIZE - 1 )]++;
 	}
+}
 
-	const int64 MAX_LEVELS = 128;
-	int64 lo[MAX_LEVELS];
-	int64 hi[MAX_LEVELS];
+REGISTER_PARALLEL_JOB( R_CountDrawSurfSortKeys, "R_CountDrawSurfSortKeys" );
 
-	// Keep the top of the stack in registers to avoid load-hit-stores.
-	int64 st_lo = 0;
-	int64 st_hi = numDrawSurfs - 1;
-	int64 level = 0;
+/*
+=================
+R_ScatterDrawSurfSortKeys
+=================
+*/
+static void R_ScatterDrawSurfSortKeys( drawSurfSortJob_t* job )
+{
+	for( int i = job->first; i < job->first + job->count; i++ )
+	{
+		const drawSurfSortKey_t& key = job->src[i];
+		job->dst[job->offsets[( key.key >> job->shift ) & ( SORT_RADIX_SIZE - 1 )]++] = key;
+	}
+}
 
-	for( ; ; )
+REGISTER_PARALLEL_JOB( R_ScatterDrawSurfSortKeys, "R_ScatterDrawSurfSortKeys" );
+
+/*
+=================
+R_RunDrawSurfSortJobs
+=================
+*/
+static void R_RunDrawSurfSortJobs( void ( *function )( drawSurfSortJob_t* ), drawSurfSortJob_t* jobs, const int numJobs )
+{
+	if( numJobs == 1 )
 	{
-		int64 i = st_lo;
-		int64 j = st_hi;
-		if( j - i >= 4 && level < MAX_LEVELS - 1 )
+		function( &jobs[0] );
+		return;
+	}
+
+	for( int i = 0; i < numJobs; i++ )
+	{
+		tr.frontEndJobList->AddJob( ( jobRun_t )function, &jobs[i] );
+	}
+	tr.frontEndJobList->Submit();
+	tr.frontEndJobList->Wait();
+}
+
+/*
+=================
+R_SortDrawSurfs
+
+LSD radix sort over 48 bit keys that carry the surface pointer along, so there
+is no limit on the number of surfaces. Large lists are split into chunks that
+build, count and scatter their keys on the job threads. Each chunk scatters
+behind the same digits of all previous chunks, which keeps the sort stable.
+=================
+*/
+static void R_SortDrawSurfs( drawSurf_t** drawSurfs, const int numDrawSurfs )
+{
+#if 1
+
+	if( numDrawSurfs <= 1 )
+	{
+		return;
+	}
+
+	const uint64 startTime = Sys_Microseconds();
+
+	int numChunks = 1;
+	if( r_sortDrawSurfsParallel.GetInteger() > 0 && numDrawSurfs >= r_sortDrawSurfsParallel.GetInteger() )
+	{
+		numChunks = idMath::ClampInt( 1, SORT_MAX_CHUNKS, numDrawSurfs / SORT_MIN_CHUNK_SIZE );
+	}
+
+	drawSurfSortKey_t* keys = ( drawSurfSortKey_t* )R_FrameAlloc( numDrawSurfs * sizeof( keys[0] ), FRAME_ALLOC_DRAW_SURFACE_POINTER );
+	drawSurfSortKey_t* temp = ( drawSurfSortKey_t* )R_FrameAlloc( numDrawSurfs * sizeof( temp[0] ), FRAME_ALLOC_DRAW_SURFACE_POINTER );
+	int* counts = ( int* )R_FrameAlloc( numChunks * ( SORT_NUM_PASSES + 1 ) * SORT_RADIX_SIZE * sizeof( counts[0] ) );
+
+	drawSurfSortJob_t jobs[SORT_MAX_CHUNKS];
+	const int chunkSize = ( numDrawSurfs + numChunks - 1 ) / numChunks;
+	for( int c = 0; c < numChunks; c++ )
+	{
+		drawSurfSortJob_t& job = jobs[c];
+		job.drawSurfs = drawSurfs;
+		job.src = NULL;
+		job.dst = keys;
+		job.first = c * chunkSize;
+		job.count = Min( chunkSize, numDrawSurfs - job.first );
+		job.shift = 0;
+		job.passCounts = counts + c * ( SORT_NUM_PASSES + 1 ) * SORT_RADIX_SIZE;
+		job.offsets = job.passCounts + SORT_NUM_PASSES * SORT_RADIX_SIZE;
+	}
+
+	R_RunDrawSurfSortJobs( R_BuildDrawSurfSortKeys, jobs, numChunks );
+
+	drawSurfSortKey_t* src = keys;
+	drawSurfSortKey_t* dst = temp;
+	bool keysMoved = false;
+
+	for( int pass = 0; pass < SORT_NUM_PASSES; pass++ )
+	{
+		const int shift = pass * SORT_RADIX_BITS;
+
+		// skip the pass if all keys share the same digit, which is common for the
+		// high bits of the sort value and for views without much depth range
+		const int digit = ( keys[0].key >> shift ) & ( SORT_RADIX_SIZE - 1 );
+		int sameDigit = 0;
+		for( int c = 0; c < numChunks; c++ )
 		{
-			uint64 pivot = indices[( i + j ) / 2];
-			do
-			{
-				while( indices[i] > pivot )
-				{
-					i++;
-				}
-				while( indices[j] < pivot )
-				{
-					j--;
-				}
-				if( i > j )
-				{
-					break;
-				}
-				uint64 h = indices[i];
-				indices[i] = indices[j];
-				indices[j] = h;
-			}
-			while( ++i <= --j );
+			sameDigit += jobs[c].passCounts[pass * SORT_RADIX_SIZE + digit];
+		}
+		if( sameDigit == numDrawSurfs )
+		{
+			continue;
+		}
 
-			// No need for these iterations because we are always sorting unique values.
-			//while ( indices[j] == pivot && st_lo < j ) j--;
-			//while ( indices[i] == pivot && i < st_hi ) i++;
+		for( int c = 0; c < numChunks; c++ )
+		{
+			jobs[c].src = src;
+			jobs[c].dst = dst;
+			jobs[c].shift = shift;
+		}
 
-			assert( level < MAX_LEVELS - 1 );
-			lo[level] = i;
-			hi[level] = st_hi;
-			st_hi = j;
-			level++;
+		// the counts from building the keys are still valid until the keys are moved
+		if( keysMoved )
+		{
+			R_RunDrawSurfSortJobs( R_CountDrawSurfSortKeys, jobs, numChunks );
 		}
 		else
 		{
-			for( ; i < j; j-- )
+			for( int c = 0; c < numChunks; c++ )
 			{
-				int64 m = i;
-				for( int64 k = i + 1; k <= j; k++ )
-				{
-					if( indices[k] < indices[m] )
-					{
-						m = k;
-					}
-				}
-				uint64 h = indices[m];
-				indices[m] = indices[j];
-				indices[j] = h;
+				memcpy( jobs[c].offsets, jobs[c].passCounts + pass * SORT_RADIX_SIZE, SORT_RADIX_SIZE * sizeof( jobs[c].offsets[0] ) );
 			}
-			if( --level < 0 )
+		}
+
+		int offset = 0;
+		for( int d = 0; d < SORT_RADIX_SIZE; d++ )
+		{
+			for( int c = 0; c < numChunks; c++ )
 			{
-				break;
+				const int count = jobs[c].offsets[d];
+				jobs[c].offsets[d] = offset;
+				offset += count;
 			}
-			st_lo = lo[level];
-			st_hi = hi[level];
 		}
+
+		R_RunDrawSurfSortJobs( R_ScatterDrawSurfSortKeys, jobs, numChunks );
+
+		SwapValues( src, dst );
+		keysMoved = true;
 	}
 
-	drawSurf_t** newDrawSurfs = ( drawSurf_t** ) indices;
 	for( int i = 0; i < numDrawSurfs; i++ )
 	{
-		newDrawSurfs[i] = drawSurfs[numDrawSurfs - ( indices[i] & 0xFFFF )];
+		drawSurfs[i] = src[i].surf;
 	}
-	memcpy( drawSurfs, newDrawSurfs, numDrawSurfs * sizeof( drawSurfs[0] ) );
+
+	tr.pc.c_sortedDrawSurfs += numDrawSurfs;
+	tr.pc.sortMicroSec += Sys_Microseconds() - startTime;
 
 #else
 
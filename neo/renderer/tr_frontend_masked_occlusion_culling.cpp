@@ -42,6 +42,56 @@ If you have questions concerning this license or the applicable additional terms
 
 static const float CHECK_BOUNDS_EPSILON = 1.0f;
 
+#if defined(USE_INTRINSICS_SSE)
+
+idCVar r_useParallelMaskedOcclusionCulling( "r_useParallelMaskedOcclusionCulling", "1", CVAR_RENDERER | CVAR_BOOL, "bin the occluder triangles into screen tiles and rasterize the tiles on the job threads" );
+idCVar r_mocOccluderMinScreenSize( "r_mocOccluderMinScreenSize", "0.001", CVAR_RENDERER | CVAR_FLOAT, "occluder surfaces covering less than this fraction of the screen are not rasterized" );
+
+static const int MOC_BINS_WIDE			= 4;
+static const int MOC_BINS_HIGH			= 4;
+static const int MOC_NUM_BINS			= MOC_BINS_WIDE * MOC_BINS_HIGH;
+static const int MOC_BINNING_JOBS		= 8;		// binning jobs per round, each with its own set of bins
+static const int MOC_BIN_TRIS			= 1024;		// capacity of a single bin
+static const int MOC_CHUNK_TRIS			= 32;		// triangles a binning job takes at once
+static const int MOC_MAX_CLIPPED_TRIS	= 6;		// a triangle clipped by the frustum planes becomes up to 6 triangles
+static const int MOC_BINNED_TRI_FLOATS	= 3 * 3;	// x, y, w of three vertices
+
+struct mocOccluder_t
+{
+	const srfTriangles_t*	tri;
+	idRenderMatrix			mvp;		// transposed for the MOC library
+};
+
+struct mocChunk_t
+{
+	int						occluder;
+	int						firstTri;
+	int						numTris;
+};
+
+struct mocBinningJob_t
+{
+	const mocOccluder_t*	occluders;
+	const mocChunk_t*		chunks;
+	int						numChunks;
+	idSysInterlockedInteger* nextChunk;
+	MaskedOcclusionCulling::TriList	triLists[MOC_NUM_BINS];
+};
+
+struct mocRasterJob_t
+{
+	const mocBinningJob_t*	binningJobs;
+	int						bin;
+	MaskedOcclusionCulling::ScissorRect	rect;
+	int						numTris;
+};
+
+static idList<mocOccluder_t, TAG_RENDER>	mocOccluders;
+static idList<mocChunk_t, TAG_RENDER>		mocChunks;
+static float*								mocBinStorage = NULL;
+
+#endif
+
 /*
 ==================
 R_SortViewEntities
@@ -104,19 +154,16 @@ viewEntity_t* R_SortViewEntities( viewEntity_t* vEntities )
 
 /*
 ===================
-R_RenderSingleModel
-
-May be run in parallel.
+R_AddModelOccluders
 
-Here is where dynamic models actually get instantiated, and necessary
-interaction surfaces get created. This is all done on a sort-by-model
-basis to keep source data in cache (most likely L2) as any interactions
-and shadows are generated, since dynamic models will typically be lit by
-two or more lights.
+Here is where dynamic models actually get instantiated, and the surfaces
+that should be rasterized into the masked occlusion buffer are added to
+the occluder list. Surfaces that cover only a small part of the screen
+hide next to nothing and are skipped.
 ===================
 */
 #if defined(USE_INTRINSICS_SSE)
-void R_RenderSingleModel( viewEntity_t* vEntity )
+static void R_AddModelOccluders( viewEntity_t* vEntity )
 {
 	// we will add all interaction surfs here, to be chained to the lights in later serial code
 	vEntity->drawSurfs = NULL;
@@ -193,6 +240,8 @@ void R_RenderSingleModel( viewEntity_t* vEntity )
 
 	extern idCVar r_lodMaterialDistance;
 
+	const float minScreenSize = r_mocOccluderMinScreenSize.GetFloat();
+
 	//---------------------------
 	// add all the model surfaces
 	//---------------------------
@@ -364,20 +413,27 @@ void R_RenderSingleModel( viewEntity_t* vEntity )
 			// render the BSP area surfaces and from static model entities only the occlusion surfaces to keep the tris count at minimum
 			if( model->IsStaticWorldModel() || ( shader->IsOccluder() && !gpuSkinned ) )
 			{
+				if( minScreenSize > 0.0f )
+				{
+					idBounds projected;
+					idRenderMatrix::ProjectedBounds( projected, vEntity->unjitteredMVP, tri->bounds );
+					if( ( projected[1].x - projected[0].x ) * ( projected[1].y - projected[0].y ) < minScreenSize )
+					{
+						tr.pc.c_mocSkippedOccluders++;
+						continue;
+					}
+				}
+
+				tr.pc.c_mocOccluders++;
 				tr.pc.c_mocIndexes += tri->numIndexes;
-				tr.pc.c_mocVerts += tri->numIndexes;
+				tr.pc.c_mocVerts += tri->numVerts;
 
+				// the MOC verts are usually precomputed in the .bmodel or .bproc
 				R_CreateMaskedOcclusionCullingTris( tri );
 
-				idRenderMatrix mvp;
-				idRenderMatrix::Transpose( vEntity->unjitteredMVP, mvp );
-
-#if MOC_MULTITHREADED
-				tr.maskedOcclusionThreaded->SetMatrix( ( float* )&mvp[0][0] );
-				tr.maskedOcclusionThreaded->RenderTriangles( tri->mocVerts->ToFloatPtr(), tri->mocIndexes, tri->numIndexes / 3, MaskedOcclusionCulling::BACKFACE_CCW, MaskedOcclusionCulling::CLIP_PLANE_ALL );
-#else
-				tr.maskedOcclusionCulling->RenderTriangles( tri->mocVerts->ToFloatPtr(), tri->mocIndexes, tri->numIndexes / 3, ( float* )&mvp[0][0], MaskedOcclusionCulling::BACKFACE_CCW, MaskedOcclusionCulling::CLIP_PLANE_ALL, MaskedOcclusionCulling::VertexLayout( 16, 4, 8 ) );
-#endif
+				mocOccluder_t& occluder = mocOccluders.Alloc();
+				occluder.tri = tri;
+				idRenderMatrix::Transpose( vEntity->unjitteredMVP, occluder.mvp );
 			}
 #if 0
 			else
@@ -520,9 +576,226 @@ void R_RenderSingleModel( viewEntity_t* vEntity )
 		}
 	}
 }
+
+/*
+===================
+R_BinMaskedOcclusionTris
+
+Transforms, clips and sorts chunks of occluder triangles into the screen
+tiles of this job until the chunks run out or a tile could overflow.
+===================
+*/
+static void R_BinMaskedOcclusionTris( mocBinningJob_t* job )
+{
+	const unsigned int maxBinTris = MOC_BIN_TRIS - MOC_CHUNK_TRIS * MOC_MAX_CLIPPED_TRIS;
+
+	for( ;; )
+	{
+		// the remaining chunks are binned in the next round
+		int bin = 0;
+		while( bin < MOC_NUM_BINS && job->triLists[bin].mTriIdx <= maxBinTris )
+		{
+			bin++;
+		}
+		if( bin < MOC_NUM_BINS )
+		{
+			break;
+		}
+
+		const int chunkNum = job->nextChunk->Increment() - 1;
+		if( chunkNum >= job->numChunks )
+		{
+			break;
+		}
+
+		const mocChunk_t& chunk = job->chunks[chunkNum];
+		const mocOccluder_t& occluder = job->occluders[chunk.occluder];
+		const srfTriangles_t* tri = occluder.tri;
+
+		tr.maskedOcclusionCulling->BinTriangles( tri->mocVerts->ToFloatPtr(), tri->mocIndexes + chunk.firstTri * 3, chunk.numTris,
+				job->triLists, MOC_BINS_WIDE, MOC_BINS_HIGH, ( float* )&occluder.mvp[0][0],
+				MaskedOcclusionCulling::BACKFACE_CCW, MaskedOcclusionCulling::CLIP_PLANE_ALL, MaskedOcclusionCulling::VertexLayout( 16, 4, 8 ) );
+	}
+}
+
+REGISTER_PARALLEL_JOB( R_BinMaskedOcclusionTris, "R_BinMaskedOcclusionTris" );
+
+/*
+===================
+R_RasterizeMaskedOcclusionBin
+
+Every job writes to a different tile of the masked occlusion buffer.
+===================
+*/
+static void R_RasterizeMaskedOcclusionBin( mocRasterJob_t* job )
+{
+	for( int i = 0; i < MOC_BINNING_JOBS; i++ )
+	{
+		const MaskedOcclusionCulling::TriList& triList = job->binningJobs[i].triLists[job->bin];
+		if( triList.mTriIdx > 0 )
+		{
+			tr.maskedOcclusionCulling->RenderTrilist( triList, &job->rect );
+			job->numTris += triList.mTriIdx;
+		}
+	}
+}
+
+REGISTER_PARALLEL_JOB( R_RasterizeMaskedOcclusionBin, "R_RasterizeMaskedOcclusionBin" );
+
+/*
+===================
+R_RasterizeOccludersBinned
+
+Sort-middle rasterization of the occluder list on the job threads. Binning jobs
+take chunks of triangles and sort them into their own set of screen tiles, then
+one job per tile rasterizes the triangles all binning jobs put into it. The bins
+have a fixed size, so this is repeated until all chunks have been binned.
+===================
+*/
+static void R_RasterizeOccludersBinned()
+{
+	SCOPED_PROFILE_EVENT( "R_RasterizeOccludersBinned" );
+
+	if( mocBinStorage == NULL )
+	{
+		mocBinStorage = ( float* )Mem_Alloc16( MOC_BINNING_JOBS * MOC_NUM_BINS * MOC_BIN_TRIS * MOC_BINNED_TRI_FLOATS * sizeof( float ), TAG_RENDER );
+	}
+
+	// split the occluders into chunks so large surfaces are spread over the binning jobs
+	mocChunks.SetNum( 0 );
+	for( int i = 0; i < mocOccluders.Num(); i++ )
+	{
+		const int numTris = mocOccluders[i].tri->numIndexes / 3;
+		for( int firstTri = 0; firstTri < numTris; firstTri += MOC_CHUNK_TRIS )
+		{
+			mocChunk_t& chunk = mocChunks.Alloc();
+			chunk.occluder = i;
+			chunk.firstTri = firstTri;
+			chunk.numTris = Min( MOC_CHUNK_TRIS, numTris - firstTri );
+		}
+	}
+
+	idSysInterlockedInteger nextChunk;
+
+	mocBinningJob_t binningJobs[MOC_BINNING_JOBS];
+	for( int i = 0; i < MOC_BINNING_JOBS; i++ )
+	{
+		mocBinningJob_t& job = binningJobs[i];
+		job.occluders = mocOccluders.Ptr();
+		job.chunks = mocChunks.Ptr();
+		job.numChunks = mocChunks.Num();
+		job.nextChunk = &nextChunk;
+
+		for( int bin = 0; bin < MOC_NUM_BINS; bin++ )
+		{
+			job.triLists[bin].mNumTriangles = MOC_BIN_TRIS;
+			job.triLists[bin].mPtr = mocBinStorage + ( i * MOC_NUM_BINS + bin ) * MOC_BIN_TRIS * MOC_BINNED_TRI_FLOATS;
+		}
+	}
+
+	// the last row and column of tiles take the remaining pixels
+	unsigned int width, height, binWidth, binHeight;
+	tr.maskedOcclusionCulling->GetResolution( width, height );
+	tr.maskedOcclusionCulling->ComputeBinWidthHeight( MOC_BINS_WIDE, MOC_BINS_HIGH, binWidth, binHeight );
+
+	mocRasterJob_t rasterJobs[MOC_NUM_BINS];
+	for( int y = 0; y < MOC_BINS_HIGH; y++ )
+	{
+		for( int x = 0; x < MOC_BINS_WIDE; x++ )
+		{
+			mocRasterJob_t& job = rasterJobs[y * MOC_BINS_WIDE + x];
+			job.binningJobs = binningJobs;
+			job.bin = y * MOC_BINS_WIDE + x;
+			job.rect.mMinX = x * binWidth;
+			job.rect.mMaxX = ( x + 1 == MOC_BINS_WIDE ) ? width : ( x + 1 ) * binWidth;
+			job.rect.mMinY = y * binHeight;
+			job.rect.mMaxY = ( y + 1 == MOC_BINS_HIGH ) ? height : ( y + 1 ) * binHeight;
+			job.numTris = 0;
+		}
+	}
+
+	while( nextChunk.GetValue() < mocChunks.Num() )
+	{
+		for( int i = 0; i < MOC_BINNING_JOBS; i++ )
+		{
+			for( int bin = 0; bin < MOC_NUM_BINS; bin++ )
+			{
+				binningJobs[i].triLists[bin].mTriIdx = 0;
+			}
+			tr.frontEndJobList->AddJob( ( jobRun_t )R_BinMaskedOcclusionTris, &binningJobs[i] );
+		}
+		tr.frontEndJobList->Submit();
+		tr.frontEndJobList->Wait();
+
+		for( int bin = 0; bin < MOC_NUM_BINS; bin++ )
+		{
+			tr.frontEndJobList->AddJob( ( jobRun_t )R_RasterizeMaskedOcclusionBin, &rasterJobs[bin] );
+		}
+		tr.frontEndJobList->Submit();
+		tr.frontEndJobList->Wait();
+
+		tr.pc.c_mocBinningRounds++;
+	}
+
+	for( int bin = 0; bin < MOC_NUM_BINS; bin++ )
+	{
+		tr.pc.c_mocBinnedTris += rasterJobs[bin].numTris;
+	}
+}
+
+/*
+===================
+R_RasterizeOccluders
+===================
+*/
+static void R_RasterizeOccluders( int viewWidth, int viewHeight )
+{
+#if MOC_MULTITHREADED
+	for( int i = 0; i < mocOccluders.Num(); i++ )
+	{
+		const mocOccluder_t& occluder = mocOccluders[i];
+		const srfTriangles_t* tri = occluder.tri;
+
+		tr.maskedOcclusionThreaded->SetMatrix( ( float* )&occluder.mvp[0][0] );
+		tr.maskedOcclusionThreaded->RenderTriangles( tri->mocVerts->ToFloatPtr(), tri->mocIndexes, tri->numIndexes / 3, MaskedOcclusionCulling::BACKFACE_CCW, MaskedOcclusionCulling::CLIP_PLANE_ALL );
+	}
+
+	// wait for jobs to be finished
+	tr.maskedOcclusionThreaded->Flush();
+#else
+	// every tile must be at least 32x8 pixels
+	if( r_useParallelMaskedOcclusionCulling.GetBool() && viewWidth >= MOC_BINS_WIDE * 32 && viewHeight >= MOC_BINS_HIGH * 8 )
+	{
+		R_RasterizeOccludersBinned();
+		return;
+	}
+
+	for( int i = 0; i < mocOccluders.Num(); i++ )
+	{
+		const mocOccluder_t& occluder = mocOccluders[i];
+		const srfTriangles_t* tri = occluder.tri;
+
+		tr.maskedOcclusionCulling->RenderTriangles( tri->mocVerts->ToFloatPtr(), tri->mocIndexes, tri->numIndexes / 3, ( float* )&occluder.mvp[0][0], MaskedOcclusionCulling::BACKFACE_CCW, MaskedOcclusionCulling::CLIP_PLANE_ALL, MaskedOcclusionCulling::VertexLayout( 16, 4, 8 ) );
+	}
+#endif
+}
 #endif
 
-//REGISTER_PARALLEL_JOB( R_AddSingleModel, "R_AddSingleModel" );
+/*
+===================
+R_FreeMaskedOcclusionBins
+===================
+*/
+void R_FreeMaskedOcclusionBins()
+{
+#if defined(USE_INTRINSICS_SSE)
+	Mem_Free16( mocBinStorage );
+	mocBinStorage = NULL;
+
+	mocOccluders.Clear();
+	mocChunks.Clear();
+#endif
+}
 
 
 
@@ -578,41 +851,19 @@ void R_FillMaskedOcclusionBufferWithModels( viewDef_t* viewDef )
 #endif
 
 	//-------------------------------------------------
-	// Go through each view entity that is either visible to the view, or to
-	// any light that intersects the view (for shadows).
+	// Go through each view entity that is visible to the view and collect
+	// the surfaces that are big enough to be worth rasterizing.
+	// Dynamic models are instantiated here, so this stays serial.
 	//-------------------------------------------------
 
-	/*
-	if( r_useParallelAddModels.GetBool() )
-	{
-		for( viewEntity_t* vEntity = tr.viewDef->viewEntitys; vEntity != NULL; vEntity = vEntity->next )
-		{
-			tr.frontEndJobList->AddJob( ( jobRun_t )R_AddSingleModel, vEntity );
-		}
-		tr.frontEndJobList->Submit();
-		tr.frontEndJobList->Wait();
-	}
-	else
-	*/
-	{
-		for( viewEntity_t* vEntity = tr.viewDef->viewEntitys; vEntity != NULL; vEntity = vEntity->next )
-		{
-			const idRenderModel* model = vEntity->entityDef->parms.hModel;
+	mocOccluders.SetNum( 0 );
 
-			// skip after rendering BSP area models
-			if( !model->IsStaticWorldModel() )
-			{
-				//continue;
-			}
-
-			R_RenderSingleModel( vEntity );
-		}
+	for( viewEntity_t* vEntity = tr.viewDef->viewEntitys; vEntity != NULL; vEntity = vEntity->next )
+	{
+		R_AddModelOccluders( vEntity );
 	}
 
-#if MOC_MULTITHREADED
-	// wait for jobs to be finished
-	tr.maskedOcclusionThreaded->Flush();
-#endif
+	R_RasterizeOccluders( viewWidth, viewHeight );
 
 	int endTime = Sys_Microseconds();
 
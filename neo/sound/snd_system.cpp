@@ -577,6 +577,8 @@ void idSoundSystemLocal::Preload( idPreloadManifest& manifest )
 
 	idList< preloadSort_t > preloadSort;
 	preloadSort.Resize( manifest.NumResources() );
+	idStrList generatedFiles;
+	generatedFiles.SetNum( manifest.NumResources() );
 	for( int i = 0; i < manifest.NumResources(); i++ )
 	{
 		const preloadEntry_s& p = manifest.GetPreloadByIndex( i );
@@ -597,12 +599,22 @@ void idSoundSystemLocal::Preload( idPreloadManifest& manifest )
 				ps.idx = i;
 				ps.ofs = rc.offset;
 				preloadSort.Append( ps );
+				generatedFiles[i] = filename;
 			}
 		}
 	}
 
 	preloadSort.SortWithTemplate( idSort_Preload() );
 
+	// start reading the generated files in the background in resource file order
+	idStrList preloadFiles;
+	preloadFiles.Resize( preloadSort.Num() );
+	for( int i = 0; i < preloadSort.Num(); i++ )
+	{
+		preloadFiles.Append( generatedFiles[ preloadSort[ i ].idx ] );
+	}
+	fileSystem->StartPreload( preloadFiles );
+
 	for( int i = 0; i < preloadSort.Num(); i++ )
 	{
 		const preloadSort_t& ps = preloadSort[ i ];
@@ -617,6 +629,7 @@ void idSoundSystemLocal::Preload( idPreloadManifest& manifest )
 			sample->SetLevelLoadReferenced();
 		}
 	}
+	fileSystem->StopPreload();
 
 	int	end = Sys_Milliseconds();
 	common->Printf( "%05d sounds preloaded in %5.1f seconds\n", numLoaded, ( end - start ) * 0.001 );